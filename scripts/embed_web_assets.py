@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Gzip the web UI pages in web/ into src/web_assets.h.
+
+Runs automatically before every PlatformIO build (extra_scripts in
+platformio.ini) and can be run by hand after editing a page:
+
+    python3 scripts/embed_web_assets.py
+
+Output is deterministic (gzip mtime is zeroed), and the header is only
+rewritten when its contents change, so unchanged pages don't trigger a
+rebuild. Each asset gets a strong ETag derived from its compressed bytes.
+"""
+
+import gzip
+import hashlib
+import os
+
+ASSETS = [
+    # (source file, C symbol, content type)
+    ("index.html", "WEB_INDEX", "text/html"),
+    ("mirror.html", "WEB_MIRROR", "text/html"),
+]
+
+try:
+    Import("env")  # noqa: F821 - provided when run by PlatformIO
+    ROOT = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+WEB_DIR = os.path.join(ROOT, "web")
+OUTPUT = os.path.join(ROOT, "src", "web_assets.h")
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def build():
+    out = [
+        "// web_assets.h",
+        "// Generated by scripts/embed_web_assets.py from web/ - do not edit by hand",
+        "",
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "struct WebAsset {",
+        "  const uint8_t* data;     // Gzip-compressed, in flash",
+        "  size_t length;",
+        "  const char* etag;        // Quoted, ready for the ETag header",
+        "  const char* contentType;",
+        "};",
+        "",
+    ]
+    summary = []
+    for filename, symbol, content_type in ASSETS:
+        with open(os.path.join(WEB_DIR, filename), "rb") as f:
+            raw = f.read()
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha1(packed).hexdigest()[:16]
+        summary.append("%s %d -> %d bytes" % (filename, len(raw), len(packed)))
+        out += [
+            "// %s: %d bytes, %d gzipped" % (filename, len(raw), len(packed)),
+            "const uint8_t %s_DATA[] PROGMEM = {" % symbol,
+            c_array(packed),
+            "};",
+            "const WebAsset %s = {%s_DATA, sizeof(%s_DATA), \"\\\"%s\\\"\", \"%s\"};"
+            % (symbol, symbol, symbol, etag, content_type),
+            "",
+        ]
+    out += ["#endif // WEB_ASSETS_H", ""]
+    text = "\n".join(out)
+
+    try:
+        with open(OUTPUT) as f:
+            if f.read() == text:
+                return
+    except IOError:
+        pass
+    with open(OUTPUT, "w") as f:
+        f.write(text)
+    print("web assets: " + ", ".join(summary))
+
+
+build()
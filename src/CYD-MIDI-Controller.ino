@@ -35,6 +35,12 @@
 #include "euclidean_mode.h"
 #include "morph_mode.h"
 #include "web_server.h"
+#include "storage.h"
+#include "boot_timeline.h"
+#include "metrics.h"
+#include "thumbnail.h"
+#include "param_registry.h"
+#include "icon_atlas.h"
 #include "ui_elements.h"
 // #include "ui_manager.h"  // Will be used after mode migration to event-driven UI
 #include "midi_utils.h"
@@ -50,10 +56,11 @@
 #define SD_MISO 19
 #define SD_SCK 18
 
+#define SCREENSHOT_BLOCK_ROWS 8  // Rows read back per readRect during screenshot capture
+
 // SD card globals
 bool sdCardAvailable = false;
 uint64_t sdCardSize = 0;
-uint64_t sdCardUsed = 0;
 
 // Settings
 uint8_t midiChannel = 1;  // MIDI channel 1-16
@@ -70,10 +77,11 @@ int screenshotCount = 0;
 SPIClass mySpi = SPIClass(VSPI);  // Touch uses VSPI
 SPIClass sdSPI = SPIClass(HSPI);  // SD card uses HSPI
 XPT2046_Touchscreen ts(XPT2046_CS, XPT2046_IRQ);
-TFT_eSPI tft = TFT_eSPI();
+ShadowTFT tft = ShadowTFT();
 
 // BLE MIDI globals
 BLECharacteristic *pCharacteristic;
+volatile bool bleReady = false;  // Set by bleSetupTask once advertising
 uint8_t midiPacket[] = {0x80, 0x80, 0x00, 0x60, 0x7F};
 
 // MIDI Clock sync
@@ -85,6 +93,10 @@ TouchState touch;
 // App state
 AppMode currentMode = MENU;
 
+// Set by BLE callbacks (which run on the BLE task and must not draw);
+// the loop redraws the menu on its next pass
+volatile bool menuRedrawPending = false;
+
 // Board-specific rotation helpers (align display + touch)
 uint8_t getDisplayRotation() {
 #if defined(SCREEN_WIDTH) && defined(SCREEN_HEIGHT)
@@ -107,6 +119,9 @@ uint8_t getTouchRotation() {
 
 // Forward declarations
 void drawMenu();
+void renderAppIconToAtlas(TFT_eSPI& gfx, int index, int size);
+void drawAppIcon(TFT_eSPI& gfx, int index, int x, int y, int iconSize);
+void drawAppGraphics(TFT_eSPI& gfx, AppMode mode, int x, int y, int iconSize);
 void showSettingsMenu(bool interactive = true);
 
 // Scalable App Icon System
@@ -152,17 +167,13 @@ class MIDICallbacks: public BLEServerCallbacks {
     void onConnect(BLEServer* pServer) {
       globalState.bleConnected = true;
       Serial.println("BLE connected");
-      if (currentMode == MENU) {
-        drawMenu(); // Redraw menu to clear "BLE WAITING..."
-      }
+      menuRedrawPending = true; // Redraw menu to clear "BLE WAITING..."
     }
     void onDisconnect(BLEServer* pServer) {
       globalState.bleConnected = false;
       Serial.println("BLE disconnected - sending All Notes Off");
       
-      if (currentMode == MENU) {
-        drawMenu(); // Redraw menu to show "BLE WAITING..."
-      }
+      menuRedrawPending = true; // Redraw menu to show "BLE WAITING..."
       
       // Stop all notes using threaded MIDI (more reliable than loop)
       stopAllModes();
@@ -175,6 +186,15 @@ class MIDICallbacks: public BLEServerCallbacks {
 };
 
 class MIDICharacteristicCallbacks: public BLECharacteristicCallbacks {
+    // Outcome of each notify() on this characteristic
+    void onStatus(BLECharacteristic *pCharacteristic, Status s, uint32_t code) {
+      if (s == SUCCESS_NOTIFY) {
+        Metrics::bleNotified(true);
+      } else if (s != SUCCESS_INDICATE) {
+        Metrics::bleNotified(false);
+      }
+    }
+    
     void onWrite(BLECharacteristic *pCharacteristic) {
       std::string value = pCharacteristic->getValue();
       
@@ -237,38 +257,31 @@ void initSDCard() {
   // SD card uses HSPI with its own pins (separate from touch VSPI and display)
   sdSPI.begin(SD_SCK, SD_MISO, SD_MOSI, SD_CS);
   
-  if (!SD.begin(SD_CS, sdSPI, 1000000)) {
-    Serial.println("SD.begin() failed");
+  // Mounted once here and kept mounted; see storage.h
+  if (!Storage::begin()) {
     sdCardAvailable = false;
     return;
   }
   
-  uint8_t cardType = SD.cardType();
-  if (cardType == CARD_NONE) {
-    Serial.println("No SD card detected");
-    SD.end();
-    sdCardAvailable = false;
-    return;
+  {
+    StorageSession session;
+    uint8_t cardType = SD.cardType();
+    
+    Serial.print("Card Type: ");
+    if (cardType == CARD_MMC) Serial.println("MMC");
+    else if (cardType == CARD_SD) Serial.println("SDSC");
+    else if (cardType == CARD_SDHC) Serial.println("SDHC");
+    else Serial.println("UNKNOWN");
+    
+    // SD.usedBytes() walks the whole FAT (seconds on a big card), so it is
+    // left to showSDCardInfo(), which computes it when the screen is opened
+    sdCardSize = SD.cardSize() / (1024 * 1024);
   }
   
-  Serial.print("Card Type: ");
-  if (cardType == CARD_MMC) Serial.println("MMC");
-  else if (cardType == CARD_SD) Serial.println("SDSC");
-  else if (cardType == CARD_SDHC) Serial.println("SDHC");
-  else Serial.println("UNKNOWN");
-  
-  sdCardSize = SD.cardSize() / (1024 * 1024);
-  sdCardUsed = SD.usedBytes() / (1024 * 1024);
-  
-  Serial.printf("Size: %lluMB, Used: %lluMB\n", sdCardSize, sdCardUsed);
+  Serial.printf("Size: %lluMB\n", sdCardSize);
   Serial.println("SD Card ready!\n");
   
   sdCardAvailable = true;
-  SD.end(); // Release SPI bus for display
-  
-  // Initialize web server for file management
-  Serial.println("\n=== WiFi Web Server Initialization ===");
-  initializeWebServer();
 }
 
 void showSDCardInfo() {
@@ -279,17 +292,26 @@ void showSDCardInfo() {
   int y = 70;
   int lineHeight = 25;
   
-  if (!sdCardAvailable) {
+  // Borrow the card just long enough to read the stats
+  uint64_t totalBytes = 0;
+  uint64_t usedBytes = 0;
+  bool haveStats = false;
+  {
+    StorageSession session;
+    if (session) {
+      totalBytes = SD.totalBytes() / (1024 * 1024);
+      usedBytes = SD.usedBytes() / (1024 * 1024);
+      haveStats = true;
+    }
+  }
+  
+  if (!haveStats) {
     tft.setTextColor(THEME_ERROR, THEME_BG);
     tft.drawCentreString("NO SD CARD DETECTED", SCREEN_WIDTH/2, y, 2);
     tft.setTextColor(THEME_TEXT_DIM, THEME_BG);
     y += lineHeight * 2;
     tft.drawCentreString("Check card is inserted", SCREEN_WIDTH/2, y, 2);
   } else {
-    // Remount to get fresh stats
-    SD.begin(SD_CS);
-    uint64_t totalBytes = SD.totalBytes() / (1024 * 1024);
-    uint64_t usedBytes = SD.usedBytes() / (1024 * 1024);
     uint64_t freeBytes = totalBytes - usedBytes;
     
     tft.setTextColor(THEME_TEXT, THEME_BG);
@@ -337,8 +359,6 @@ void showSDCardInfo() {
     y += barHeight + 10;
     tft.setTextColor(THEME_TEXT_DIM, THEME_BG);
     tft.drawCentreString(String((int)(usagePercent * 100)) + "% used", SCREEN_WIDTH/2, y, 2);
-    
-    SD.end(); // Release SPI
   }
   
   // Back button
@@ -357,103 +377,176 @@ void showSDCardInfo() {
   }
 }
 
+static void writeLE32(uint8_t* dst, uint32_t value) {
+  dst[0] = value & 0xFF;
+  dst[1] = (value >> 8) & 0xFF;
+  dst[2] = (value >> 16) & 0xFF;
+  dst[3] = (value >> 24) & 0xFF;
+}
+
+// Screenshot file writes finish on the storage worker; this reports them
+struct ScreenshotJob {
+  String filepath;
+  uint32_t fileSize;
+  unsigned long startTime;
+};
+
+static void onScreenshotSaved(const StorageResult& result, void* context) {
+  ScreenshotJob* job = (ScreenshotJob*)context;
+  if (result.ok) {
+    Serial.printf("Screenshot saved: %s (%u bytes, %lu ms total)\n", job->filepath.c_str(),
+                  (unsigned)job->fileSize, millis() - job->startTime);
+  } else {
+    Serial.println("Screenshot write failed: " + job->filepath);
+  }
+  delete job;
+}
+
+// Collects thumbnail output into pooled worker buffers for a second file handle
+struct ThumbnailSink {
+  int handle;
+  uint8_t* buffer;
+  size_t used;
+};
+
+static void writeThumbnailChunk(const uint8_t* data, size_t length, void* context) {
+  ThumbnailSink* sink = (ThumbnailSink*)context;
+  while (length > 0) {
+    if (!sink->buffer) {
+      sink->buffer = StorageWorker::acquireBuffer();
+      sink->used = 0;
+    }
+    size_t n = min(length, STORAGE_BUFFER_SIZE - sink->used);
+    memcpy(sink->buffer + sink->used, data, n);
+    sink->used += n;
+    data += n;
+    length -= n;
+    if (sink->used == STORAGE_BUFFER_SIZE) {
+      StorageWorker::write(sink->handle, sink->buffer, sink->used);
+      sink->buffer = nullptr;
+    }
+  }
+}
+
 void saveScreenshot(String filename) {
-  if (!sdCardAvailable) {
+  if (!sdCardAvailable || !StorageWorker::isRunning()) {
     Serial.println("Cannot save screenshot: SD card not available");
     return;
   }
   
-  // Ensure SD card is unmounted first to avoid VFS registration errors
-  SD.end();
-  delay(100);
-  
-  // Mount SD card
-  if (!SD.begin(SD_CS, sdSPI)) {
-    Serial.println("SD card mount failed for screenshot");
-    return;
-  }
-  
   // Create screenshots directory if it doesn't exist
-  if (!SD.exists("/screenshots")) {
-    SD.mkdir("/screenshots");
+  {
+    StorageSession session;
+    if (!session) {
+      Serial.println("SD card not available for screenshot");
+      return;
+    }
+    if (!SD.exists("/screenshots")) {
+      SD.mkdir("/screenshots");
+    }
   }
   
   String filepath = "/screenshots/" + filename + ".bmp";
-  File file = SD.open(filepath, FILE_WRITE);
-  if (!file) {
-    Serial.println("Failed to create screenshot file: " + filepath);
-    SD.end();
+  unsigned long captureStart = millis();
+  RenderThread::flush(); // Make sure queued tiles are on the panel before reading it back
+  
+  // BMP rows are padded to a multiple of 4 bytes
+  uint32_t rowBytes = (SCREEN_WIDTH * 3 + 3) & ~3;
+  uint32_t imageSize = rowBytes * SCREEN_HEIGHT;
+  uint32_t fileSize = imageSize + 54; // 54 bytes header
+  
+  // Read back a block of rows per SPI transaction; a block (plus the header
+  // for the first one) has to fit in one storage transfer buffer
+  int blockRows = min(SCREENSHOT_BLOCK_ROWS, (int)((STORAGE_BUFFER_SIZE - 54) / rowBytes));
+  uint16_t* pixelBuf = nullptr;
+  while (blockRows > 0) {
+    pixelBuf = (uint16_t*)malloc(SCREEN_WIDTH * blockRows * sizeof(uint16_t));
+    if (pixelBuf) break;
+    blockRows /= 2;
+  }
+  if (!pixelBuf) {
+    Serial.println("Not enough memory for screenshot buffers");
     return;
   }
   
+  int handle = StorageWorker::openWrite(filepath);
+  if (handle < 0) {
+    Serial.println("Failed to create screenshot file: " + filepath);
+    free(pixelBuf);
+    return;
+  }
   Serial.println("Saving screenshot: " + filepath);
   
-  // BMP file format header for 24-bit RGB
-  uint32_t imageSize = SCREEN_WIDTH * SCREEN_HEIGHT * 3;
-  uint32_t fileSize = imageSize + 54; // 54 bytes header
-  
-  // BMP Header (14 bytes)
-  file.write('B'); file.write('M');  // Signature
-  file.write((uint8_t)(fileSize & 0xFF));
-  file.write((uint8_t)((fileSize >> 8) & 0xFF));
-  file.write((uint8_t)((fileSize >> 16) & 0xFF));
-  file.write((uint8_t)((fileSize >> 24) & 0xFF));
-  file.write(0); file.write(0);  // Reserved
-  file.write(0); file.write(0);  // Reserved
-  file.write(54); file.write(0); file.write(0); file.write(0);  // Pixel data offset
-  
-  // DIB Header (40 bytes)
-  file.write(40); file.write(0); file.write(0); file.write(0);  // Header size
-  file.write((uint8_t)(SCREEN_WIDTH & 0xFF));
-  file.write((uint8_t)((SCREEN_WIDTH >> 8) & 0xFF));
-  file.write((uint8_t)((SCREEN_WIDTH >> 16) & 0xFF));
-  file.write((uint8_t)((SCREEN_WIDTH >> 24) & 0xFF));
-  file.write((uint8_t)(SCREEN_HEIGHT & 0xFF));
-  file.write((uint8_t)((SCREEN_HEIGHT >> 8) & 0xFF));
-  file.write((uint8_t)((SCREEN_HEIGHT >> 16) & 0xFF));
-  file.write((uint8_t)((SCREEN_HEIGHT >> 24) & 0xFF));
-  file.write(1); file.write(0);  // Color planes
-  file.write(24); file.write(0);  // Bits per pixel (24-bit RGB)
-  file.write(0); file.write(0); file.write(0); file.write(0);  // Compression (none)
-  file.write((uint8_t)(imageSize & 0xFF));
-  file.write((uint8_t)((imageSize >> 8) & 0xFF));
-  file.write((uint8_t)((imageSize >> 16) & 0xFF));
-  file.write((uint8_t)((imageSize >> 24) & 0xFF));
-  file.write(0); file.write(0); file.write(0); file.write(0);  // X pixels per meter
-  file.write(0); file.write(0); file.write(0); file.write(0);  // Y pixels per meter
-  file.write(0); file.write(0); file.write(0); file.write(0);  // Colors in palette
-  file.write(0); file.write(0); file.write(0); file.write(0);  // Important colors
-  
-  // Write pixel data (bottom to top, BGR format)
-  uint16_t pixelData;
-  uint8_t r, g, b;
-  
-  for (int y = SCREEN_HEIGHT - 1; y >= 0; y--) {
-    for (int x = 0; x < SCREEN_WIDTH; x++) {
-      pixelData = tft.readPixel(x, y);
-      // Convert RGB565 to RGB888
-      r = ((pixelData >> 11) & 0x1F) << 3;  // 5 bits red
-      g = ((pixelData >> 5) & 0x3F) << 2;   // 6 bits green
-      b = (pixelData & 0x1F) << 3;          // 5 bits blue
-      // BMP uses BGR order
-      file.write(b);
-      file.write(g);
-      file.write(r);
+  // The gallery thumbnail is built from the same rows as they are converted
+  ThumbnailSink thumbSink = {StorageWorker::openWrite(ThumbnailBuilder::pathFor(filepath)), nullptr, 0};
+  ThumbnailBuilder thumbnail(writeThumbnailChunk, &thumbSink);
+  bool thumbnailOk = thumbSink.handle >= 0 && thumbnail.begin(SCREEN_WIDTH, SCREEN_HEIGHT);
+  
+  // Pixel data is stored bottom to top in BGR order, so walk the blocks upwards.
+  // Each converted block goes to the storage worker while the next one is read.
+  bool firstBlock = true;
+  for (int blockBottom = SCREEN_HEIGHT - 1; blockBottom >= 0; blockBottom -= blockRows) {
+    int rows = min(blockRows, blockBottom + 1);
+    int blockTop = blockBottom - rows + 1;
+    tft.readRect(0, blockTop, SCREEN_WIDTH, rows, pixelBuf);
+    
+    uint8_t* buffer = StorageWorker::acquireBuffer();
+    uint8_t* out = buffer;
+    if (firstBlock) {
+      // BMP header (14 bytes) + DIB header (40 bytes)
+      memset(out, 0, 54);
+      out[0] = 'B'; out[1] = 'M';
+      writeLE32(out + 2, fileSize);
+      writeLE32(out + 10, 54);            // Pixel data offset
+      writeLE32(out + 14, 40);            // DIB header size
+      writeLE32(out + 18, SCREEN_WIDTH);
+      writeLE32(out + 22, SCREEN_HEIGHT); // Positive height = bottom-up rows
+      out[26] = 1;                        // Color planes
+      out[28] = 24;                       // Bits per pixel (24-bit RGB)
+      writeLE32(out + 34, imageSize);
+      out += 54;
+      firstBlock = false;
+    }
+    
+    for (int r = rows - 1; r >= 0; r--) {
+      const uint16_t* src = pixelBuf + r * SCREEN_WIDTH;
+      uint8_t* dst = out;
+      for (int x = 0; x < SCREEN_WIDTH; x++) {
+        // readRect returns byte-swapped RGB565 (pushImage order)
+        uint16_t pixelData = (src[x] >> 8) | (src[x] << 8);
+        *dst++ = (pixelData & 0x1F) << 3;          // Blue
+        *dst++ = ((pixelData >> 5) & 0x3F) << 2;   // Green
+        *dst++ = ((pixelData >> 11) & 0x1F) << 3;  // Red
+      }
+      memset(dst, 0, out + rowBytes - dst);        // Row padding
+      if (thumbnailOk) thumbnail.addRow(out);
+      out += rowBytes;
     }
+    StorageWorker::write(handle, buffer, out - buffer);
+  }
+  free(pixelBuf);
+  
+  if (thumbSink.handle >= 0) {
+    if (thumbnailOk) thumbnail.end();
+    if (thumbSink.buffer) StorageWorker::write(thumbSink.handle, thumbSink.buffer, thumbSink.used);
+    StorageWorker::close(thumbSink.handle);
+    // A half-written thumbnail would be served as-is; /thumb regenerates missing ones
+    if (!thumbnailOk) StorageWorker::remove(ThumbnailBuilder::pathFor(filepath));
   }
   
-  file.close();
-  SD.end();
+  ScreenshotJob* job = new ScreenshotJob{filepath, fileSize, captureStart};
+  StorageWorker::close(handle, onScreenshotSaved, job);
   
   // Brief visual feedback
   tft.fillCircle(460, 300, 10, THEME_SUCCESS);
   delay(100);
   
-  Serial.println("Screenshot saved: " + filepath + " (" + String(fileSize) + " bytes)");
+  Serial.println("Screenshot captured: " + filepath + " (" + String(millis() - captureStart) + " ms)");
 }
 
 void cycleModesForScreenshots() {
   // Cycle through all modes for visual inspection and screenshot capture
+  tft.resetStats();
   tft.fillScreen(THEME_BG);
   tft.setTextColor(THEME_PRIMARY, THEME_BG);
   tft.drawCentreString("CYCLING MODES", SCREEN_WIDTH/2, 20, 4);
@@ -499,7 +592,7 @@ void cycleModesForScreenshots() {
   tft.drawCentreString(globalState.bleConnected ? "Connected" : "Waiting for connection", SCREEN_WIDTH/2, 120, 2);
   tft.setTextColor(THEME_TEXT_DIM, THEME_BG);
   tft.drawCentreString("Device: CYD MIDI", SCREEN_WIDTH/2, 160, 2);
-  String mac = BLEDevice::getAddress().toString().c_str();
+  String mac = bleReady ? BLEDevice::getAddress().toString().c_str() : "starting...";
   tft.drawCentreString("MAC: " + mac, SCREEN_WIDTH/2, 190, 2);
   int backBtnX2 = (SCREEN_WIDTH - 100) / 2;
   drawRoundButton(backBtnX2, SCREEN_HEIGHT - 80, 100, 35, "BACK", THEME_PRIMARY);
@@ -564,7 +657,11 @@ void cycleModesForScreenshots() {
   }
   
   // Done
+  StorageWorker::waitIdle();
   Serial.println("[Screenshot] Complete! 18 total screenshots saved.");
+  tft.printStats();
+  ButtonCache::printStats();
+  StorageWorker::printStats();
   tft.fillScreen(THEME_SUCCESS);
   tft.setTextColor(THEME_BG, THEME_SUCCESS);
   tft.drawCentreString("SCREENSHOTS SAVED", SCREEN_WIDTH/2, 120, 4);
@@ -600,10 +697,14 @@ void showSettingsMenu(bool interactive) {
   drawRoundButton(btnX + SCALED_W(300), btnY, channelBtnW, btnH, "CH +", THEME_WARNING);
   btnY += btnH + spacing;
   
-  // BLE Enable/Disable
+  // BLE and WiFi Enable/Disable
+  int radioBtnW = SCALED_W(215);
   String bleText = bleEnabled ? "BLE: ON" : "BLE: OFF";
   uint16_t bleColor = bleEnabled ? THEME_SUCCESS : THEME_ERROR;
-  drawRoundButton(btnX, btnY, btnW, btnH, bleText, bleColor);
+  drawRoundButton(btnX, btnY, radioBtnW, btnH, bleText, bleColor);
+  bool wifiOn = webServerRequested();
+  drawRoundButton(btnX + SCALED_W(225), btnY, radioBtnW, btnH, wifiOn ? "WIFI: ON" : "WIFI: OFF",
+                  wifiOn ? THEME_SUCCESS : THEME_ERROR);
   btnY += btnH + spacing;
   
   // Screenshot Mode Cycling
@@ -657,9 +758,11 @@ void showSettingsMenu(bool interactive) {
     
     // BLE Toggle
     currentY += btnH + spacing;
-    if (isButtonPressed(btnX, currentY, btnW, btnH)) {
+    if (isButtonPressed(btnX, currentY, SCALED_W(215), btnH)) {
       bleEnabled = !bleEnabled;
-      if (bleEnabled) {
+      if (!bleReady) {
+        // Still starting up; bleSetupTask only advertises if bleEnabled is set
+      } else if (bleEnabled) {
         BLEDevice::startAdvertising();
         Serial.println("BLE advertising enabled");
       } else {
@@ -670,6 +773,17 @@ void showSettingsMenu(bool interactive) {
       return;
     }
     
+    // WiFi Toggle
+    if (isButtonPressed(btnX + SCALED_W(225), currentY, SCALED_W(215), btnH)) {
+      if (webServerRequested()) {
+        stopWebServer();
+      } else {
+        initializeWebServer();
+      }
+      showSettingsMenu();
+      return;
+    }
+    
     // Screenshot Mode Cycling
     currentY += btnH + spacing;
     if (isButtonPressed(btnX, currentY, btnW, btnH)) {
@@ -695,11 +809,9 @@ void resetCalibration() {
     return;
   }
   
-  SD.end();
-  delay(100);
-  
-  if (!SD.begin(SD_CS, sdSPI)) {
-    Serial.println("SD card mount failed for calibration reset");
+  StorageSession session;
+  if (!session) {
+    Serial.println("SD card not available for calibration reset");
     return;
   }
   
@@ -708,7 +820,6 @@ void resetCalibration() {
     Serial.println("Calibration file deleted from SD card");
   }
   
-  SD.end();
   Serial.println("Calibration reset! Rebooting to recalibrate...");
 }
 
@@ -719,18 +830,15 @@ void saveCalibration() {
     return;
   }
   
-  SD.end();
-  delay(100);
-  
-  if (!SD.begin(SD_CS, sdSPI)) {
-    Serial.println("SD card mount failed for calibration save");
+  StorageSession session;
+  if (!session) {
+    Serial.println("SD card not available for calibration save");
     return;
   }
   
   File file = SD.open(CALIBRATION_FILE, FILE_WRITE);
   if (!file) {
     Serial.println("Failed to create calibration file");
-    SD.end();
     return;
   }
   
@@ -744,7 +852,6 @@ void saveCalibration() {
   file.close();
   
   Serial.println("Calibration saved to SD card");
-  SD.end();
 }
 
 // Load calibration from SD card
@@ -755,18 +862,15 @@ bool loadCalibration() {
     return false;
   }
   
-  SD.end();
-  delay(100);
-  
-  if (!SD.begin(SD_CS, sdSPI)) {
-    Serial.println("SD card mount failed for calibration load");
+  StorageSession session;
+  if (!session) {
+    Serial.println("SD card not available for calibration load");
     calibration.valid = false;
     return false;
   }
   
   if (!SD.exists(CALIBRATION_FILE)) {
     Serial.println("Calibration file does not exist");
-    SD.end();
     calibration.valid = false;
     return false;
   }
@@ -774,7 +878,6 @@ bool loadCalibration() {
   File file = SD.open(CALIBRATION_FILE, FILE_READ);
   if (!file) {
     Serial.println("Failed to open calibration file");
-    SD.end();
     calibration.valid = false;
     return false;
   }
@@ -783,7 +886,6 @@ bool loadCalibration() {
   if (calibration.magic != CALIBRATION_MAGIC) {
     Serial.println("Invalid calibration magic number");
     file.close();
-    SD.end();
     calibration.valid = false;
     return false;
   }
@@ -797,7 +899,6 @@ bool loadCalibration() {
   calibration.rotation = (rot <= 3) ? rot : 0;
   
   file.close();
-  SD.end();
   
   calibration.valid = true;
   Serial.println("Loaded calibration from SD card");
@@ -809,10 +910,55 @@ bool loadCalibration() {
   return true;
 }
 
+// Bringing up the Bluetooth stack takes the better part of a second, so it
+// runs on core 0 while setup() carries on with the display and SD card.
+// Everything that sends MIDI waits for globalState.bleConnected, which
+// can only be set once this has finished.
+static void bleSetupTask(void* parameter) {
+  BLEDevice::init("CYD MIDI");
+  Serial.println("BLE Device initialized");
+  BootTimeline::mark("ble stack");
+  
+  BLEServer *server = BLEDevice::createServer();
+  server->setCallbacks(new MIDICallbacks());
+  Serial.println("BLE Server created");
+  
+  BLEService *service = server->createService(BLEUUID(SERVICE_UUID));
+  Serial.println("BLE Service created");
+  
+  pCharacteristic = service->createCharacteristic(
+    BLEUUID(CHARACTERISTIC_UUID),
+    BLECharacteristic::PROPERTY_READ | 
+    BLECharacteristic::PROPERTY_WRITE | 
+    BLECharacteristic::PROPERTY_NOTIFY | 
+    BLECharacteristic::PROPERTY_WRITE_NR
+  );
+  
+  pCharacteristic->setCallbacks(new MIDICharacteristicCallbacks());
+  pCharacteristic->addDescriptor(new BLE2902());
+  service->start();
+  Serial.println("BLE Service started - MIDI Clock sync enabled");
+  
+  BLEAdvertising *advertising = BLEDevice::getAdvertising();
+  advertising->addServiceUUID(BLEUUID(SERVICE_UUID));
+  advertising->setScanResponse(true);
+  advertising->setMinPreferred(0x06);  // Functions that help with iPhone connections issue
+  advertising->setMinPreferred(0x12);
+  if (bleEnabled) {
+    BLEDevice::startAdvertising();
+    Serial.println("BLE Advertising started - Device discoverable as 'CYD MIDI'");
+  }
+  Serial.printf("BLE MAC Address: %s\n", BLEDevice::getAddress().toString().c_str());
+  bleReady = true;
+  BootTimeline::mark("ble advertising");
+  
+  vTaskDelete(nullptr);
+}
+
 void setup() {
   Serial.begin(115200);
-  delay(100);
   Serial.println("\n\nCYD MIDI Controller Starting...");
+  BootTimeline::mark("serial");
   
   // Initialize global state
   globalState.bpm = 120.0;
@@ -823,10 +969,16 @@ void setup() {
   mySpi.begin(XPT2046_CLK, XPT2046_MISO, XPT2046_MOSI, XPT2046_CS);
   ts.begin();
   ts.setRotation(getTouchRotation());
+  BootTimeline::mark("touch");
+  
+  // BLE MIDI setup runs in parallel from here on
+  Serial.println("Initializing BLE MIDI...");
+  xTaskCreatePinnedToCore(bleSetupTask, "BLESetupTask", 8192, nullptr, 1, nullptr, 0);
   
   // Display setup
   tft.init();
   tft.setRotation(getDisplayRotation());
+  tft.beginShadow();
   pinMode(27, OUTPUT);
   digitalWrite(27, HIGH);
   
@@ -838,75 +990,67 @@ void setup() {
   tft.drawCentreString("Enhanced Edition", SCREEN_WIDTH/2, SCREEN_HEIGHT/2 + 10, 2);
   tft.setTextColor(THEME_TEXT_DIM, THEME_BG);
   tft.drawCentreString("Initializing...", SCREEN_WIDTH/2, SCREEN_HEIGHT/2 + 40, 2);
+  BootTimeline::mark("display + splash");
   
   // Initialize SD card first (needed for calibration file loading)
   initSDCard();
+  StorageWorker::begin();
+  BootTimeline::mark("sd card");
   
   // Initialize touch calibration (will auto-calibrate if needed, after SD is ready)
   initTouchCalibration();
+  BootTimeline::mark("touch calibration");
   
   // Re-initialize touch SPI after SD card to ensure it still works
   mySpi.begin(XPT2046_CLK, XPT2046_MISO, XPT2046_MOSI, XPT2046_CS);
   ts.begin();
   Serial.println("Touch re-initialized after SD card");
   
-  // BLE MIDI Setup
-  Serial.println("Initializing BLE MIDI...");
-  BLEDevice::init("CYD MIDI");
-  Serial.println("BLE Device initialized");
-  
   // Initialize thread managers
   Serial.println("Starting Touch Thread...");
   TouchThread::begin();
   Serial.println("Starting MIDI Thread...");
   MIDIThread::begin();
+  StepClock::begin();
+  Serial.println("Starting Render Thread...");
+  RenderThread::begin();
   Serial.println("Thread managers initialized");
+  BootTimeline::mark("threads");
   
-  BLEServer *server = BLEDevice::createServer();
-  server->setCallbacks(new MIDICallbacks());
-  Serial.println("BLE Server created");
-  
-  BLEService *service = server->createService(BLEUUID(SERVICE_UUID));
-  Serial.println("BLE Service created");
-  
-  pCharacteristic = service->createCharacteristic(
-    BLEUUID(CHARACTERISTIC_UUID),
-    BLECharacteristic::PROPERTY_READ | 
-    BLECharacteristic::PROPERTY_WRITE | 
-    BLECharacteristic::PROPERTY_NOTIFY | 
-    BLECharacteristic::PROPERTY_WRITE_NR
-  );
-  
-  pCharacteristic->setCallbacks(new MIDICharacteristicCallbacks());
-  pCharacteristic->addDescriptor(new BLE2902());
-  service->start();
-  Serial.println("BLE Service started - MIDI Clock sync enabled");
-  
-  BLEAdvertising *advertising = BLEDevice::getAdvertising();
-  advertising->addServiceUUID(BLEUUID(SERVICE_UUID));
-  advertising->setScanResponse(true);
-  advertising->setMinPreferred(0x06);  // Functions that help with iPhone connections issue
-  advertising->setMinPreferred(0x12);
-  BLEDevice::startAdvertising();
-  Serial.println("BLE Advertising started - Device discoverable as 'CYD MIDI'");
-  Serial.printf("BLE MAC Address: %s\n", BLEDevice::getAddress().toString().c_str());
+  // Parameters the modes expose for remote control (param_control.h)
+  publishGridsParams();
+  publishTB3POParams();
+  publishLFOParams();
+  publishEuclideanParams();
   
   // NOTE: UIManager not initialized yet - will be used after mode migration
   // Modes will initialize when selected from menu (not at startup)
   // This improves startup time and avoids unnecessary resource usage
   
   drawMenu();
+  BootTimeline::mark("menu drawn");
+  
+  // WiFi comes last: it connects in the background on the web task and
+  // nothing on screen depends on it
+  Serial.println("\n=== WiFi Web Server Initialization ===");
+  initializeWebServer();
+  BootTimeline::mark("wifi started");
+  
   Serial.println("MIDI Controller ready!");
   Serial.println("Touch settings cog in top-left to access configuration");
+  BootTimeline::print();
 }
 
 void loop() {
+  uint32_t loopStart = micros();
+  
+  // The loop owns the display (and shared SPI bus) while it runs;
+  // the render task pushes queued tiles during the idle delay below
+  RenderThread::lockDisplay();
+  
   // Update touch state (using existing calibration logic)
   updateTouch();
   
-  // Handle web server requests
-  handleWebServer();
-  
   // Sync global state with MIDI clock (bidirectional sync)
   if (midiClock.isReceiving) {
     // External MIDI clock is master
@@ -927,8 +1071,15 @@ void loop() {
     Serial.println("MIDI Clock timeout");
   }
   
+  // Apply remote parameter changes (the current mode's tick-synced ones wait for its step)
+  ParamRegistry::service();
+  
   switch (currentMode) {
     case MENU:
+      if (menuRedrawPending) {
+        menuRedrawPending = false;
+        drawMenu();
+      }
       // Handle taps (including cog icon for settings)
       if (touch.justPressed) {
         handleMenuTouch();
@@ -981,6 +1132,8 @@ void loop() {
       break;
   }
   
+  RenderThread::unlockDisplay();
+  Metrics::recordLoop(micros() - loopStart);
   delay(20);
 }
 
@@ -1002,6 +1155,9 @@ void drawMenu() {
   int startX = (SCREEN_WIDTH - (cols * iconSize + (cols-1) * spacing)) / 2;
   int startY = SCALED_H(58);     // Start slightly higher to fit 3 rows
   
+  // Icons are rendered once into the atlas and blitted from then on
+  IconAtlas::build(numApps, iconSize, renderAppIconToAtlas);
+  
   // Draw all apps (now includes TB3PO as 11th app)
   for (int i = 0; i < numApps; i++) {
     int col = i % cols;
@@ -1009,26 +1165,39 @@ void drawMenu() {
     int x = startX + col * (iconSize + spacing);
     int y = startY + row * (iconSize + rowSpacing);
     
-    // App icon background
-    uint16_t iconColor = apps[i].color;
-    
-    tft.fillRoundRect(x, y, iconSize, iconSize, 8, iconColor);
-    tft.drawRoundRect(x, y, iconSize, iconSize, 8, THEME_TEXT);
-    
-    // Draw app-specific graphics in TOP half of button
-    drawAppGraphics(apps[i].mode, x, y, iconSize);
-    
-    // Icon symbol in TOP half
-    tft.setTextColor(TFT_BLACK, iconColor);
-    tft.drawCentreString(apps[i].symbol, x + iconSize/2, y + iconSize/4, 2);
-    
-    // App name in BOTTOM half
-    tft.setTextColor(TFT_BLACK, iconColor);
-    tft.drawCentreString(apps[i].name, x + iconSize/2, y + (3 * iconSize/4) - 4, 2);
+    if (IconAtlas::isBuilt(numApps, iconSize)) {
+      IconAtlas::draw(i, x, y);
+    } else {
+      drawAppIcon(tft, i, x, y, iconSize);
+    }
   }
 }
 
-void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
+// Atlas renderer - draws an icon at the origin of the atlas scratch sprite
+void renderAppIconToAtlas(TFT_eSPI& gfx, int index, int size) {
+  drawAppIcon(gfx, index, 0, 0, size);
+}
+
+void drawAppIcon(TFT_eSPI& gfx, int index, int x, int y, int iconSize) {
+  // App icon background
+  uint16_t iconColor = apps[index].color;
+  
+  gfx.fillRoundRect(x, y, iconSize, iconSize, 8, iconColor);
+  gfx.drawRoundRect(x, y, iconSize, iconSize, 8, THEME_TEXT);
+  
+  // Draw app-specific graphics in TOP half of button
+  drawAppGraphics(gfx, apps[index].mode, x, y, iconSize);
+  
+  // Icon symbol in TOP half
+  gfx.setTextColor(TFT_BLACK, iconColor);
+  gfx.drawCentreString(apps[index].symbol, x + iconSize/2, y + iconSize/4, 2);
+  
+  // App name in BOTTOM half
+  gfx.setTextColor(TFT_BLACK, iconColor);
+  gfx.drawCentreString(apps[index].name, x + iconSize/2, y + (3 * iconSize/4) - 4, 2);
+}
+
+void drawAppGraphics(TFT_eSPI& gfx, AppMode mode, int x, int y, int iconSize) {
   int topHalfY = y + iconSize/4; // Center graphics in top half
   
   switch (mode) {
@@ -1038,7 +1207,7 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
         int totalWidth = 5 * keyWidth + 4 * 2; // 5 keys + 4 gaps
         int startX = x + (iconSize - totalWidth) / 2;
         for (int i = 0; i < 5; i++) {
-          tft.fillRect(startX + i*10, topHalfY - 12, keyWidth, 24, THEME_BG);
+          gfx.fillRect(startX + i*10, topHalfY - 12, keyWidth, 24, THEME_BG);
         }
       }
       break;
@@ -1051,7 +1220,7 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
         int startYPos = topHalfY - totalH / 2;
         for (int r = 0; r < 3; r++) {
           for (int c = 0; c < 4; c++) {
-            tft.fillRect(startX + c*(gridW+gapX), startYPos + r*(gridH+gapY), gridW, gridH, THEME_BG);
+            gfx.fillRect(startX + c*(gridW+gapX), startYPos + r*(gridH+gapY), gridW, gridH, THEME_BG);
           }
         }
       }
@@ -1059,47 +1228,47 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
     case BOUNCING_BALL: // ZEN - circle with dots
       {
         int centerX = x + iconSize/2;
-        tft.drawCircle(centerX, topHalfY, 12, THEME_BG);
-        tft.fillCircle(centerX - 6, topHalfY - 4, 2, THEME_BG);
-        tft.fillCircle(centerX + 5, topHalfY + 2, 2, THEME_BG);
-        tft.fillCircle(centerX - 2, topHalfY + 6, 2, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 12, THEME_BG);
+        gfx.fillCircle(centerX - 6, topHalfY - 4, 2, THEME_BG);
+        gfx.fillCircle(centerX + 5, topHalfY + 2, 2, THEME_BG);
+        gfx.fillCircle(centerX - 2, topHalfY + 6, 2, THEME_BG);
       }
       break;
     case PHYSICS_DROP: // DROP - balls falling on platforms
       {
         int centerX = x + iconSize/2;
         // Draw platforms
-        tft.fillRect(centerX - 10, topHalfY + 8, 8, 2, THEME_BG);
-        tft.fillRect(centerX + 4, topHalfY + 4, 6, 2, THEME_BG);
+        gfx.fillRect(centerX - 10, topHalfY + 8, 8, 2, THEME_BG);
+        gfx.fillRect(centerX + 4, topHalfY + 4, 6, 2, THEME_BG);
         // Draw falling balls
-        tft.fillCircle(centerX - 6, topHalfY - 8, 2, THEME_BG);
-        tft.fillCircle(centerX + 2, topHalfY - 4, 2, THEME_BG);
-        tft.fillCircle(centerX + 8, topHalfY, 2, THEME_BG);
+        gfx.fillCircle(centerX - 6, topHalfY - 8, 2, THEME_BG);
+        gfx.fillCircle(centerX + 2, topHalfY - 4, 2, THEME_BG);
+        gfx.fillCircle(centerX + 8, topHalfY, 2, THEME_BG);
       }
       break;
     case RANDOM_GENERATOR: // RNG - random dots
       {
         int centerX = x + iconSize/2;
-        tft.fillCircle(centerX - 16, topHalfY - 12, 4, THEME_BG);
-        tft.fillCircle(centerX - 2, topHalfY - 6, 4, THEME_BG);
-        tft.fillCircle(centerX + 14, topHalfY + 2, 4, THEME_BG);
-        tft.fillCircle(centerX - 8, topHalfY + 12, 4, THEME_BG);
+        gfx.fillCircle(centerX - 16, topHalfY - 12, 4, THEME_BG);
+        gfx.fillCircle(centerX - 2, topHalfY - 6, 4, THEME_BG);
+        gfx.fillCircle(centerX + 14, topHalfY + 2, 4, THEME_BG);
+        gfx.fillCircle(centerX - 8, topHalfY + 12, 4, THEME_BG);
       }
       break;
     case XY_PAD: // XY PAD - crosshairs
       {
         int centerX = x + iconSize/2;
         int crossSize = 28;
-        tft.drawFastHLine(centerX - crossSize/2, topHalfY, crossSize, THEME_BG);
-        tft.drawFastVLine(centerX, topHalfY - crossSize/2, crossSize, THEME_BG);
-        tft.fillCircle(centerX, topHalfY, 6, THEME_BG);
+        gfx.drawFastHLine(centerX - crossSize/2, topHalfY, crossSize, THEME_BG);
+        gfx.drawFastVLine(centerX, topHalfY - crossSize/2, crossSize, THEME_BG);
+        gfx.fillCircle(centerX, topHalfY, 6, THEME_BG);
       }
       break;
     case ARPEGGIATOR: // ARP - ascending notes
       {
         int centerX = x + iconSize/2;
         for (int i = 0; i < 4; i++) {
-          tft.fillCircle(centerX - 14 + i*10, topHalfY + 10 - i*6, 4, THEME_BG);
+          gfx.fillCircle(centerX - 14 + i*10, topHalfY + 10 - i*6, 4, THEME_BG);
         }
       }
       break;
@@ -1112,7 +1281,7 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
         int startYPos = topHalfY - totalH / 2;
         for (int r = 0; r < 3; r++) {
           for (int c = 0; c < 4; c++) {
-            tft.drawRect(startX + c*(cellW+gapX), startYPos + r*(cellH+gapY), cellW, cellH, THEME_BG);
+            gfx.drawRect(startX + c*(cellW+gapX), startYPos + r*(cellH+gapY), cellW, cellH, THEME_BG);
           }
         }
       }
@@ -1121,9 +1290,9 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
       {
         int centerX = x + iconSize/2;
         int lineWidth = 28;
-        tft.fillRect(centerX - lineWidth/2, topHalfY + 8, lineWidth, 4, THEME_BG);
-        tft.fillRect(centerX - lineWidth/2, topHalfY, lineWidth, 4, THEME_BG);
-        tft.fillRect(centerX - lineWidth/2, topHalfY - 8, lineWidth, 4, THEME_BG);
+        gfx.fillRect(centerX - lineWidth/2, topHalfY + 8, lineWidth, 4, THEME_BG);
+        gfx.fillRect(centerX - lineWidth/2, topHalfY, lineWidth, 4, THEME_BG);
+        gfx.fillRect(centerX - lineWidth/2, topHalfY - 8, lineWidth, 4, THEME_BG);
       }
       break;
     case LFO: // LFO - simple sine wave line
@@ -1140,7 +1309,7 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
           int py = topHalfY + (int)(12 * sin(angle));
           
           // Draw line from last point to current point
-          tft.drawLine(lastX, lastY, px, py, THEME_BG);
+          gfx.drawLine(lastX, lastY, px, py, THEME_BG);
           
           lastX = px;
           lastY = py;
@@ -1151,16 +1320,16 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
       {
         int centerX = x + iconSize/2;
         // Draw circle face outline (2 pixels thick for visibility)
-        tft.drawCircle(centerX, topHalfY, 18, THEME_BG);
-        tft.drawCircle(centerX, topHalfY, 17, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 18, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 17, THEME_BG);
         // Eyes (filled dots)
-        tft.fillCircle(centerX - 8, topHalfY - 5, 3, THEME_BG);
-        tft.fillCircle(centerX + 8, topHalfY - 5, 3, THEME_BG);
+        gfx.fillCircle(centerX - 8, topHalfY - 5, 3, THEME_BG);
+        gfx.fillCircle(centerX + 8, topHalfY - 5, 3, THEME_BG);
         // Acid smiley mouth (wide smile - curves upward, thicker line)
         for (int i = -10; i <= 10; i++) {
           int y = topHalfY + 8 - (abs(i) * abs(i)) / 20;
-          tft.drawPixel(centerX + i, y, THEME_BG);
-          tft.drawPixel(centerX + i, y + 1, THEME_BG); // Make it thicker
+          gfx.drawPixel(centerX + i, y, THEME_BG);
+          gfx.drawPixel(centerX + i, y + 1, THEME_BG); // Make it thicker
         }
       }
       break;
@@ -1168,54 +1337,54 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
       {
         int centerX = x + iconSize/2;
         // Draw concentric circles representing drum pattern map
-        tft.drawCircle(centerX, topHalfY, 16, THEME_BG);
-        tft.drawCircle(centerX, topHalfY, 10, THEME_BG);
-        tft.drawCircle(centerX, topHalfY, 4, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 16, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 10, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 4, THEME_BG);
         // Draw dots representing triggers in different positions
-        tft.fillCircle(centerX, topHalfY - 10, 2, THEME_BG);
-        tft.fillCircle(centerX + 8, topHalfY + 6, 2, THEME_BG);
-        tft.fillCircle(centerX - 8, topHalfY + 6, 2, THEME_BG);
+        gfx.fillCircle(centerX, topHalfY - 10, 2, THEME_BG);
+        gfx.fillCircle(centerX + 8, topHalfY + 6, 2, THEME_BG);
+        gfx.fillCircle(centerX - 8, topHalfY + 6, 2, THEME_BG);
       }
       break;
     case RAGA: // RAGA - Indian classical music (sitar/tanpura shape)
       {
         int centerX = x + iconSize/2;
         // Draw sitar/tanpura body (gourd shape)
-        tft.fillCircle(centerX, topHalfY + 6, 12, THEME_BG);
+        gfx.fillCircle(centerX, topHalfY + 6, 12, THEME_BG);
         // Neck
-        tft.fillRect(centerX - 2, topHalfY - 18, 4, 24, THEME_BG);
+        gfx.fillRect(centerX - 2, topHalfY - 18, 4, 24, THEME_BG);
         // Tuning pegs
-        tft.drawLine(centerX - 2, topHalfY - 16, centerX - 8, topHalfY - 18, THEME_BG);
-        tft.drawLine(centerX + 2, topHalfY - 16, centerX + 8, topHalfY - 18, THEME_BG);
+        gfx.drawLine(centerX - 2, topHalfY - 16, centerX - 8, topHalfY - 18, THEME_BG);
+        gfx.drawLine(centerX + 2, topHalfY - 16, centerX + 8, topHalfY - 18, THEME_BG);
         // Strings (vertical lines)
-        tft.drawFastVLine(centerX - 4, topHalfY - 10, 16, THEME_BG);
-        tft.drawFastVLine(centerX, topHalfY - 10, 16, THEME_BG);
-        tft.drawFastVLine(centerX + 4, topHalfY - 10, 16, THEME_BG);
+        gfx.drawFastVLine(centerX - 4, topHalfY - 10, 16, THEME_BG);
+        gfx.drawFastVLine(centerX, topHalfY - 10, 16, THEME_BG);
+        gfx.drawFastVLine(centerX + 4, topHalfY - 10, 16, THEME_BG);
         // Bridge
-        tft.drawFastHLine(centerX - 8, topHalfY + 10, 16, THEME_BG);
+        gfx.drawFastHLine(centerX - 8, topHalfY + 10, 16, THEME_BG);
       }
       break;
     case EUCLIDEAN: // EUCLIDEAN - Euclidean rhythm (multi-ring circular pattern)
       {
         int centerX = x + iconSize/2;
         // Draw 4 concentric circles with dots (representing Euclidean patterns)
-        tft.drawCircle(centerX, topHalfY, 18, THEME_BG);
-        tft.drawCircle(centerX, topHalfY, 14, THEME_BG);
-        tft.drawCircle(centerX, topHalfY, 10, THEME_BG);
-        tft.drawCircle(centerX, topHalfY, 6, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 18, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 14, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 10, THEME_BG);
+        gfx.drawCircle(centerX, topHalfY, 6, THEME_BG);
         // Event markers at different positions on each ring
         // Outer ring - 4 events
         for (int i = 0; i < 4; i++) {
           float angle = (i * TWO_PI / 4) - HALF_PI;
-          tft.fillCircle(centerX + cos(angle) * 18, topHalfY + sin(angle) * 18, 2, THEME_BG);
+          gfx.fillCircle(centerX + cos(angle) * 18, topHalfY + sin(angle) * 18, 2, THEME_BG);
         }
         // Mid-outer ring - 3 events
         for (int i = 0; i < 3; i++) {
           float angle = (i * TWO_PI / 3) - HALF_PI + 0.5;
-          tft.fillCircle(centerX + cos(angle) * 14, topHalfY + sin(angle) * 14, 2, THEME_BG);
+          gfx.fillCircle(centerX + cos(angle) * 14, topHalfY + sin(angle) * 14, 2, THEME_BG);
         }
         // Center dot
-        tft.fillCircle(centerX, topHalfY, 2, THEME_BG);
+        gfx.fillCircle(centerX, topHalfY, 2, THEME_BG);
       }
       break;
     case MORPH: // MORPH - Gesture morphing (infinity symbol with trail)
@@ -1226,7 +1395,7 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
           float scale = 16.0f;
           float ix = scale * cos(t) / (1 + sin(t) * sin(t));
           float iy = scale * sin(t) * cos(t) / (1 + sin(t) * sin(t));
-          tft.drawPixel(centerX + (int)ix, topHalfY + (int)iy, THEME_BG);
+          gfx.drawPixel(centerX + (int)ix, topHalfY + (int)iy, THEME_BG);
         }
         // Add flowing particles
         for (int i = 0; i < 3; i++) {
@@ -1234,7 +1403,7 @@ void drawAppGraphics(AppMode mode, int x, int y, int iconSize) {
           float scale = 16.0f;
           float px = scale * cos(t) / (1 + sin(t) * sin(t));
           float py = scale * sin(t) * cos(t) / (1 + sin(t) * sin(t));
-          tft.fillCircle(centerX + (int)px, topHalfY + (int)py, 2, THEME_BG);
+          gfx.fillCircle(centerX + (int)px, topHalfY + (int)py, 2, THEME_BG);
         }
       }
       break;
@@ -1261,7 +1430,7 @@ void handleMenuTouch() {
     tft.drawCentreString(globalState.bleConnected ? "Connected" : "Waiting for connection", SCREEN_WIDTH/2, SCALED_H(120), 2);
     tft.setTextColor(THEME_TEXT_DIM, THEME_BG);
     tft.drawCentreString("Device: CYD MIDI", SCREEN_WIDTH/2, SCALED_H(160), 2);
-    String mac = BLEDevice::getAddress().toString().c_str();
+    String mac = bleReady ? BLEDevice::getAddress().toString().c_str() : "starting...";
     tft.drawCentreString("MAC: " + mac, SCREEN_WIDTH/2, SCALED_H(190), 2);
     drawRoundButton((SCREEN_WIDTH - BTN_LARGE_W) / 2, SCALED_H(240), BTN_LARGE_W, BTN_SMALL_H, "BACK", THEME_PRIMARY);
     while (true) {
@@ -1306,7 +1475,9 @@ void handleMenuTouch() {
 }
 
 void enterMode(AppMode mode) {
+  StepClock::stop();  // Sequencer modes restart it once initialized
   currentMode = mode;
+  RenderThread::flush();  // Don't let tiles from the previous mode land on the new screen
   
   // NOTE: UIManager::clearMode() not called yet - will be used after mode migration
   
@@ -1362,8 +1533,10 @@ void enterMode(AppMode mode) {
 }
 
 void exitToMenu() {
+  StepClock::stop();
   currentMode = MENU;
   stopAllModes();
+  RenderThread::flush();
   // NOTE: UIManager::clearMode() not called yet - will be used after mode migration
   drawMenu();
 }
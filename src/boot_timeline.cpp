@@ -0,0 +1,50 @@
+#include "boot_timeline.h"
+
+BootTimeline::Event BootTimeline::events[BOOT_TIMELINE_MAX_EVENTS];
+int BootTimeline::eventCount = 0;
+bool BootTimeline::firstNoteSeen = false;
+portMUX_TYPE BootTimeline::lock = portMUX_INITIALIZER_UNLOCKED;
+
+void BootTimeline::mark(const char* phase) {
+  uint32_t now = micros();
+  portENTER_CRITICAL(&lock);
+  if (eventCount < BOOT_TIMELINE_MAX_EVENTS) {
+    events[eventCount].phase = phase;
+    events[eventCount].micros = now;
+    eventCount++;
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void BootTimeline::markFirstNote() {
+  if (firstNoteSeen) return;
+  firstNoteSeen = true;
+  mark("first note sent");
+  Serial.printf("Boot: first note sent at %lu ms\n", millis());
+}
+
+String BootTimeline::toText() {
+  // Copy under the lock, format outside it
+  Event snapshot[BOOT_TIMELINE_MAX_EVENTS];
+  portENTER_CRITICAL(&lock);
+  int count = eventCount;
+  memcpy(snapshot, events, count * sizeof(Event));
+  portEXIT_CRITICAL(&lock);
+  
+  String text;
+  text.reserve(count * 48);
+  uint32_t previous = 0;
+  char line[80];
+  for (int i = 0; i < count; i++) {
+    snprintf(line, sizeof(line), "%9lu us  (+%7lu us)  %s\n", (unsigned long)snapshot[i].micros,
+             (unsigned long)(snapshot[i].micros - previous), snapshot[i].phase);
+    text += line;
+    previous = snapshot[i].micros;
+  }
+  return text;
+}
+
+void BootTimeline::print() {
+  Serial.println("\n=== Boot Timeline ===");
+  Serial.print(toText());
+}
@@ -0,0 +1,36 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <Arduino.h>
+
+// Boot timeline
+// Records a microsecond timestamp (since the app started; bootloader time is
+// not included) at the end of each init phase. mark() is safe to call from
+// any task, so phases that run in parallel tasks show up interleaved with
+// setup(). The timeline is printed to serial when setup() finishes and is
+// served at /boot. The first MIDI note actually sent is recorded too, since
+// time to first playable note is what matters on stage.
+#define BOOT_TIMELINE_MAX_EVENTS 24
+
+class BootTimeline {
+public:
+  static void mark(const char* phase);
+  // Records the first note sent after power-on; later calls are ignored
+  static void markFirstNote();
+  static void print();
+  // One line per event: "  12345 us  (+678 us)  phase"
+  static String toText();
+  
+private:
+  struct Event {
+    const char* phase;  // Must be a string literal
+    uint32_t micros;
+  };
+  
+  static Event events[BOOT_TIMELINE_MAX_EVENTS];
+  static int eventCount;
+  static bool firstNoteSeen;
+  static portMUX_TYPE lock;
+};
+
+#endif // BOOT_TIMELINE_H
@@ -12,6 +12,8 @@ struct Ball {
   uint16_t color;
   int size;
   bool active;
+  int16_t drawnX, drawnY;  // Position last pushed to the screen
+  bool drawn;              // False until the ball is on screen
 };
 
 // Play area constants - calculated based on screen size
@@ -19,6 +21,7 @@ struct Ball {
 #define PLAY_AREA_MARGIN_Y_TOP (CONTENT_TOP + 20)
 #define PLAY_AREA_MARGIN_Y_BOTTOM (SCREEN_HEIGHT > 250 ? 100 : 80)
 #define WALL_THICKNESS 4
+#define WALL_LABEL_OVERHANG 2  // Note labels stick out of their wall by up to this
 
 #define MAX_BALLS 4
 Ball balls[MAX_BALLS];
@@ -33,6 +36,7 @@ struct Wall {
   bool active;
   unsigned long activeTime;
   int side; // 0=top, 1=right, 2=bottom, 3=left
+  uint16_t drawnColor; // Color last drawn (walls are only repainted when it changes)
 };
 
 #define NUM_WALLS 24  // 8 top + 8 bottom + 4 left + 4 right
@@ -41,6 +45,12 @@ int ballScale = 0;  // Scale selection
 int ballKey = 0;    // Key selection
 int ballOctave = 4;
 
+// Small back-buffer for ball updates: each frame the region around a ball's old
+// and new position is composed off-screen (background, wall labels, balls) and
+// pushed in one block, so nothing is erased on the panel and there's no flicker
+#define BALL_TILE_SIZE 32
+TFT_eSprite ballTile = TFT_eSprite(&tft);
+
 // Function declarations
 void initializeBouncingBallMode();
 void drawBouncingBallMode();
@@ -51,6 +61,10 @@ void updateBouncingBall();
 void updateBalls();
 void drawBalls();
 void drawWalls();
+void drawWall(TFT_eSPI& gfx, int i, uint16_t color, int offsetX, int offsetY);
+uint16_t getWallColor(int i);
+void pushBallTile(int x, int y, int w, int h);
+void updateBallTiles();
 void checkWallCollisions();
 
 // Implementations
@@ -62,10 +76,19 @@ void initializeBouncingBallMode() {
   initializeBalls();
   initializeWalls();
   
+  // Allocate the ball back-buffer once (2KB, kept for later visits)
+  if (!ballTile.created()) {
+    ballTile.setColorDepth(16);
+    if (!ballTile.createSprite(BALL_TILE_SIZE, BALL_TILE_SIZE)) {
+      Serial.println("ZEN: ball tile allocation failed, using direct drawing");
+    }
+  }
+  
   drawBouncingBallMode();
 }
 
 void drawBouncingBallMode() {
+  RenderThread::flush();
   tft.fillScreen(THEME_BG);
   drawModuleHeader("ZEN");
   
@@ -110,6 +133,7 @@ void initializeBalls() {
     balls[i].color = random(0x2000, 0x8FFF);
     balls[i].size = random(4, 7);
     balls[i].active = (i < numActiveBalls);
+    balls[i].drawn = false;
   }
 }
 
@@ -273,24 +297,19 @@ void updateBouncingBall() {
   // Smooth 60 FPS animation
   static unsigned long lastUpdate = 0;
   if (millis() - lastUpdate > 16) {
-    const int playLeft = PLAY_AREA_MARGIN_X;
-    const int playRight = SCREEN_WIDTH - PLAY_AREA_MARGIN_X;
-    const int playTop = PLAY_AREA_MARGIN_Y_TOP;
-    const int playBottom = SCREEN_HEIGHT - PLAY_AREA_MARGIN_Y_BOTTOM;
-    
-    // Clear entire play area to prevent flickering
-    tft.fillRect(playLeft + WALL_THICKNESS, playTop + WALL_THICKNESS, 
-                 playRight - playLeft - 2 * WALL_THICKNESS, 
-                 playBottom - playTop - 2 * WALL_THICKNESS, THEME_BG);
-    
     updateBalls();
     checkWallCollisions();
     
-    // Draw walls
-    drawWalls();
+    // Repaint only walls whose flash state changed
+    for (int i = 0; i < NUM_WALLS; i++) {
+      uint16_t color = getWallColor(i);
+      if (color != walls[i].drawnColor) {
+        drawWall(tft, i, color, 0, 0);
+      }
+    }
     
-    // Draw balls
-    drawBalls();
+    // Push the regions the balls moved through
+    updateBallTiles();
     
     lastUpdate = millis();
   }
@@ -334,33 +353,115 @@ void drawBalls() {
     if (!balls[i].active) continue;
     tft.fillCircle(balls[i].x, balls[i].y, balls[i].size, balls[i].color);
     tft.drawCircle(balls[i].x, balls[i].y, balls[i].size, THEME_TEXT);
+    balls[i].drawnX = balls[i].x;
+    balls[i].drawnY = balls[i].y;
+    balls[i].drawn = true;
+  }
+}
+
+uint16_t getWallColor(int i) {
+  // Bright flash when active
+  if (walls[i].active) {
+    unsigned long elapsed = millis() - walls[i].activeTime;
+    if (elapsed < 200) {
+      return THEME_TEXT; // Bright white flash
+    }
+    walls[i].active = false;
+  }
+  return walls[i].color;
+}
+
+// Draw one wall segment to the panel or to the ball tile (offset = tile origin)
+void drawWall(TFT_eSPI& gfx, int i, uint16_t color, int offsetX, int offsetY) {
+  int x = walls[i].x - offsetX;
+  int y = walls[i].y - offsetY;
+  
+  gfx.fillRect(x, y, walls[i].w, walls[i].h, color);
+  
+  // Add note name for horizontal walls (top and bottom)
+  if (walls[i].w > walls[i].h && walls[i].w > 30) {
+    gfx.setTextColor(THEME_BG, color);
+    gfx.drawCentreString(walls[i].noteName, x + walls[i].w/2, y - 2, 1);
+  }
+  
+  if (&gfx == &tft) {
+    walls[i].drawnColor = color;
   }
 }
 
 void drawWalls() {
   for (int i = 0; i < NUM_WALLS; i++) {
-    uint16_t color = walls[i].color;
+    drawWall(tft, i, getWallColor(i), 0, 0);
+  }
+}
+
+// Compose background, overlapping wall labels and balls for one screen region
+// into the back-buffer and push it to the panel in a single transfer
+void pushBallTile(int x, int y, int w, int h) {
+  ballTile.fillRect(0, 0, w, h, THEME_BG);
+  
+  // Every wall whose rectangle touches the tile, padded for the note labels
+  // (8px text drawn 2px above a wall's top edge, so 6px deep)
+  for (int i = 0; i < NUM_WALLS; i++) {
+    int left = walls[i].x - WALL_LABEL_OVERHANG;
+    int top = walls[i].y - WALL_LABEL_OVERHANG;
+    int right = walls[i].x + walls[i].w + WALL_LABEL_OVERHANG;
+    int bottom = walls[i].y + max((int)walls[i].h, 6) + WALL_LABEL_OVERHANG;
+    if (left >= x + w || right <= x || top >= y + h || bottom <= y) continue;
+    drawWall(ballTile, i, walls[i].drawnColor, x, y);
+  }
+  
+  for (int i = 0; i < numActiveBalls; i++) {
+    if (!balls[i].active) continue;
+    int bx = (int)balls[i].x - x;
+    int by = (int)balls[i].y - y;
+    ballTile.fillCircle(bx, by, balls[i].size, balls[i].color);
+    ballTile.drawCircle(bx, by, balls[i].size, THEME_TEXT);
+  }
+  
+  // Hand the tile to the render thread; push it ourselves if it can't take it
+  if (!RenderThread::submitSprite(ballTile, x, y, w, h)) {
+    ballTile.pushSprite(x, y, 0, 0, w, h);
+    tft.markImage(x, y, w, h);
+  }
+}
+
+void updateBallTiles() {
+  for (int i = 0; i < numActiveBalls; i++) {
+    if (!balls[i].active) continue;
     
-    // Bright flash when active
-    if (walls[i].active) {
-      unsigned long elapsed = millis() - walls[i].activeTime;
-      if (elapsed < 200) {
-        color = THEME_TEXT; // Bright white flash
+    int r = balls[i].size + 1;
+    int newX = balls[i].x;
+    int newY = balls[i].y;
+    
+    if (!ballTile.created()) {
+      // No back-buffer - erase and redraw directly
+      if (balls[i].drawn) {
+        tft.fillCircle(balls[i].drawnX, balls[i].drawnY, balls[i].size, THEME_BG);
+      }
+      tft.fillCircle(newX, newY, balls[i].size, balls[i].color);
+      tft.drawCircle(newX, newY, balls[i].size, THEME_TEXT);
+    } else {
+      // Bounding box covering the old and new ball position
+      int oldX = balls[i].drawn ? balls[i].drawnX : newX;
+      int oldY = balls[i].drawn ? balls[i].drawnY : newY;
+      int x0 = min(oldX, newX) - r;
+      int y0 = min(oldY, newY) - r;
+      int x1 = max(oldX, newX) + r;
+      int y1 = max(oldY, newY) + r;
+      
+      if (x1 - x0 < BALL_TILE_SIZE && y1 - y0 < BALL_TILE_SIZE) {
+        pushBallTile(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
       } else {
-        walls[i].active = false;
+        // Moved too far for one tile - refresh old and new spots separately
+        pushBallTile(oldX - r, oldY - r, 2 * r + 1, 2 * r + 1);
+        pushBallTile(newX - r, newY - r, 2 * r + 1, 2 * r + 1);
       }
     }
     
-    // Draw wall
-    tft.fillRect(walls[i].x, walls[i].y, walls[i].w, walls[i].h, color);
-    
-    // Add note name for horizontal walls (top and bottom)
-    if (walls[i].w > walls[i].h && walls[i].w > 30) {
-      tft.setTextColor(THEME_BG, color);
-      tft.drawCentreString(walls[i].noteName, 
-                          walls[i].x + walls[i].w/2, 
-                          walls[i].y - 2, 1);
-    }
+    balls[i].drawnX = newX;
+    balls[i].drawnY = newY;
+    balls[i].drawn = true;
   }
 }
 
@@ -0,0 +1,155 @@
+#include "button_cache.h"
+
+// Palette indices of the 4-bit button sprites
+enum : uint8_t { PALETTE_TRANSPARENT, PALETTE_FILL, PALETTE_OUTLINE, PALETTE_TEXT };
+
+ButtonCache::Entry ButtonCache::entries[BUTTON_CACHE_MAX_ENTRIES];
+size_t ButtonCache::bytesUsed = 0;
+uint32_t ButtonCache::useCounter = 0;
+uint32_t ButtonCache::hits = 0;
+uint32_t ButtonCache::misses = 0;
+String ButtonCache::labels[BUTTON_CACHE_MAX_LABELS];
+int ButtonCache::labelCount = 0;
+int ButtonCache::shadowSource = -1;
+
+// Labels only ever come from a fixed set of UI strings, so the table is
+// never pruned; display list commands refer to labels by index
+int ButtonCache::findLabel(const String& text) {
+  for (int i = 0; i < labelCount; i++) {
+    if (labels[i] == text) return i;
+  }
+  if (labelCount >= BUTTON_CACHE_MAX_LABELS) return -1;
+  labels[labelCount] = text;
+  return labelCount++;
+}
+
+void ButtonCache::render(TFT_eSPI& gfx, int x, int y, int w, int h, const String& text,
+                         uint16_t fill, uint16_t outline, uint16_t textColor) {
+  gfx.fillRoundRect(x, y, w, h, 8, fill);
+  gfx.drawRoundRect(x, y, w, h, 8, outline);
+  gfx.drawRoundRect(x + 1, y + 1, w - 2, h - 2, 7, outline);
+  gfx.setTextColor(textColor, fill);
+  gfx.drawCentreString(text, x + w/2, y + h/2 - 8, 2);
+}
+
+// Key: label index in bits 0-7, pressed in bit 8, colour in bits 16-31
+void ButtonCache::replay(TFT_eSPI& target, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t key) {
+  int label = key & 0xFF;
+  if (label >= labelCount) return;
+  bool pressed = key & 0x100;
+  uint16_t color = key >> 16;
+  render(target, x, y, w, h, labels[label], pressed ? color : THEME_BG, color,
+         pressed ? THEME_BG : color);
+}
+
+ButtonCache::Entry* ButtonCache::find(int w, int h, const String& text, uint16_t color, bool pressed) {
+  for (int i = 0; i < BUTTON_CACHE_MAX_ENTRIES; i++) {
+    Entry& e = entries[i];
+    if (e.sprite && e.w == w && e.h == h && e.color == color &&
+        e.pressed == pressed && e.text == text) {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+void ButtonCache::evict(Entry& entry) {
+  if (!entry.sprite) return;
+  bytesUsed -= spriteBytes(entry.w, entry.h);
+  entry.sprite->deleteSprite();
+  delete entry.sprite;
+  entry.sprite = nullptr;
+  entry.text = "";
+}
+
+// Find a free slot, evicting least recently used entries until the budget fits
+ButtonCache::Entry* ButtonCache::allocate(size_t bytes) {
+  while (true) {
+    Entry* freeSlot = nullptr;
+    Entry* oldest = nullptr;
+    for (int i = 0; i < BUTTON_CACHE_MAX_ENTRIES; i++) {
+      Entry& e = entries[i];
+      if (!e.sprite) {
+        if (!freeSlot) freeSlot = &e;
+      } else if (!oldest || e.lastUsed < oldest->lastUsed) {
+        oldest = &e;
+      }
+    }
+    
+    if (freeSlot && bytesUsed + bytes <= BUTTON_CACHE_BUDGET) return freeSlot;
+    if (!oldest) return nullptr;
+    evict(*oldest);
+  }
+}
+
+bool ButtonCache::draw(int x, int y, int w, int h, const String& text, uint16_t color, bool pressed) {
+  size_t bytes = spriteBytes(w, h);
+  if (w <= 0 || h <= 0 || bytes > BUTTON_CACHE_BUDGET) return false;
+  
+  Entry* entry = find(w, h, text, color, pressed);
+  
+  if (entry) {
+    hits++;
+  } else {
+    // Text wider than the button would be clipped by the sprite - draw directly
+    if (tft.textWidth(text, 2) > w) return false;
+    
+    entry = allocate(bytes);
+    if (!entry) return false;
+    
+    TFT_eSprite* sprite = new TFT_eSprite(&tft);
+    sprite->setColorDepth(4);
+    if (!sprite->createSprite(w, h)) {
+      delete sprite;
+      return false;
+    }
+    
+    // 4-bit sprites draw with palette indices; index 0 is the transparent
+    // corners, so whatever is underneath shows through
+    uint16_t bgColor = pressed ? color : THEME_BG;
+    uint16_t textColor = pressed ? THEME_BG : color;
+    uint16_t palette[16] = {0};
+    palette[PALETTE_FILL] = bgColor;
+    palette[PALETTE_OUTLINE] = color;
+    palette[PALETTE_TEXT] = textColor;
+    sprite->createPalette(palette, 16);
+    
+    // Same primitives as drawRoundButton(), rendered once off-screen
+    sprite->fillSprite(PALETTE_TRANSPARENT);
+    render(*sprite, 0, 0, w, h, text, PALETTE_FILL, PALETTE_OUTLINE, PALETTE_TEXT);
+    
+    entry->sprite = sprite;
+    entry->text = text;
+    entry->w = w;
+    entry->h = h;
+    entry->color = color;
+    entry->pressed = pressed;
+    entry->label = findLabel(text);
+    bytesUsed += bytes;
+    misses++;
+  }
+  
+  entry->lastUsed = ++useCounter;
+  entry->sprite->pushSprite(x, y, PALETTE_TRANSPARENT);
+  if (shadowSource < 0) shadowSource = tft.addImageSource(replay);
+  if (entry->label >= 0) {
+    tft.markImage(x, y, w, h, shadowSource, entry->label | (pressed ? 0x100 : 0) | ((uint32_t)color << 16));
+  } else {
+    tft.markImage(x, y, w, h);
+  }
+  return true;
+}
+
+void ButtonCache::clear() {
+  for (int i = 0; i < BUTTON_CACHE_MAX_ENTRIES; i++) {
+    evict(entries[i]);
+  }
+}
+
+void ButtonCache::printStats() {
+  uint32_t lookups = hits + misses;
+  Serial.printf("Button cache: %u hits, %u misses (%u%% hit rate), %u/%u bytes\n",
+                (unsigned)hits, (unsigned)misses,
+                lookups ? (unsigned)(hits * 100ULL / lookups) : 0,
+                (unsigned)bytesUsed, (unsigned)BUTTON_CACHE_BUDGET);
+}
@@ -0,0 +1,73 @@
+#ifndef BUTTON_CACHE_H
+#define BUTTON_CACHE_H
+
+#include "common_definitions.h"
+
+// Pre-rendered button bitmap cache
+// drawRoundButton() is called constantly (press feedback, control redraws), and
+// each call re-rasterises two rounded rects plus text. The cache keeps recently
+// used buttons as sprites keyed by (w, h, text, color, pressed) so a repaint is
+// a single block transfer. A button only uses three colours (fill, outline,
+// text) plus the transparent corners, so sprites are 4-bit with a palette, a
+// quarter of the size of RGB565. Least recently used entries are evicted once
+// the memory budget is exceeded. Define BUTTON_CACHE_BUDGET as 0 to disable.
+// Blits are recorded in the display list by label, colour and pressed state,
+// so screenshots redraw them from the same primitives instead of reading the
+// panel back.
+//
+// The budget holds the widest control row (four buttons across the screen,
+// 50 high, as in Grids) in both pressed states, plus room for the header's
+// BACK button, so press feedback on a row never evicts its own buttons.
+#define BUTTON_CACHE_ROW_BYTES (4 * ((((SCREEN_WIDTH - 50) / 4) + 1) / 2) * 50)
+#ifndef BUTTON_CACHE_BUDGET
+#define BUTTON_CACHE_BUDGET (2 * BUTTON_CACHE_ROW_BYTES + 2 * 1024)  // Bytes of pixel data
+#endif
+#define BUTTON_CACHE_MAX_ENTRIES 16
+#define BUTTON_CACHE_MAX_LABELS  48  // Distinct labels the display list can redraw
+
+class ButtonCache {
+public:
+  // Draw a button from the cache, rendering and caching it on a miss.
+  // Returns false if the button can't be cached (caller draws it directly).
+  static bool draw(int x, int y, int w, int h, const String& text, uint16_t color, bool pressed);
+  static void clear();
+  
+  static uint32_t getHits() { return hits; }
+  static uint32_t getMisses() { return misses; }
+  static size_t getBytesUsed() { return bytesUsed; }
+  static void printStats();
+  
+private:
+  struct Entry {
+    TFT_eSprite* sprite = nullptr;
+    String text;
+    int16_t w = 0, h = 0;
+    uint16_t color = 0;
+    int16_t label = -1;        // Index into labels[], -1 if the table was full
+    bool pressed = false;
+    uint32_t lastUsed = 0;
+  };
+  
+  static Entry entries[BUTTON_CACHE_MAX_ENTRIES];
+  static size_t bytesUsed;
+  static uint32_t useCounter;
+  static uint32_t hits;
+  static uint32_t misses;
+  
+  static String labels[BUTTON_CACHE_MAX_LABELS];
+  static int labelCount;
+  static int shadowSource;
+  
+  static size_t spriteBytes(int w, int h) { return ((w + 1) / 2) * h; }
+  static int findLabel(const String& text);
+  // The primitives of drawRoundButton(), in any colours (palette indices on a sprite)
+  static void render(TFT_eSPI& gfx, int x, int y, int w, int h, const String& text,
+                     uint16_t fill, uint16_t outline, uint16_t textColor);
+  // Display list replay (ShadowTFT::ImageSource)
+  static void replay(TFT_eSPI& target, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t key);
+  static Entry* find(int w, int h, const String& text, uint16_t color, bool pressed);
+  static Entry* allocate(size_t bytes);
+  static void evict(Entry& entry);
+};
+
+#endif // BUTTON_CACHE_H
@@ -4,6 +4,7 @@
 #include <TFT_eSPI.h>
 #include <XPT2046_Touchscreen.h>
 #include <BLEDevice.h>
+#include "display_shadow.h"
 
 // Color scheme
 #define THEME_BG         0x0841
@@ -140,6 +141,7 @@ public:
   static void sendStop();
   static void setBPM(float bpm);
   static float getBPM();
+  static uint32_t queueDepth() { return midiQueue ? uxQueueMessagesWaiting(midiQueue) : 0; }
   
 private:
   static QueueHandle_t midiQueue;
@@ -152,6 +154,62 @@ private:
     uint8_t data2;
     int16_t data16;
   };
+  
+  static void enqueue(const MIDIMessage& msg);
+};
+
+// Network MIDI outputs (RTP-MIDI, OSC) get a copy of every outgoing message
+// through here, from whichever task sends it. Both return at once while
+// nothing is listening.
+bool networkMIDIActive();
+void sendMIDIToNetwork(const uint8_t* message, size_t length);
+
+// Render thread - pushes pixel tiles to the display off the main loop
+// SPI bus ownership: the main loop holds the display lock while it runs (touch,
+// mode handlers, parameter redraws) and releases it for its idle delay. The
+// render task only touches the panel while holding the same lock, so tiles
+// queued by a mode are flushed in the loop's idle window. Code that draws
+// directly to tft from any other task must take the lock first.
+// With DMA (ILI9341) a tile's buffer is only handed back once its transfer is
+// done, and the next tile is set up while the previous one is still going out.
+// TFT_eSPI has no DMA for the ILI9488 (18-bit colour is converted on the CPU),
+// so there every tile goes out with a blocking pushImage and the buffers only
+// serve as the queue from the loop to the render task.
+#define RENDER_TILE_BUFFERS    4
+#define RENDER_TILE_MAX_PIXELS (32 * 32)
+
+class RenderThread {
+public:
+  static void begin();
+  static bool isRunning();
+  // Returns false if the display isn't free within 'wait' (the loop keeps it
+  // for the whole of a modal screen, so readers on other tasks should time out)
+  static bool lockDisplay(TickType_t wait = portMAX_DELAY);
+  static void unlockDisplay();
+  // Copy a region of a 16-bit sprite into a tile buffer and queue it for
+  // pushing. Caller must hold the display lock. Returns false if the tile
+  // can't be queued (caller should push it directly).
+  static bool submitSprite(TFT_eSprite& sprite, int32_t x, int32_t y, int32_t w, int32_t h);
+  // Push all pending tiles now. Caller must hold the display lock.
+  // Call before a full-screen redraw so stale tiles don't land on top of it.
+  static void flush();
+  
+private:
+  struct RenderTile {
+    int16_t x, y, w, h;
+    uint8_t buffer;
+  };
+  
+  static QueueHandle_t tileQueue;
+  static QueueHandle_t freeQueue;
+  static SemaphoreHandle_t displayMutex;
+  static uint16_t* tileBuffers[RENDER_TILE_BUFFERS];
+  static bool running;
+  static bool dmaEnabled;
+  static int16_t inFlight;  // Buffer whose DMA transfer may still be running, -1 if none
+  static void pushTile(const RenderTile& tile);
+  static void finishTiles();
+  static void renderTask(void* parameter);
 };
 
 // App modes
@@ -174,6 +232,33 @@ enum AppMode {
   MORPH
 };
 
+// Step clock - runs sequencer step timing off the drawing loop
+// A sequencer mode starts the clock with its tick function when it is entered;
+// the clock task calls it every STEP_CLOCK_PERIOD_MS while that mode is on
+// screen, so steps don't wait for the loop's redraws or its idle delay. Ticks
+// send MIDI and advance state but never draw: the mode's handler repaints
+// (incrementally) from that state on its next pass. Loop code that changes
+// several fields a tick reads (transport start/stop, pattern regeneration)
+// does it between lock() and unlock(), and draws after unlocking.
+#define STEP_CLOCK_PERIOD_MS 1
+
+typedef void (*StepTick)();
+
+class StepClock {
+public:
+  static void begin();
+  static void start(AppMode mode, StepTick tick);
+  static void stop();  // Waits for a tick in progress
+  static void lock();
+  static void unlock();
+  
+private:
+  static SemaphoreHandle_t clockMutex;
+  static AppMode tickMode;
+  static StepTick tickFunction;
+  static void clockTask(void* parameter);
+};
+
 // Music theory
 struct Scale {
   String name;
@@ -182,7 +267,7 @@ struct Scale {
 };
 
 // Global objects - declared in main file
-extern TFT_eSPI tft;
+extern ShadowTFT tft;
 extern XPT2046_Touchscreen ts;
 extern BLECharacteristic *pCharacteristic;
 // BLE connection state now in GlobalState (globalState.bleConnected)
@@ -0,0 +1,414 @@
+#include "display_shadow.h"
+
+static const char* const OP_NAMES[ShadowTFT::OP_COUNT] = {
+  "none", "drawPixel", "drawFastHLine", "drawFastVLine", "drawLine",
+  "fillRect", "drawChar", "drawChar(font)", "pushImage",
+  "drawCircle", "fillCircle", "drawRoundRect", "fillRoundRect", "pushImage(source)"
+};
+
+// Glyph extents are taken from the font metrics; a little slack covers
+// glyphs that spill past their advance width
+#define GLYPH_CULL_MARGIN 2
+
+ShadowTFT::ShadowTFT(int16_t w, int16_t h)
+  : TFT_eSPI(w, h), commands(nullptr), commandCount(0), stale(true), overflows(0),
+    scratch(nullptr), depth(0), imageSourceCount(0) {
+  resetStats();
+  memset(dirtyRows, 0, sizeof(dirtyRows));
+}
+
+bool ShadowTFT::beginShadow() {
+#if DISPLAY_SHADOW_COMMANDS > 0
+  if (commands) return true;
+  commands = (Command*)malloc(DISPLAY_SHADOW_COMMANDS * sizeof(Command));
+  if (!commands) {
+    Serial.println("Display shadow: allocation failed, screenshots will read the panel");
+    return false;
+  }
+  commandCount = 0;
+  stale = true;  // Nothing recorded yet - valid after the first full-screen fill
+  Serial.printf("Display shadow: %d commands (%u bytes)\n",
+                DISPLAY_SHADOW_COMMANDS, (unsigned)(DISPLAY_SHADOW_COMMANDS * sizeof(Command)));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ShadowTFT::resetStats() {
+  memset(stats, 0, sizeof(stats));
+}
+
+void ShadowTFT::printStats() {
+  Serial.println("Draw call profile:");
+  for (int op = OP_PIXEL; op < OP_COUNT; op++) {
+    if (stats[op].calls == 0) continue;
+    Serial.printf("  %-15s %8u calls %9u us (%u us avg)\n", OP_NAMES[op],
+                  (unsigned)stats[op].calls, (unsigned)stats[op].micros,
+                  (unsigned)(stats[op].micros / stats[op].calls));
+  }
+  Serial.printf("  Display list: %u/%d commands%s, %u overflows\n", commandCount,
+                DISPLAY_SHADOW_COMMANDS, stale ? " (stale)" : "", (unsigned)overflows);
+}
+
+// Primitives nest (fillRect -> drawFastHLine...), so only the outermost call
+// is timed and recorded
+uint32_t ShadowTFT::beginDraw() {
+  return depth++ == 0 ? micros() : 0;
+}
+
+bool ShadowTFT::endDraw(Op op, uint32_t start) {
+  if (--depth != 0) return false;
+  stats[op].calls++;
+  stats[op].micros += micros() - start;
+  return true;
+}
+
+void ShadowTFT::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawPixel(x, y, color);
+  if (endDraw(OP_PIXEL, start)) record(OP_PIXEL, x, y, 1, 1, color);
+}
+
+void ShadowTFT::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawChar(x, y, c, color, bg, size);
+  if (endDraw(OP_CHAR, start)) record(OP_CHAR, x, y, 6 * size, 8 * size, color, bg, c, size);
+}
+
+void ShadowTFT::drawLine(int32_t xs, int32_t ys, int32_t xe, int32_t ye, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawLine(xs, ys, xe, ye, color);
+  if (endDraw(OP_LINE, start)) record(OP_LINE, xs, ys, xe, ye, color);
+}
+
+void ShadowTFT::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawFastVLine(x, y, h, color);
+  if (endDraw(OP_VLINE, start)) record(OP_VLINE, x, y, 1, h, color);
+}
+
+void ShadowTFT::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawFastHLine(x, y, w, color);
+  if (endDraw(OP_HLINE, start)) record(OP_HLINE, x, y, w, 1, color);
+}
+
+void ShadowTFT::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::fillRect(x, y, w, h, color);
+  if (endDraw(OP_FILL_RECT, start)) record(OP_FILL_RECT, x, y, w, h, color);
+}
+
+int16_t ShadowTFT::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) {
+  uint32_t start = beginDraw();
+  int16_t width = TFT_eSPI::drawChar(uniCode, x, y, font);
+  if (endDraw(OP_FONT_CHAR, start)) {
+    record(OP_FONT_CHAR, x, y, width, fontHeight(font), textcolor, textbgcolor,
+           uniCode, (font & 0x0F) | (textsize << 4));
+  }
+  return width;
+}
+
+int16_t ShadowTFT::drawChar(uint16_t uniCode, int32_t x, int32_t y) {
+  return drawChar(uniCode, x, y, textfont);
+}
+
+void ShadowTFT::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::pushImage(x, y, w, h, data);
+  if (endDraw(OP_IMAGE, start)) record(OP_IMAGE, x, y, w, h, 0);
+}
+
+void ShadowTFT::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::pushImage(x, y, w, h, data);
+  if (endDraw(OP_IMAGE, start)) record(OP_IMAGE, x, y, w, h, 0);
+}
+
+void ShadowTFT::drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawCircle(x, y, r, color);
+  if (endDraw(OP_CIRCLE, start)) record(OP_CIRCLE, x, y, r, 0, color);
+}
+
+void ShadowTFT::fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::fillCircle(x, y, r, color);
+  if (endDraw(OP_FILL_CIRCLE, start)) record(OP_FILL_CIRCLE, x, y, r, 0, color);
+}
+
+void ShadowTFT::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::drawRoundRect(x, y, w, h, radius, color);
+  if (endDraw(OP_ROUND_RECT, start)) record(OP_ROUND_RECT, x, y, w, h, color, 0, radius);
+}
+
+void ShadowTFT::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::fillRoundRect(x, y, w, h, radius, color);
+  if (endDraw(OP_FILL_ROUND_RECT, start)) record(OP_FILL_ROUND_RECT, x, y, w, h, color, 0, radius);
+}
+
+#ifdef ESP32_DMA
+void ShadowTFT::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer) {
+  uint32_t start = beginDraw();
+  TFT_eSPI::pushImageDMA(x, y, w, h, data, buffer);
+  if (endDraw(OP_IMAGE, start)) record(OP_IMAGE, x, y, w, h, 0);
+}
+#endif
+
+void ShadowTFT::markImage(int32_t x, int32_t y, int32_t w, int32_t h) {
+  if (depth == 0) record(OP_IMAGE, x, y, w, h, 0);
+}
+
+void ShadowTFT::markImage(int32_t x, int32_t y, int32_t w, int32_t h, int source, uint32_t key) {
+  if (source < 0 || source >= imageSourceCount) {
+    markImage(x, y, w, h);
+    return;
+  }
+  if (depth == 0) record(OP_SOURCE_IMAGE, x, y, w, h, key & 0xFFFF, key >> 16, 0, source);
+}
+
+int ShadowTFT::addImageSource(ImageSource source) {
+  for (int i = 0; i < imageSourceCount; i++) {
+    if (imageSources[i] == source) return i;
+  }
+  if (imageSourceCount >= SHADOW_MAX_IMAGE_SOURCES) return -1;
+  imageSources[imageSourceCount] = source;
+  return imageSourceCount++;
+}
+
+void ShadowTFT::markAllDirty() {
+  markDirty(0, 0, width(), height());
+}
+
+void ShadowTFT::markDirty(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+  x0 = max(x0, (int32_t)0);
+  y0 = max(y0, (int32_t)0);
+  x1 = min(x1, (int32_t)width());
+  y1 = min(y1, (int32_t)height());
+  if (x0 >= x1 || y0 >= y1) return;
+  
+  int tx0 = x0 / SHADOW_TILE_SIZE;
+  int tx1 = min((int)((x1 - 1) / SHADOW_TILE_SIZE), 31);
+  int ty1 = min((int)((y1 - 1) / SHADOW_TILE_SIZE), SHADOW_MAX_TILE_ROWS - 1);
+  uint32_t mask = tileMask(tx0, tx1);
+  for (int ty = y0 / SHADOW_TILE_SIZE; ty <= ty1; ty++) {
+    dirtyRows[ty] |= mask;
+  }
+}
+
+void ShadowTFT::record(Op op, int32_t x, int32_t y, int32_t w, int32_t h,
+                       uint16_t color, uint16_t bg, uint16_t value, uint8_t arg) {
+  Command cmd = {op, arg, (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, value, color, bg};
+  int32_t x0, y0, x1, y1;
+  getBounds(cmd, x0, y0, x1, y1);
+  markDirty(x0, y0, x1, y1);
+  
+  if (!commands) return;
+  
+  // A full-screen fill hides everything before it
+  if (op == OP_FILL_RECT && x <= 0 && y <= 0 && x + w >= width() && y + h >= height()) {
+    commandCount = 0;
+    stale = false;
+  }
+  if (stale) return;
+  
+  if (commandCount >= DISPLAY_SHADOW_COMMANDS) {
+    compact();
+    // Nearly nothing was hidden - give up until the next full-screen fill
+    // rather than compacting on every draw
+    if (commandCount > DISPLAY_SHADOW_COMMANDS - DISPLAY_SHADOW_COMMANDS / 8) {
+      stale = true;
+      commandCount = 0;
+      overflows++;
+      Serial.printf("Display shadow: list full (%d commands), reading the panel until the next full-screen fill\n",
+                    DISPLAY_SHADOW_COMMANDS);
+      return;
+    }
+  }
+  
+  commands[commandCount++] = cmd;
+}
+
+void ShadowTFT::getBounds(const Command& cmd, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1) {
+  if (cmd.op == OP_LINE) {
+    x0 = min(cmd.x, cmd.w);
+    y0 = min(cmd.y, cmd.h);
+    x1 = max(cmd.x, cmd.w) + 1;
+    y1 = max(cmd.y, cmd.h) + 1;
+  } else if (cmd.op == OP_CIRCLE || cmd.op == OP_FILL_CIRCLE) {
+    x0 = cmd.x - cmd.w;
+    y0 = cmd.y - cmd.w;
+    x1 = cmd.x + cmd.w + 1;
+    y1 = cmd.y + cmd.w + 1;
+  } else {
+    x0 = cmd.x;
+    y0 = cmd.y;
+    x1 = cmd.x + cmd.w;
+    y1 = cmd.y + cmd.h;
+  }
+}
+
+// Bits tx0..tx1 (inclusive) of a tile row
+uint32_t ShadowTFT::tileMask(int tx0, int tx1) {
+  return (tx1 == 31 ? 0xFFFFFFFFUL : ((1UL << (tx1 + 1)) - 1)) & ~((1UL << tx0) - 1);
+}
+
+void ShadowTFT::compact() {
+  // Newest to oldest: a command is hidden if every tile it touches is
+  // completely covered by fillRects recorded after it. Survivors are packed
+  // towards the end of the list in their original order.
+  uint32_t covered[SHADOW_MAX_TILE_ROWS] = {0};
+  int32_t screenW = width(), screenH = height();
+  uint16_t kept = commandCount;
+  
+  for (int i = commandCount - 1; i >= 0; i--) {
+    const Command cmd = commands[i];
+    int32_t x0, y0, x1, y1;
+    getBounds(cmd, x0, y0, x1, y1);
+    if (cmd.op == OP_CHAR || cmd.op == OP_FONT_CHAR) {
+      x0 -= GLYPH_CULL_MARGIN;
+      y0 -= GLYPH_CULL_MARGIN;
+      x1 += GLYPH_CULL_MARGIN;
+      y1 += GLYPH_CULL_MARGIN;
+    }
+    x0 = max(x0, (int32_t)0);
+    y0 = max(y0, (int32_t)0);
+    x1 = min(x1, screenW);
+    y1 = min(y1, screenH);
+    if (x0 >= x1 || y0 >= y1) continue;  // Off screen
+    
+    int tx0 = x0 / SHADOW_TILE_SIZE;
+    int tx1 = min((int)((x1 - 1) / SHADOW_TILE_SIZE), 31);
+    int ty0 = y0 / SHADOW_TILE_SIZE;
+    int ty1 = min((int)((y1 - 1) / SHADOW_TILE_SIZE), SHADOW_MAX_TILE_ROWS - 1);
+    uint32_t mask = tileMask(tx0, tx1);
+    bool hidden = true;
+    for (int ty = ty0; ty <= ty1 && hidden; ty++) {
+      hidden = (covered[ty] & mask) == mask;
+    }
+    if (hidden) continue;
+    
+    commands[--kept] = cmd;
+    
+    // Tiles lying wholly inside this fill are covered for everything older
+    if (cmd.op == OP_FILL_RECT) {
+      int cx0 = (x0 + SHADOW_TILE_SIZE - 1) / SHADOW_TILE_SIZE;
+      int cx1 = min((int)(x1 / SHADOW_TILE_SIZE), 32);
+      int cy0 = (y0 + SHADOW_TILE_SIZE - 1) / SHADOW_TILE_SIZE;
+      int cy1 = min((int)(y1 / SHADOW_TILE_SIZE), SHADOW_MAX_TILE_ROWS);
+      if (cx0 < cx1 && cy0 < cy1) {
+        uint32_t fill = tileMask(cx0, cx1 - 1);
+        for (int ty = cy0; ty < cy1; ty++) covered[ty] |= fill;
+      }
+    }
+  }
+  
+  commandCount -= kept;
+  memmove(commands, commands + kept, commandCount * sizeof(Command));
+}
+
+void ShadowTFT::replay(TFT_eSprite& target, int32_t originX, int32_t originY) {
+  int32_t targetW = target.width();
+  int32_t targetH = target.height();
+  uint16_t* pixels = (uint16_t*)target.getPointer();
+  
+  for (uint16_t i = 0; i < commandCount; i++) {
+    const Command& cmd = commands[i];
+    int32_t x0, y0, x1, y1;
+    getBounds(cmd, x0, y0, x1, y1);
+    int32_t margin = (cmd.op == OP_CHAR || cmd.op == OP_FONT_CHAR) ? GLYPH_CULL_MARGIN : 0;
+    if (x1 + margin <= originX || y1 + margin <= originY ||
+        x0 - margin >= originX + targetW || y0 - margin >= originY + targetH) {
+      continue;
+    }
+    
+    int32_t x = cmd.x - originX;
+    int32_t y = cmd.y - originY;
+    switch (cmd.op) {
+      case OP_PIXEL:
+        target.drawPixel(x, y, cmd.color);
+        break;
+      case OP_HLINE:
+        target.drawFastHLine(x, y, cmd.w, cmd.color);
+        break;
+      case OP_VLINE:
+        target.drawFastVLine(x, y, cmd.h, cmd.color);
+        break;
+      case OP_LINE:
+        target.drawLine(x, y, cmd.w - originX, cmd.h - originY, cmd.color);
+        break;
+      case OP_FILL_RECT:
+        target.fillRect(x, y, cmd.w, cmd.h, cmd.color);
+        break;
+      case OP_CHAR:
+        target.drawChar(x, y, cmd.value, cmd.color, cmd.bg, cmd.arg);
+        break;
+      case OP_FONT_CHAR:
+        target.setTextColor(cmd.color, cmd.bg);
+        target.setTextSize(cmd.arg >> 4);
+        target.drawChar(cmd.value, x, y, cmd.arg & 0x0F);
+        break;
+      case OP_CIRCLE:
+        target.drawCircle(x, y, cmd.w, cmd.color);
+        break;
+      case OP_FILL_CIRCLE:
+        target.fillCircle(x, y, cmd.w, cmd.color);
+        break;
+      case OP_ROUND_RECT:
+        target.drawRoundRect(x, y, cmd.w, cmd.h, cmd.value, cmd.color);
+        break;
+      case OP_FILL_ROUND_RECT:
+        target.fillRoundRect(x, y, cmd.w, cmd.h, cmd.value, cmd.color);
+        break;
+      case OP_SOURCE_IMAGE:
+        if (cmd.arg < imageSourceCount) {
+          imageSources[cmd.arg](target, x, y, cmd.w, cmd.h, cmd.color | ((uint32_t)cmd.bg << 16));
+        }
+        break;
+      case OP_IMAGE: {
+        // Pixels weren't kept - read the visible part back from the panel
+        int32_t ix0 = max(x0, originX), iy0 = max(y0, originY);
+        int32_t ix1 = min(x1, originX + targetW), iy1 = min(y1, originY + targetH);
+        for (int32_t row = iy0; row < iy1; row++) {
+          TFT_eSPI::readRect(ix0, row, ix1 - ix0, 1,
+                             pixels + (row - originY) * targetW + (ix0 - originX));
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void ShadowTFT::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+  if (!isShadowValid()) {
+    TFT_eSPI::readRect(x, y, w, h, data);
+    return;
+  }
+  
+  // Screenshots read the same row size over and over, so the sprite is kept
+  if (!scratch) {
+    scratch = new TFT_eSprite(this);
+    scratch->setColorDepth(16);
+  }
+  if (!scratch->created() || scratch->width() != w || scratch->height() != h) {
+    scratch->deleteSprite();
+    if (!scratch->createSprite(w, h)) {
+      TFT_eSPI::readRect(x, y, w, h, data);
+      return;
+    }
+  }
+  
+  scratch->fillSprite(TFT_BLACK);
+  replay(*scratch, x, y);
+  // 16-bit sprites store pixels in display byte order, same as readRect
+  memcpy(data, scratch->getPointer(), w * h * sizeof(uint16_t));
+}
+
+void ShadowTFT::readPanelRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+  TFT_eSPI::readRect(x, y, w, h, data);
+}
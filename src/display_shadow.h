@@ -0,0 +1,160 @@
+#ifndef DISPLAY_SHADOW_H
+#define DISPLAY_SHADOW_H
+
+#include <TFT_eSPI.h>
+
+// Display shadow
+// ShadowTFT is a drop-in TFT_eSPI that records the primitives drawn to the
+// panel into a bounded display list. readRect() replays the list into an
+// off-screen sprite instead of reading pixels back over SPI, which is slow
+// and only 18-bit on the ILI9488. Only the outermost call of a primitive is
+// recorded (drawString records its glyphs). Circles and rounded rectangles
+// are recorded as one command each rather than as the pixels or spans they
+// are drawn with; called through a plain TFT_eSPI reference they still
+// record their parts.
+//
+// Image pushes can't be replayed without keeping their pixels, so they are
+// recorded as readback regions and read from the panel on replay. Images
+// whose owner can draw them again (cached buttons, menu atlas icons) register
+// an image source instead and record a key; replay asks the source to redraw
+// that key into the target.
+//
+// A full-screen fill clears the list. When the list fills up it is compacted
+// in one pass from newest to oldest, tracking which SHADOW_TILE_SIZE tiles
+// later fillRects cover completely; commands that only touch covered tiles
+// are dropped. If that frees less than an eighth of the list, the shadow is
+// marked stale (logged and counted in getOverflowCount()) and readRect falls
+// back to the panel until the next full-screen fill, so compaction costs at
+// most one linear pass per DISPLAY_SHADOW_COMMANDS / 8 recorded commands.
+//
+// readRect replays into one scratch sprite that is kept between calls, and
+// only the commands whose bounds touch the requested rectangle are drawn.
+//
+// Each recorded primitive is also timed, so getStats()/printStats() show
+// where draw time goes. Define DISPLAY_SHADOW_COMMANDS as 0 to disable.
+//
+// Every draw also marks the SHADOW_TILE_SIZE tiles it touches as dirty, which
+// the screen mirror uses to send only what changed.
+#ifndef DISPLAY_SHADOW_COMMANDS
+#define DISPLAY_SHADOW_COMMANDS 768  // 16 bytes each
+#endif
+#define SHADOW_TILE_SIZE 16
+#define SHADOW_MAX_TILE_ROWS 32      // One uint32_t bitmap per row, so 512px max per side
+#define SHADOW_MAX_IMAGE_SOURCES 4
+
+class ShadowTFT : public TFT_eSPI {
+public:
+  enum Op : uint8_t {
+    OP_NONE,
+    OP_PIXEL,
+    OP_HLINE,
+    OP_VLINE,
+    OP_LINE,
+    OP_FILL_RECT,
+    OP_CHAR,       // GLCD glyph with explicit colours and size
+    OP_FONT_CHAR,  // Glyph from a numbered font using the text colour state
+    OP_IMAGE,      // Pixels pushed from a buffer - replayed by panel readback
+    OP_CIRCLE,     // Centre x/y, radius in w
+    OP_FILL_CIRCLE,
+    OP_ROUND_RECT, // Corner radius in value
+    OP_FILL_ROUND_RECT,
+    OP_SOURCE_IMAGE, // Redrawn by image source 'arg' from the key in color | bg << 16
+    OP_COUNT
+  };
+  
+  // Draws the image recorded under 'key' into target, with its top left at x, y
+  typedef void (*ImageSource)(TFT_eSPI& target, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t key);
+  
+  struct OpStats {
+    uint32_t calls;
+    uint32_t micros;
+  };
+  
+  ShadowTFT(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  
+  // Allocate the display list. Call after init().
+  bool beginShadow();
+  // True if readRect can be served from the display list
+  bool isShadowValid() const { return commands != nullptr && !stale; }
+  uint16_t getCommandCount() const { return commandCount; }
+  // Times the list filled up and the shadow went stale
+  uint32_t getOverflowCount() const { return overflows; }
+  
+  // Record a region written behind TFT_eSPI's back (e.g. TFT_eSprite::pushSprite)
+  void markImage(int32_t x, int32_t y, int32_t w, int32_t h);
+  // Same, for an image 'source' can draw again from 'key' on replay
+  void markImage(int32_t x, int32_t y, int32_t w, int32_t h, int source, uint32_t key);
+  // Returns the id to pass to markImage, or -1 if all slots are taken
+  int addImageSource(ImageSource source);
+  
+  // Dirty tile tracking - bit tx of row ty is set when tile (tx, ty) changed
+  uint32_t getDirtyRow(int tileY) const { return dirtyRows[tileY]; }
+  void clearDirtyTile(int tileX, int tileY) { dirtyRows[tileY] &= ~(1UL << tileX); }
+  void markAllDirty();
+  
+  const OpStats& getStats(Op op) const { return stats[op]; }
+  void resetStats();
+  void printStats();
+  
+  // Recorded primitives - everything else in TFT_eSPI is built from these
+  void drawPixel(int32_t x, int32_t y, uint32_t color) override;
+  void drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) override;
+  void drawLine(int32_t xs, int32_t ys, int32_t xe, int32_t ye, uint32_t color) override;
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) override;
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override;
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  int16_t drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) override;
+  int16_t drawChar(uint16_t uniCode, int32_t x, int32_t y) override;
+  
+  // Not virtual in TFT_eSPI - recorded as single commands when called on tft
+  void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+  void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+  void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color);
+  void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color);
+  
+  using TFT_eSPI::pushImage;
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+#ifdef ESP32_DMA
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr);
+#endif
+  
+  // Served from the display list when valid, otherwise read from the panel.
+  // Pixels are in display byte order, same as TFT_eSPI::readRect.
+  void readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+  void readPanelRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+  
+private:
+  struct Command {
+    Op op;
+    uint8_t arg;      // Char size, or font | (size << 4)
+    int16_t x, y;
+    int16_t w, h;     // End point for OP_LINE
+    uint16_t value;   // Character code
+    uint16_t color;
+    uint16_t bg;
+  };
+  
+  uint32_t beginDraw();
+  bool endDraw(Op op, uint32_t start);
+  void record(Op op, int32_t x, int32_t y, int32_t w, int32_t h,
+              uint16_t color, uint16_t bg = 0, uint16_t value = 0, uint8_t arg = 0);
+  void compact();
+  void replay(TFT_eSprite& target, int32_t originX, int32_t originY);
+  static void getBounds(const Command& cmd, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1);
+  void markDirty(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+  static uint32_t tileMask(int tx0, int tx1);
+  
+  Command* commands;
+  uint16_t commandCount;
+  bool stale;
+  uint32_t overflows;
+  TFT_eSprite* scratch;  // Replay target, recreated only when the read size changes
+  uint8_t depth;
+  OpStats stats[OP_COUNT];
+  uint32_t dirtyRows[SHADOW_MAX_TILE_ROWS];
+  ImageSource imageSources[SHADOW_MAX_IMAGE_SOURCES];
+  uint8_t imageSourceCount;
+};
+
+#endif // DISPLAY_SHADOW_H
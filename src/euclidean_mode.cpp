@@ -6,9 +6,18 @@
 #include "euclidean_mode.h"
 #include "common_definitions.h"
 #include "midi_utils.h"
+#include "param_registry.h"
 
 EuclideanState euclideanState;
 
+// Circular visualization layout - calculated from screen dimensions
+static const int ringCenterX = SCREEN_WIDTH / 3;
+static const int ringCenterY = (SCREEN_HEIGHT - CONTENT_TOP) / 2 + CONTENT_TOP;
+static const int ringRadius = min(SCREEN_WIDTH / 4, (SCREEN_HEIGHT - CONTENT_TOP) / 3);
+static const int ringRadiusStep = ringRadius / 5;
+
+static EuclideanRingGeometry ringGeometry[4];
+
 // Bjorklund's algorithm for generating Euclidean rhythms
 void generateEuclideanPattern(EuclideanVoice& voice) {
   // Clear pattern
@@ -46,9 +55,10 @@ void initializeEuclideanMode() {
   // Voice 3 (Cyan): Percussion - 5/16 (interesting pattern)
   euclideanState.voices[3] = {16, 5, 0, 39, TFT_CYAN, {false}};  // D#1 clap
   
-  // Generate all patterns
+  // Generate all patterns and cache ring positions
   for (int i = 0; i < 4; i++) {
     generateEuclideanPattern(euclideanState.voices[i]);
+    updateEuclideanRingGeometry(i);
   }
   
   euclideanState.bpm = 120;
@@ -57,9 +67,11 @@ void initializeEuclideanMode() {
   euclideanState.lastStepTime = 0;
   euclideanState.selectedVoice = 0;
   euclideanState.tripletMode = false;
+  euclideanState.lastDrawnStep = 0xFF;
   
   Serial.println("Euclidean mode initialized");
   drawEuclideanMode();
+  StepClock::start(EUCLIDEAN, updateEuclideanSequencer);
 }
 
 void drawEuclideanMode() {
@@ -68,79 +80,22 @@ void drawEuclideanMode() {
   // Unified header with BLE, SD, and BPM indicators
   drawModuleHeader("EUCLIDEAN");
   
-  // Draw circular visualization - calculated from screen dimensions
-  int centerX = SCREEN_WIDTH / 3;
-  int centerY = (SCREEN_HEIGHT - CONTENT_TOP) / 2 + CONTENT_TOP;
-  int radius = min(SCREEN_WIDTH / 4, (SCREEN_HEIGHT - CONTENT_TOP) / 3);
-  
   // Draw concentric circles for each voice
-  int radiusStep = radius / 5;
   for (int v = 3; v >= 0; v--) {
-    int r = radius - (v * radiusStep);
-    tft.drawCircle(centerX, centerY, r, euclideanState.voices[v].color);
+    tft.drawCircle(ringCenterX, ringCenterY, ringGeometry[v].radius, euclideanState.voices[v].color);
     
-    // Draw step markers
     for (int s = 0; s < euclideanState.voices[v].steps; s++) {
-      float angle = (s * TWO_PI / euclideanState.voices[v].steps) - HALF_PI;
-      int x = centerX + cos(angle) * r;
-      int y = centerY + sin(angle) * r;
-      
-      if (euclideanState.voices[v].pattern[s]) {
-        // Event marker - filled circle
-        tft.fillCircle(x, y, 4, euclideanState.voices[v].color);
-      } else {
-        // Non-event - small dot
-        tft.drawPixel(x, y, euclideanState.voices[v].color);
-      }
-      
-      // Highlight current step
-      if (euclideanState.isPlaying && s == euclideanState.currentStep) {
-        tft.drawCircle(x, y, 6, TFT_WHITE);
-      }
+      drawEuclideanStepMarker(v, s);
     }
   }
   
-  // Control panel (right side) - calculated from screen dimensions
-  int controlX = SCREEN_WIDTH - 90;
-  int controlY = CONTENT_TOP;
-  int availableHeight = SCREEN_HEIGHT - CONTENT_TOP - 20;
-  int rowHeight = availableHeight / 4;
+  // Highlight current step
+  euclideanState.lastDrawnStep = 0xFF;
+  drawEuclideanStepCursor();
   
+  // Control panel (right side)
   for (int v = 0; v < 4; v++) {
-    int y = controlY + (v * rowHeight);
-    
-    // Voice indicator
-    tft.fillRect(controlX - 15, y + 5, 8, 45, euclideanState.voices[v].color);
-    
-    // Steps control
-    tft.setTextSize(1);
-    tft.setTextColor(THEME_TEXT, THEME_BG);
-    tft.setCursor(controlX, y);
-    tft.print("Steps");
-    tft.fillRoundRect(controlX, y + 12, 35, 20, 3, 
-                      v == euclideanState.selectedVoice ? euclideanState.voices[v].color : THEME_ACCENT);
-    tft.setTextColor(THEME_BG, v == euclideanState.selectedVoice ? euclideanState.voices[v].color : THEME_ACCENT);
-    tft.setCursor(controlX + 8, y + 17);
-    tft.print(euclideanState.voices[v].steps);
-    
-    // Events control
-    tft.setTextColor(THEME_TEXT, THEME_BG);
-    tft.setCursor(controlX, y + 35);
-    tft.print("Events");
-    tft.fillRoundRect(controlX + 40, y + 12, 35, 20, 3, THEME_ACCENT);
-    tft.setTextColor(THEME_BG, THEME_ACCENT);
-    tft.setCursor(controlX + 48, y + 17);
-    tft.print(euclideanState.voices[v].events);
-    
-    // Rotation control
-    tft.setTextColor(THEME_TEXT, THEME_BG);
-    tft.setCursor(controlX + 40, y + 35);
-    tft.print("Rot");
-    tft.fillRoundRect(controlX + 63, y + 35, 25, 17, 3, THEME_ACCENT);
-    tft.setTextColor(THEME_BG, THEME_ACCENT);
-    tft.setCursor(controlX + 67, y + 38);
-    if (euclideanState.voices[v].rotation >= 0) tft.print("+");
-    tft.print(euclideanState.voices[v].rotation);
+    drawEuclideanVoiceControls(v);
   }
   
   // Global controls at bottom
@@ -183,6 +138,125 @@ void drawEuclideanMode() {
   tft.print("Re-Sync");
 }
 
+// One voice's row in the control panel (right side) - calculated from screen dimensions
+void drawEuclideanVoiceControls(uint8_t v) {
+  int controlX = SCREEN_WIDTH - 90;
+  int controlY = CONTENT_TOP;
+  int availableHeight = SCREEN_HEIGHT - CONTENT_TOP - 20;
+  int rowHeight = availableHeight / 4;
+  int y = controlY + (v * rowHeight);
+  
+  // Voice indicator
+  tft.fillRect(controlX - 15, y + 5, 8, 45, euclideanState.voices[v].color);
+  
+  // Steps control
+  tft.setTextSize(1);
+  tft.setTextColor(THEME_TEXT, THEME_BG);
+  tft.setCursor(controlX, y);
+  tft.print("Steps");
+  tft.fillRoundRect(controlX, y + 12, 35, 20, 3, 
+                    v == euclideanState.selectedVoice ? euclideanState.voices[v].color : THEME_ACCENT);
+  tft.setTextColor(THEME_BG, v == euclideanState.selectedVoice ? euclideanState.voices[v].color : THEME_ACCENT);
+  tft.setCursor(controlX + 8, y + 17);
+  tft.print(euclideanState.voices[v].steps);
+  
+  // Events control
+  tft.setTextColor(THEME_TEXT, THEME_BG);
+  tft.setCursor(controlX, y + 35);
+  tft.print("Events");
+  tft.fillRoundRect(controlX + 40, y + 12, 35, 20, 3, THEME_ACCENT);
+  tft.setTextColor(THEME_BG, THEME_ACCENT);
+  tft.setCursor(controlX + 48, y + 17);
+  tft.print(euclideanState.voices[v].events);
+  
+  // Rotation control
+  tft.setTextColor(THEME_TEXT, THEME_BG);
+  tft.setCursor(controlX + 40, y + 35);
+  tft.print("Rot");
+  tft.fillRoundRect(controlX + 63, y + 35, 25, 17, 3, THEME_ACCENT);
+  tft.setTextColor(THEME_BG, THEME_ACCENT);
+  tft.setCursor(controlX + 67, y + 38);
+  if (euclideanState.voices[v].rotation >= 0) tft.print("+");
+  tft.print(euclideanState.voices[v].rotation);
+}
+
+// Repaint one ring and its controls after its pattern changed (same step
+// count, so the ring geometry and the cursor position still hold)
+void drawEuclideanVoice(uint8_t voice) {
+  const EuclideanVoice& v = euclideanState.voices[voice];
+  const EuclideanRingGeometry& ring = ringGeometry[voice];
+  
+  for (int s = 0; s < v.steps; s++) {
+    tft.fillCircle(ring.stepX[s], ring.stepY[s], 4, THEME_BG);
+  }
+  tft.drawCircle(ringCenterX, ringCenterY, ring.radius, v.color);
+  for (int s = 0; s < v.steps; s++) {
+    drawEuclideanStepMarker(voice, s);
+  }
+  
+  uint8_t cursor = euclideanState.lastDrawnStep;
+  if (cursor < v.steps) {
+    tft.drawCircle(ring.stepX[cursor], ring.stepY[cursor], 6, TFT_WHITE);
+  }
+  
+  drawEuclideanVoiceControls(voice);
+}
+
+// Rebuild the step -> x/y lookup for one ring (call after its step count changes)
+void updateEuclideanRingGeometry(uint8_t voice) {
+  EuclideanRingGeometry& ring = ringGeometry[voice];
+  uint8_t steps = euclideanState.voices[voice].steps;
+  
+  ring.radius = ringRadius - (voice * ringRadiusStep);
+  for (int s = 0; s < steps; s++) {
+    float angle = (s * TWO_PI / steps) - HALF_PI;
+    ring.stepX[s] = ringCenterX + cos(angle) * ring.radius;
+    ring.stepY[s] = ringCenterY + sin(angle) * ring.radius;
+  }
+}
+
+void drawEuclideanStepMarker(uint8_t voice, uint8_t step) {
+  const EuclideanVoice& v = euclideanState.voices[voice];
+  int x = ringGeometry[voice].stepX[step];
+  int y = ringGeometry[voice].stepY[step];
+  
+  if (v.pattern[step]) {
+    // Event marker - filled circle
+    tft.fillCircle(x, y, 4, v.color);
+  } else {
+    // Non-event - small dot
+    tft.drawPixel(x, y, v.color);
+  }
+}
+
+// Move the playhead highlight without repainting the whole screen.
+// Only the previous and current marker on each ring are touched.
+void drawEuclideanStepCursor() {
+  uint8_t prevStep = euclideanState.lastDrawnStep;
+  uint8_t step = euclideanState.isPlaying ? euclideanState.currentStep : 0xFF;
+  if (prevStep == step) return;
+  
+  for (int v = 0; v < 4; v++) {
+    const EuclideanVoice& voice = euclideanState.voices[v];
+    const EuclideanRingGeometry& ring = ringGeometry[v];
+    
+    // Erase old highlight, then repair the ring and markers it overlapped
+    if (prevStep < voice.steps) {
+      tft.drawCircle(ring.stepX[prevStep], ring.stepY[prevStep], 6, THEME_BG);
+      tft.drawCircle(ringCenterX, ringCenterY, ring.radius, voice.color);
+      drawEuclideanStepMarker(v, (prevStep + voice.steps - 1) % voice.steps);
+      drawEuclideanStepMarker(v, prevStep);
+      drawEuclideanStepMarker(v, (prevStep + 1) % voice.steps);
+    }
+    
+    if (step < voice.steps) {
+      tft.drawCircle(ring.stepX[step], ring.stepY[step], 6, TFT_WHITE);
+    }
+  }
+  
+  euclideanState.lastDrawnStep = step;
+}
+
 void playEuclideanStep() {
   // Play all voices that have events at current step
   for (int v = 0; v < 4; v++) {
@@ -209,8 +283,14 @@ void updateEuclideanSequencer() {
   
   unsigned long currentTime = millis();
   if (currentTime - euclideanState.lastStepTime >= stepDuration) {
-    euclideanState.lastStepTime = currentTime;
+    // Advance by whole steps so clock jitter doesn't accumulate as tempo drift,
+    // but resync if we fell more than a step behind
+    euclideanState.lastStepTime += stepDuration;
+    if (currentTime - euclideanState.lastStepTime >= stepDuration) {
+      euclideanState.lastStepTime = currentTime;
+    }
     
+    ParamRegistry::applyTick(EUCLIDEAN);
     playEuclideanStep();
     
     // Advance to next step (use max steps from all voices)
@@ -224,9 +304,6 @@ void updateEuclideanSequencer() {
     if (euclideanState.currentStep >= maxSteps) {
       euclideanState.currentStep = 0;
     }
-    
-    // Update display (just the step markers)
-    drawEuclideanMode();
   }
 }
 
@@ -238,11 +315,13 @@ void handleEuclideanMode() {
     
     // Play/Stop button
     if (touchX >= 10 && touchX <= 80 && touchY >= 280 && touchY <= 315) {
+      StepClock::lock();
       euclideanState.isPlaying = !euclideanState.isPlaying;
       if (euclideanState.isPlaying) {
         euclideanState.currentStep = 0;
         euclideanState.lastStepTime = millis();
       }
+      StepClock::unlock();
       drawEuclideanMode();
     }
     
@@ -261,8 +340,10 @@ void handleEuclideanMode() {
     
     // Re-Sync button
     else if (touchX >= 250 && touchX <= 320 && touchY >= 280 && touchY <= 315) {
+      StepClock::lock();
       euclideanState.currentStep = 0;
       euclideanState.lastStepTime = millis();
+      StepClock::unlock();
       drawEuclideanMode();
     }
     
@@ -277,43 +358,100 @@ void handleEuclideanMode() {
       // Steps control
       if (touchX >= controlX && touchX <= controlX + 35 && touchY >= y + 12 && touchY <= y + 32) {
         euclideanState.selectedVoice = v;
+        StepClock::lock();
         euclideanState.voices[v].steps++;
         if (euclideanState.voices[v].steps > 32) euclideanState.voices[v].steps = 1;
         if (euclideanState.voices[v].events > euclideanState.voices[v].steps) {
           euclideanState.voices[v].events = euclideanState.voices[v].steps;
         }
         generateEuclideanPattern(euclideanState.voices[v]);
+        StepClock::unlock();
+        updateEuclideanRingGeometry(v);
         drawEuclideanMode();
       }
       
       // Events control
       else if (touchX >= controlX + 40 && touchX <= controlX + 75 && touchY >= y + 12 && touchY <= y + 32) {
+        StepClock::lock();
         euclideanState.voices[v].events++;
         if (euclideanState.voices[v].events > euclideanState.voices[v].steps) {
           euclideanState.voices[v].events = 0;
         }
         generateEuclideanPattern(euclideanState.voices[v]);
+        StepClock::unlock();
         drawEuclideanMode();
       }
       
       // Rotation control
       else if (touchX >= controlX + 63 && touchX <= controlX + 88 && touchY >= y + 35 && touchY <= y + 52) {
+        StepClock::lock();
         euclideanState.voices[v].rotation++;
         if (euclideanState.voices[v].rotation > euclideanState.voices[v].steps) {
           euclideanState.voices[v].rotation = -euclideanState.voices[v].steps;
         }
         generateEuclideanPattern(euclideanState.voices[v]);
+        StepClock::unlock();
         drawEuclideanMode();
       }
     }
     
     // Back button
     if (isButtonPressed(BACK_BTN_X, BACK_BTN_Y, BTN_BACK_W, BTN_BACK_H)) {
+      StepClock::stop();
       currentMode = MENU;
       return;
     }
   }
   
-  // Update sequencer if playing
-  updateEuclideanSequencer();
+  // Steps run on the step clock; follow them with the cursor
+  drawEuclideanStepCursor();
+}
+
+// Remote parameters, per voice. The registry takes plain function pointers,
+// so each voice gets its own instantiation. Values are limited to the voice's
+// current step count, as on screen.
+template <int V> static int16_t getVoiceEvents() { return euclideanState.voices[V].events; }
+template <int V> static int16_t getVoiceRotation() { return euclideanState.voices[V].rotation; }
+
+template <int V> static void setVoiceEvents(int16_t value) {
+  EuclideanVoice& voice = euclideanState.voices[V];
+  voice.events = min<int16_t>(value, voice.steps);
+  generateEuclideanPattern(voice);
+}
+
+template <int V> static void setVoiceRotation(int16_t value) {
+  EuclideanVoice& voice = euclideanState.voices[V];
+  voice.rotation = constrain(value, -voice.steps, voice.steps);
+  generateEuclideanPattern(voice);
+}
+
+template <int V> static void refreshVoice() { drawEuclideanVoice(V); }
+
+template <int V> static void publishVoiceParams() {
+  static const char* eventNames[] = {"euclid.1.events", "euclid.2.events", "euclid.3.events", "euclid.4.events"};
+  static const char* rotationNames[] = {"euclid.1.rotation", "euclid.2.rotation", "euclid.3.rotation", "euclid.4.rotation"};
+  ParamRegistry::add(eventNames[V], EUCLIDEAN, 0, 32, true,
+                     getVoiceEvents<V>, setVoiceEvents<V>, refreshVoice<V>);
+  ParamRegistry::add(rotationNames[V], EUCLIDEAN, -32, 32, true,
+                     getVoiceRotation<V>, setVoiceRotation<V>, refreshVoice<V>);
+}
+
+void publishEuclideanParams() {
+  ParamRegistry::add("euclid.playing", EUCLIDEAN, 0, 1, false,
+    []() -> int16_t { return euclideanState.isPlaying; },
+    [](int16_t v) {
+      if (euclideanState.isPlaying == (bool)v) return;
+      euclideanState.isPlaying = v;
+      if (euclideanState.isPlaying) {
+        euclideanState.currentStep = 0;
+        euclideanState.lastStepTime = millis();
+      }
+    }, drawEuclideanMode);
+  ParamRegistry::add("euclid.bpm", EUCLIDEAN, 40, 240, false,
+    []() -> int16_t { return (int16_t)euclideanState.bpm; },
+    [](int16_t v) { euclideanState.bpm = v; }, drawEuclideanMode);
+  publishVoiceParams<0>();
+  publishVoiceParams<1>();
+  publishVoiceParams<2>();
+  publishVoiceParams<3>();
 }
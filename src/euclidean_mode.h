@@ -24,6 +24,15 @@ struct EuclideanState {
   unsigned long lastStepTime; // For timing
   uint8_t selectedVoice;     // Currently selected voice for editing (0-3)
   bool tripletMode;          // false = 16th notes, true = triplet divisions
+  uint8_t lastDrawnStep;     // Step currently highlighted on screen (0xFF = none)
+};
+
+// Cached ring geometry (step index -> screen position)
+// Rebuilt whenever a voice's step count changes so per-step redraws skip the trig
+struct EuclideanRingGeometry {
+  int16_t radius;
+  int16_t stepX[32];
+  int16_t stepY[32];
 };
 
 extern EuclideanState euclideanState;
@@ -36,8 +45,16 @@ void handleEuclideanMode();
 // Pattern generation using Bjorklund's algorithm
 void generateEuclideanPattern(EuclideanVoice& voice);
 
-// Playback
+// Ring geometry cache and incremental step cursor
+void updateEuclideanRingGeometry(uint8_t voice);
+void drawEuclideanStepMarker(uint8_t voice, uint8_t step);
+void drawEuclideanStepCursor();
+void drawEuclideanVoice(uint8_t voice);
+void drawEuclideanVoiceControls(uint8_t voice);
+
+// Playback (updateEuclideanSequencer is the step clock tick)
 void updateEuclideanSequencer();
 void playEuclideanStep();
+void publishEuclideanParams();
 
 #endif // EUCLIDEAN_MODE_H
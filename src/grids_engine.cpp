@@ -0,0 +1,195 @@
+#include "grids_engine.h"
+
+// Node levels, [node][voice][step], nodes row by row (node = y * 5 + x).
+// The corners are the styles labelled on the pad: house (0, 0), funk (4, 0),
+// techno (0, 4) and hip-hop (4, 4). Nodes between them blend those styles and
+// add syncopations of their own, and the second bar carries the fills. Main
+// hits sit near 255; ghost notes follow the beat hierarchy (downbeats, then
+// 8ths, then 16ths) so density brings them in in a musical order.
+static const uint8_t NODES[GRIDS_MAP_SIZE * GRIDS_MAP_SIZE][GRIDS_VOICES][GRIDS_STEPS] = {
+  {  // Node 0 (0, 0)
+    {255,  14,  32,  14, 235,  14,  32,  14, 255,  14,  32,  14, 235,  14,  32,  14, 255,  14,  32,  14, 235,  14,  32,  14, 255,  14,  32,  14, 235,  14,  32,  14},
+    { 40,   8,  18,   8, 255,   8,  18,   8,  40,   8,  18,   8, 255,   8,  18,   8,  40,   8,  18,   8, 255,   8,  18,   8,  40,   8,  18,   8, 255,  27,  31,  31},
+    {150,  30, 230,  30, 112,  30, 230,  30, 150,  30, 230,  30, 112,  30, 230,  30, 150,  30, 230,  30, 112,  30, 230,  30, 150,  30, 230,  30, 112,  30, 230,  30}
+  },
+  {  // Node 1 (1, 0)
+    {255,  14, 148,  68, 191,  14,  33,  14, 249,  14, 148,  14, 191,  14,  33,  14, 255,  14, 118,  68, 191,  14,  33,  14, 249,  14, 118,  14, 191,  14,  33,  14},
+    { 52, 167,  24,  10, 255,  10,  24,  56,  52,  10,  24,  10, 255,  10,  24,  56,  52, 134,  24,  10, 255,  10,  24,  56,  52,  10,  24,  10, 255,  48,  55,  56},
+    {176,  60, 210,  60, 148,  60, 210,  60, 176, 110, 210,  60, 148,  60, 210,  60, 176,  60, 210,  60, 148,  60, 210,  60, 176,  88, 210,  60, 148,  60, 210,  60}
+  },
+  {  // Node 2 (2, 0)
+    {255,  15,  34, 122, 148,  15,  34, 147, 242,  15, 131,  15, 148,  15,  34, 147, 255,  15,  34, 122, 148,  15,  34, 118, 242,  15, 131,  15, 148,  15,  34, 118},
+    { 65,  13,  29,  13, 255,  13,  29, 104,  65,  13,  29,  13, 255,  13,  29, 128,  65,  13,  29,  13, 255,  13,  29, 104,  65,  13,  29,  13, 255,  68,  78, 104},
+    {202,  90, 190,  90, 184,  90, 190, 179, 202,  90, 190,  90, 184, 179, 190,  90, 202,  90, 190,  90, 184,  90, 190, 143, 202,  90, 190,  90, 184, 143, 190,  90}
+  },
+  {  // Node 3 (3, 0)
+    {255,  16,  35, 176, 104,  16,  35,  16, 236,  16, 180, 170, 104,  16,  35,  16, 255,  16,  35, 176, 104,  16,  35,  16, 236,  16, 180, 136, 104,  16, 135,  16},
+    { 78,  16,  35, 119, 255,  16,  35, 152,  78,  16,  35, 119, 255,  16,  35, 152,  78,  16,  35,  95, 255,  16,  35, 152,  78,  16,  35,  95, 255,  88, 101, 152},
+    {229, 120, 170, 138, 219, 120, 170, 138, 229, 120, 170, 120, 219, 120, 170, 120, 229, 120, 170, 120, 219, 120, 170, 120, 229, 120, 170, 120, 219, 120, 170, 120}
+  },
+  {  // Node 4 (4, 0)
+    {255,  16,  36, 230,  60,  16,  36,  16, 230,  16, 230,  16,  60,  16,  36,  16, 255,  16,  36, 230,  60,  16,  36,  16, 230,  16, 230,  16,  60,  16, 150,  16},
+    { 90,  18,  40,  18, 255,  18,  40, 200,  90,  18,  40,  18, 255,  18,  40, 200,  90,  18,  40,  18, 255,  18,  40, 200,  90,  18,  40,  18, 255, 109, 125, 200},
+    {255, 150, 150, 150, 255, 150, 150, 150, 255, 150, 150, 150, 255, 150, 150, 150, 255, 150, 150, 150, 255, 150, 150, 150, 255, 150, 150, 150, 255, 150, 150, 150}
+  },
+  {  // Node 5 (0, 1)
+    {255,  14,  30,  14, 232, 114,  30,  14, 255,  14,  30,  14, 232, 114,  80,  14, 255,  14,  30,  14, 232,  91,  30,  14, 255,  14,  30,  14, 232,  91,  80,  14},
+    { 42,   8,  19,   8, 201,   8,  19,   8,  42,   8, 133,   8, 255,   8,  19,   8,  42,   8,  19,   8, 201,   8,  19,   8,  42,   8, 106,   8, 255,  48,  55,  55},
+    {142, 152, 236,  70, 107,  28, 220,  28, 142,  28, 236,  70, 107,  28, 220,  28, 142, 122, 236,  70, 107,  28, 220,  28, 142,  28, 236,  70, 107,  28, 220,  28}
+  },
+  {  // Node 6 (1, 1)
+    {255,  14,  31,  54, 188,  14,  31, 161, 238,  14,  81,  14, 188,  14,  68, 161, 255,  14,  31,  54, 188,  14,  31, 129, 238,  14,  81,  14, 188,  14,  68, 129},
+    { 52,  10,  24,  10, 214,  10,  24,  45,  52,  10,  24,  10, 255,  10,  24, 142,  52,  10,  24,  10, 214,  10,  24,  45,  52,  10,  24,  10, 255,  68,  78, 114},
+    {171,  51, 216,  82, 139,  51, 204, 123, 171,  51, 216,  82, 139, 123, 204,  51, 171,  51, 216,  82, 139,  51, 204,  98, 171,  51, 216,  82, 139,  98, 204,  51}
+  },
+  {  // Node 7 (2, 1)
+    {255,  14, 138,  94, 144,  14,  32,  42, 221,  14, 138,  14, 144,  14,  57,  14, 255,  14, 110,  94, 144,  14,  32,  42, 221,  14, 131,  14, 144,  14, 135,  14},
+    { 62, 157,  28,  12, 228,  12,  28,  81,  62,  12,  28,  12, 255,  12,  28,  81,  62, 126,  28,  12, 228,  12,  28,  81,  62,  12,  28,  12, 255,  88, 101, 101},
+    {199,  73, 196,  94, 170,  73, 188,  73, 199, 170, 196,  94, 170,  73, 188,  73, 199,  73, 196,  94, 170,  73, 188,  73, 199, 136, 196,  94, 170,  73, 188,  73}
+  },
+  {  // Node 8 (3, 1)
+    {255,  15,  33, 135, 100,  15,  33,  56, 204,  15, 181,  15, 100,  15, 115,  15, 255,  15,  33, 135, 100,  15,  33,  56, 204,  15, 181,  15, 100,  15, 150,  15},
+    { 72,  14,  33,  14, 241,  14,  33, 166,  72,  14,  33,  14, 255,  14,  33, 117,  72,  14,  33,  14, 241,  14,  33, 133,  72,  14,  33,  14, 255, 109, 125, 125},
+    {227,  96, 175, 106, 202, 153, 171,  96, 227,  96, 175, 106, 202,  96, 171,  96, 227,  96, 175, 106, 202, 122, 171,  96, 227,  96, 175, 106, 202,  96, 171,  96}
+  },
+  {  // Node 9 (4, 1)
+    {255,  15,  34, 176,  56,  15,  34,  71, 188,  15, 231, 112,  56,  15,  34,  15, 255,  15,  34, 176,  56,  15,  34,  71, 188,  15, 231,  90,  56,  15, 165,  15},
+    { 82,  16,  37, 131, 255,  16,  37, 153,  82,  16,  37, 131, 255,  16,  37, 153,  82,  16,  37, 105, 255,  16,  37, 153,  82,  16,  37, 105, 255, 129, 148, 153},
+    {255, 118, 155, 150, 234, 118, 155, 150, 255, 118, 155, 118, 234, 118, 155, 118, 255, 118, 155, 120, 234, 118, 155, 120, 255, 118, 155, 118, 234, 118, 155, 118}
+  },
+  {  // Node 10 (0, 2)
+    {255,  13,  29,  13, 230,  13,  29, 147, 255,  13,  29,  13, 230,  13, 128, 147, 255,  13,  29,  13, 230,  13,  29, 118, 255,  13,  29,  13, 230,  13, 128, 118},
+    { 45,   9,  20,   9, 146,   9,  20,   9,  45,   9,  20,   9, 255,   9,  20, 128,  45,   9,  20,   9, 146,   9,  20,   9,  45,   9,  20,   9, 255,  68,  78, 102},
+    {135,  27, 242, 110, 101,  27, 210, 179, 135,  27, 242, 110, 101, 179, 210,  27, 135,  27, 242, 110, 101,  27, 210, 143, 135,  27, 242, 110, 101, 143, 210,  27}
+  },
+  {  // Node 11 (1, 2)
+    {255,  13,  30,  40, 186, 170,  30,  41, 228,  13,  80,  13, 186, 170, 104,  13, 255,  13,  30,  40, 186, 136,  30,  41, 228,  13,  80,  13, 186, 136, 135,  13},
+    { 52,  10,  24,  10, 173,  10,  24,  33,  52,  10, 119,  10, 255,  10,  24,  33,  52,  10,  24,  10, 173,  10,  24,  33,  52,  10,  95,  10, 255,  88, 101, 101},
+    {165, 138, 222, 104, 129,  42, 198,  42, 165,  42, 222, 104, 129,  42, 198,  42, 165, 110, 222, 104, 129,  42, 198,  42, 165,  42, 222, 104, 129,  42, 198,  42}
+  },
+  {  // Node 12 (2, 2)
+    {255,  14,  30,  67, 141,  14,  30,  69, 200, 125, 131,  14, 141,  14,  80,  14, 255,  14,  30,  67, 141,  14,  30,  69, 200, 100, 131,  14, 141,  14, 150,  14},
+    { 60,  12,  27,  12, 201,  12, 176,  58,  60,  12,  27,  12, 255,  12, 176,  58,  60,  12,  27,  12, 201,  12, 141,  58,  60,  12,  27,  12, 255, 109, 141, 125},
+    {195,  56, 201,  98, 157,  56, 185,  56, 195,  56, 201, 163, 157,  56, 185, 163, 195,  56, 201,  98, 157,  56, 185,  56, 195,  56, 201, 130, 157,  56, 185, 130}
+  },
+  {  // Node 13 (3, 2)
+    {255,  14,  31, 124,  97,  14,  31,  97, 172,  14, 182,  14,  97,  14,  56,  14, 255,  14,  31,  99,  97,  14,  31,  97, 172,  14, 182,  14,  97,  14, 165,  14},
+    { 68,  14, 143,  14, 228,  14,  30,  82,  68,  14,  30,  14, 255,  14,  30,  82,  68,  14, 114,  14, 228,  14,  30,  82,  68,  14,  30,  14, 255, 129, 148, 148},
+    {225, 156, 181,  92, 185,  71, 172,  71, 225, 156, 181,  92, 185,  71, 172,  71, 225, 125, 181,  92, 185,  71, 172,  71, 225, 125, 181,  92, 185,  71, 172,  71}
+  },
+  {  // Node 14 (4, 2)
+    {255,  14,  32, 121,  52,  14, 169, 126, 145,  14, 232,  14,  52,  14,  32,  14, 255,  14,  32, 121,  52,  14, 135, 126, 145,  14, 232,  14,  52,  14, 180,  14},
+    { 75,  15,  34,  15, 255,  15,  34, 106,  75, 150,  34,  15, 255, 150,  34, 106,  75,  15,  34,  15, 255,  15,  34, 106,  75, 120,  34,  15, 255, 150, 172, 172},
+    {255,  86, 160,  86, 212,  86, 160,  86, 255,  86, 160,  86, 212, 131, 160,  86, 255,  86, 160,  86, 212,  86, 160,  86, 255,  86, 160,  86, 212, 105, 160,  86}
+  },
+  {  // Node 15 (0, 3)
+    {255,  12, 136,  12, 228,  12,  28,  12, 255,  12, 136,  12, 228,  12, 177,  12, 255,  12, 109,  12, 228,  12,  28,  12, 255,  12, 109,  12, 228,  12, 177,  12},
+    { 48, 155,  21,  10,  92,  10,  21,  10,  48,  10,  21,  10, 255,  10,  21,  10,  48, 124,  21,  10,  92,  10,  21,  10,  48,  10,  21,  10, 255,  88, 101, 101},
+    {128,  26, 249, 150,  96,  26, 200,  26, 128, 168, 249, 150,  96,  26, 200,  26, 128,  26, 249, 150,  96,  26, 200,  26, 128, 134, 249, 150,  96,  26, 200,  26}
+  },
+  {  // Node 16 (1, 3)
+    {255,  13,  28,  26, 183,  13,  28,  54, 217, 113,  80,  13, 183,  13, 140,  13, 255,  13,  28,  26, 183,  13,  28,  54, 217,  90,  80,  13, 183,  13, 150,  13},
+    { 52,  10,  24,  10, 133,  10, 164,  22,  52,  10,  24,  10, 255,  10, 164,  22,  52,  10,  24,  10, 133,  10, 131,  22,  52,  10,  24,  10, 255, 109, 131, 125},
+    {159,  33, 228, 126, 120,  33, 191,  33, 159,  33, 228, 151, 120,  33, 191, 151, 159,  33, 228, 126, 120,  33, 191,  33, 159,  33, 228, 126, 120,  33, 191, 121}
+  },
+  {  // Node 17 (2, 3)
+    {255,  13,  29,  40, 138, 112,  29,  96, 179,  13, 131,  13, 138, 112, 103,  13, 255,  13,  29,  40, 138,  90,  29,  96, 179,  13, 131,  13, 138,  90, 165,  13},
+    { 58,  12,  26,  12, 173,  12,  26,  34,  58,  12, 131,  12, 255,  12,  26,  34,  58,  12,  26,  12, 173,  12,  26,  34,  58,  12, 105,  12, 255, 129, 148, 148},
+    {191, 150, 207, 102, 143,  40, 182,  40, 191,  40, 207, 102, 143,  40, 182,  40, 191, 120, 207, 102, 143,  40, 182,  40, 191,  40, 207, 102, 143,  40, 182,  40}
+  },
+  {  // Node 18 (3, 3)
+    {255,  13,  29,  53,  93,  13, 159, 138, 141,  13, 182,  13,  93,  13,  66,  13, 255,  13,  29,  53,  93,  13, 127, 138, 141,  13, 182,  13,  93,  13, 180,  13},
+    { 62,  12,  28,  12, 214,  12,  28,  47,  62, 140,  28,  12, 255, 140,  28,  47,  62,  12,  28,  12, 214,  12,  28,  47,  62, 112,  28,  12, 255, 150, 172, 172},
+    {223,  47, 186,  78, 167,  47, 174,  47, 223,  47, 186,  78, 167, 121, 174,  47, 223,  47, 186,  78, 167,  47, 174,  47, 223,  47, 186,  78, 167,  97, 174,  47}
+  },
+  {  // Node 19 (4, 3)
+    {255,  13,  29, 138,  49,  13,  29, 180, 102,  13, 234,  13,  49,  13,  29,  13, 255,  13,  29, 110,  49,  13,  29, 180, 102,  13, 234,  13,  49,  13, 195,  13},
+    { 68,  14, 157,  14, 255,  14,  30,  59,  68,  14,  30,  14, 255,  14,  30,  59,  68,  14, 126,  14, 255,  14,  30,  59,  68,  14,  30,  14, 255, 170, 195, 195},
+    {255, 170, 165,  54, 191,  54, 165,  54, 255, 170, 165,  54, 191,  54, 165,  54, 255, 136, 165,  54, 191,  54, 165,  54, 255, 136, 165,  54, 191,  54, 165,  54}
+  },
+  {  // Node 20 (0, 4)
+    {255,  12,  27,  12, 225,  12,  27,  12, 255,  12,  27,  12, 225,  12, 225,  12, 255,  12,  27,  12, 225,  12,  27,  12, 255,  12,  27,  12, 225,  12, 225,  12},
+    { 50,  10,  22,  10,  38,  10,  22,  10,  50,  10,  22,  10, 255,  10,  22,  10,  50,  10,  22,  10,  38,  10,  22,  10,  50,  10,  22,  10, 255, 109, 125, 125},
+    {120,  24, 255, 190,  90,  24, 190,  24, 120,  24, 255, 190,  90,  24, 190,  24, 120,  24, 255, 190,  90,  24, 190,  24, 120,  24, 255, 190,  90,  24, 190,  24}
+  },
+  {  // Node 21 (1, 4)
+    {255,  12,  27, 150, 180,  12,  27,  68, 206,  12,  79,  12, 180,  12, 176,  12, 255,  12,  27, 120, 180,  12,  27,  68, 206,  12,  79,  12, 180,  12, 176,  12},
+    { 52,  10, 169,  10,  92,  10,  24,  10,  52,  10,  24,  10, 255,  10,  24,  10,  52,  10, 135,  10,  92,  10,  24,  10,  52,  10,  24,  10, 255, 129, 148, 148},
+    {154, 112, 234, 148, 110,  24, 185,  24, 154, 112, 234, 148, 110,  24, 185,  24, 154,  90, 234, 148, 110,  24, 185,  24, 154,  90, 234, 148, 110,  24, 185,  24}
+  },
+  {  // Node 22 (2, 4)
+    {255,  12,  27,  12, 135,  12, 173, 124, 158,  12, 131,  12, 135,  12, 126,  12, 255,  12,  27,  12, 135,  12, 138, 124, 158,  12, 131,  12, 135,  12, 180,  12},
+    { 55,  11,  25,  11, 146,  11,  25,  11,  55, 154,  25,  11, 255, 154,  25,  11,  55,  11,  25,  11, 146,  11,  25,  11,  55, 123,  25,  11, 255, 150, 172, 172},
+    {188,  23, 212, 106, 130,  23, 180,  23, 188,  23, 212, 106, 130, 135, 180,  23, 188,  23, 212, 106, 130,  23, 180,  23, 188,  23, 212, 106, 130, 108, 180,  23}
+  },
+  {  // Node 23 (3, 4)
+    {255,  12,  27,  12,  90, 172,  27, 179, 109,  12, 183,  12,  90, 172,  76,  12, 255,  12,  27,  12,  90, 138,  27, 179, 109,  12, 183,  12,  90, 138, 195,  12},
+    { 58,  12,  26,  12, 201,  12,  26,  12,  58,  12, 121,  12, 255,  12,  26,  12,  58,  12,  26,  12, 201,  12,  26,  12,  58,  12,  97,  12, 255, 170, 195, 195},
+    {221, 140, 191,  64, 150,  22, 175,  22, 221,  22, 191,  64, 150,  22, 175,  22, 221, 112, 191,  64, 150,  22, 175,  22, 221,  22, 191,  64, 150,  22, 175,  22}
+  },
+  {  // Node 24 (4, 4)
+    {255,  12,  27,  12,  45,  12,  27, 235,  60,  12, 235,  12,  45,  12,  27,  12, 255,  12,  27,  12,  45,  12,  27, 235,  60,  12, 235,  12,  45,  12, 210,  12},
+    { 60,  12,  27,  12, 255,  12,  27,  12,  60,  12,  27,  12, 255,  12,  27,  12,  60,  12,  27,  12, 255,  12,  27,  12,  60,  12,  27,  12, 255, 190, 218, 218},
+    {255,  22, 170,  22, 170,  22, 170,  22, 255,  22, 170,  22, 170,  22, 170,  22, 255,  22, 170,  22, 170,  22, 170,  22, 255,  22, 170,  22, 170,  22, 170,  22}
+  }
+};
+
+// Grids' U8Mix: balance 0 gives a, 255 gives (nearly) b
+static uint8_t mix(uint8_t a, uint8_t b, uint8_t balance) {
+  return (a * (255 - balance) + b * balance) >> 8;
+}
+
+GridsEngine::GridsEngine(uint32_t seed) {
+  this->seed(seed);
+}
+
+void GridsEngine::seed(uint32_t value) {
+  rng = value ? value : 1;  // xorshift never leaves 0
+  for (int i = 0; i < GRIDS_VOICES; i++) perturbation[i] = 0;
+}
+
+uint8_t GridsEngine::randomByte() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng >> 24;
+}
+
+uint8_t GridsEngine::level(uint8_t voice, uint8_t step, uint8_t x, uint8_t y) {
+  // Four nodes around (x, y), then the position within that cell as 0-252
+  uint8_t i = x >> 6;
+  uint8_t j = y >> 6;
+  uint8_t fx = (x & 63) << 2;
+  uint8_t fy = (y & 63) << 2;
+  step %= GRIDS_STEPS;
+  
+  uint8_t a = NODES[j * GRIDS_MAP_SIZE + i][voice][step];
+  uint8_t b = NODES[j * GRIDS_MAP_SIZE + i + 1][voice][step];
+  uint8_t c = NODES[(j + 1) * GRIDS_MAP_SIZE + i][voice][step];
+  uint8_t d = NODES[(j + 1) * GRIDS_MAP_SIZE + i + 1][voice][step];
+  return mix(mix(a, b, fx), mix(c, d, fx), fy);
+}
+
+uint8_t GridsEngine::nodeLevel(uint8_t voice, uint8_t step, uint8_t nodeX, uint8_t nodeY) {
+  return NODES[nodeY * GRIDS_MAP_SIZE + nodeX][voice][step % GRIDS_STEPS];
+}
+
+GridsHits GridsEngine::evaluate(uint8_t step, uint8_t x, uint8_t y,
+                                const uint8_t density[GRIDS_VOICES], uint8_t chaos) {
+  // Each pattern cycle gets its own push per voice, up to a quarter of the range
+  if (step % GRIDS_STEPS == 0) {
+    uint8_t randomness = chaos >> 2;
+    for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+      perturbation[voice] = (randomByte() * randomness) >> 8;
+    }
+  }
+  
+  GridsHits hits;
+  for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+    uint8_t value = level(voice, step, x, y);
+    value = (value < 255 - perturbation[voice]) ? value + perturbation[voice] : 255;
+    hits.level[voice] = value;
+    hits.trigger[voice] = value > (uint8_t)~density[voice];
+  }
+  return hits;
+}
@@ -0,0 +1,48 @@
+#ifndef GRIDS_ENGINE_H
+#define GRIDS_ENGINE_H
+
+#include <stdint.h>
+
+// Grids drum map engine, after Mutable Instruments Grids
+// A 5x5 map of nodes, each holding a 32-step level (0-255) per voice. A map
+// position (x, y) falls between four nodes 64 units apart; a step's level is
+// the fixed-point bilinear mix of those four. A voice fires when its level,
+// plus this pattern's random perturbation ("chaos"), is above 255 - density,
+// so raising the density brings in the strongest steps first.
+//
+// Only the step being played is evaluated, so the cost per tick is the same
+// however often the position changes.
+#define GRIDS_STEPS       32
+#define GRIDS_VOICES      3   // Kick, snare, hat
+#define GRIDS_MAP_SIZE    5
+#define GRIDS_ACCENT_LEVEL 192
+
+struct GridsHits {
+  bool trigger[GRIDS_VOICES];
+  uint8_t level[GRIDS_VOICES];  // Perturbed level, for accents
+};
+
+class GridsEngine {
+public:
+  explicit GridsEngine(uint32_t seed = 1);
+  
+  // Interpolated map level of 'voice' at 'step' for position (x, y)
+  static uint8_t level(uint8_t voice, uint8_t step, uint8_t x, uint8_t y);
+  // Level as written at map node (nodeX, nodeY), 0 to GRIDS_MAP_SIZE - 1
+  static uint8_t nodeLevel(uint8_t voice, uint8_t step, uint8_t nodeX, uint8_t nodeY);
+  
+  // Evaluates one step. New perturbations are drawn at step 0, scaled by
+  // chaos (0 = the map as written).
+  GridsHits evaluate(uint8_t step, uint8_t x, uint8_t y,
+                     const uint8_t density[GRIDS_VOICES], uint8_t chaos);
+  
+  void seed(uint32_t value);
+
+private:
+  uint8_t randomByte();
+  
+  uint32_t rng;
+  uint8_t perturbation[GRIDS_VOICES];
+};
+
+#endif // GRIDS_ENGINE_H
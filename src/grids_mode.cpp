@@ -1,81 +1,17 @@
 /*******************************************************************
  GRIDS Mode Implementation
- Simplified Grids drum pattern generator with X/Y pad interface
+ Grids drum pattern generator with X/Y pad interface (see grids_engine.h)
  *******************************************************************/
 
 #include "grids_mode.h"
+#include "param_registry.h"
 
 GridsState grids;
 
-// Simplified pattern maps (16 steps, 3 voices) 
-// These are inspired by classic drum patterns
-// Each value is 0-255 representing trigger probability
+// Levels are worked out one step at a time as the sequencer reaches it
+static GridsEngine gridsEngine;
 
-// Pattern Map A (corner patterns) - 4 base patterns
-const uint8_t PATTERN_MAP[4][3][GRIDS_STEPS] PROGMEM = {
-  // Pattern 0: Four-on-the-floor house beat
-  {
-    {255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0},   // Kick
-    {0, 0, 0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 200, 0, 0, 0},       // Snare
-    {150, 80, 150, 80, 150, 80, 150, 80, 150, 80, 150, 80, 150, 80, 150, 80}  // Hat
-  },
-  // Pattern 1: Funky breakbeat
-  {
-    {255, 0, 0, 180, 0, 0, 255, 0, 0, 180, 0, 0, 255, 0, 0, 0},  // Kick
-    {0, 0, 255, 0, 0, 0, 0, 180, 0, 0, 255, 0, 0, 0, 180, 0},    // Snare
-    {200, 120, 80, 150, 200, 120, 80, 150, 200, 120, 80, 150, 200, 120, 80, 150}  // Hat
-  },
-  // Pattern 2: Minimal techno
-  {
-    {255, 0, 0, 0, 0, 0, 200, 0, 255, 0, 0, 0, 180, 0, 0, 0},   // Kick
-    {0, 0, 0, 0, 255, 0, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0},       // Snare
-    {180, 120, 0, 120, 180, 120, 0, 120, 180, 120, 0, 120, 180, 120, 0, 120}  // Hat
-  },
-  // Pattern 3: Hip-hop boom-bap
-  {
-    {255, 0, 0, 0, 0, 0, 220, 0, 180, 0, 0, 0, 0, 0, 200, 0},   // Kick
-    {0, 0, 0, 0, 255, 0, 0, 120, 0, 0, 0, 0, 255, 0, 0, 80},    // Snare
-    {150, 100, 150, 100, 150, 100, 150, 100, 150, 100, 150, 100, 150, 100, 150, 100}  // Hat
-  }
-};
-
-// Linear interpolation helper
-uint8_t lerp(uint8_t a, uint8_t b, uint8_t amount) {
-  return a + (((b - a) * amount) >> 8);
-}
-
-// Bilinear interpolation across 4 pattern corners
-uint8_t bilinearInterpolate(uint8_t v00, uint8_t v10, uint8_t v01, uint8_t v11, uint8_t x, uint8_t y) {
-  uint8_t v0 = lerp(v00, v10, x);
-  uint8_t v1 = lerp(v01, v11, x);
-  return lerp(v0, v1, y);
-}
-
-void regenerateGridsPattern() {
-  Serial.printf("Regenerating Grids pattern at X=%d Y=%d\n", grids.patternX, grids.patternY);
-  
-  // For each step and voice, interpolate between the 4 corner patterns
-  for (int step = 0; step < GRIDS_STEPS; step++) {
-    // Read corner values from PROGMEM
-    uint8_t k00 = pgm_read_byte(&PATTERN_MAP[0][0][step]);
-    uint8_t k10 = pgm_read_byte(&PATTERN_MAP[1][0][step]);
-    uint8_t k01 = pgm_read_byte(&PATTERN_MAP[2][0][step]);
-    uint8_t k11 = pgm_read_byte(&PATTERN_MAP[3][0][step]);
-    grids.kickPattern[step] = bilinearInterpolate(k00, k10, k01, k11, grids.patternX, grids.patternY);
-    
-    uint8_t s00 = pgm_read_byte(&PATTERN_MAP[0][1][step]);
-    uint8_t s10 = pgm_read_byte(&PATTERN_MAP[1][1][step]);
-    uint8_t s01 = pgm_read_byte(&PATTERN_MAP[2][1][step]);
-    uint8_t s11 = pgm_read_byte(&PATTERN_MAP[3][1][step]);
-    grids.snarePattern[step] = bilinearInterpolate(s00, s10, s01, s11, grids.patternX, grids.patternY);
-    
-    uint8_t h00 = pgm_read_byte(&PATTERN_MAP[0][2][step]);
-    uint8_t h10 = pgm_read_byte(&PATTERN_MAP[1][2][step]);
-    uint8_t h01 = pgm_read_byte(&PATTERN_MAP[2][2][step]);
-    uint8_t h11 = pgm_read_byte(&PATTERN_MAP[3][2][step]);
-    grids.hatPattern[step] = bilinearInterpolate(h00, h10, h01, h11, grids.patternX, grids.patternY);
-  }
-}
+static void tickGrids();
 
 void initializeGridsMode() {
   Serial.println("\n=== Grids Mode Initialization ===");
@@ -91,15 +27,18 @@ void initializeGridsMode() {
   grids.kickDensity = 200;
   grids.snareDensity = 150;
   grids.hatDensity = 180;
+  grids.chaos = 0;
   grids.swing = 0;
-  grids.accentThreshold = 200;
+  grids.accentThreshold = GRIDS_ACCENT_LEVEL;
   
-  regenerateGridsPattern();
+  // Seeded here rather than at static init, where the RNG has no entropy yet
+  gridsEngine.seed(esp_random());
   
   Serial.printf("BPM: %.1f, Pattern: (%d,%d)\n", grids.bpm, grids.patternX, grids.patternY);
   Serial.println("Grids initialized and drawn");
   
   drawGridsMode();
+  StepClock::start(GRIDS, tickGrids);
 }
 
 void drawGridsMode() {
@@ -108,20 +47,42 @@ void drawGridsMode() {
   // Unified header with BLE, SD, and BPM indicators
   drawModuleHeader("GRIDS");
   
-  int y = CONTENT_TOP;
+  drawGridsPad();
+  drawGridsChaos();
+  drawGridsDensity();
   
+  // Control buttons at bottom - calculated from screen dimensions
+  int btnSpacing = 10;
+  int btnY = SCREEN_HEIGHT - 60;
+  int btnH = 50;
+  int btnW = (SCREEN_WIDTH - (5 * btnSpacing)) / 4;  // 4 buttons instead of 5
+  
+  drawRoundButton(10, btnY, btnW, btnH, grids.playing ? "STOP" : "PLAY", THEME_PRIMARY, false);
+  drawRoundButton(100, btnY, btnW, btnH, "BPM-", THEME_SECONDARY, false);
+  drawRoundButton(190, btnY, btnW, btnH, "BPM+", THEME_SECONDARY, false);
+  drawRoundButton(280, btnY, btnW, btnH, "RNDM", THEME_ACCENT, false);
+}
+
+// X/Y pad with the position marker
+void drawGridsPad() {
   // X/Y Pad area (large touch area like Beatmap)
   int padSize = 200;
   int padX = 240 - padSize/2;
-  int padY = y + 10;
+  int padY = CONTENT_TOP + 10;
+  
+  // The marker can stick out past the pad edge
+  tft.fillRect(padX - 8, padY - 8, padSize + 16, padSize + 16, THEME_BG);
   
   // Draw pad background
   tft.fillRect(padX, padY, padSize, padSize, THEME_SURFACE);
   tft.drawRect(padX, padY, padSize, padSize, THEME_TEXT);
   
-  // Draw grid lines to show quadrants
-  tft.drawFastVLine(padX + padSize/2, padY, padSize, THEME_TEXT_DIM);
-  tft.drawFastHLine(padX, padY + padSize/2, padSize, THEME_TEXT_DIM);
+  // Grid lines through the map nodes (the outer ones are the pad edges)
+  for (int i = 1; i < GRIDS_MAP_SIZE - 1; i++) {
+    int offset = i * padSize / (GRIDS_MAP_SIZE - 1);
+    tft.drawFastVLine(padX + offset, padY, padSize, THEME_TEXT_DIM);
+    tft.drawFastHLine(padX, padY + offset, padSize, THEME_TEXT_DIM);
+  }
   
   // Draw current position marker
   int markerX = padX + (grids.patternX * padSize / 256);
@@ -135,20 +96,35 @@ void drawGridsMode() {
   tft.drawRightString("FUNK", padX + padSize - 5, padY + 5, 1);
   tft.drawString("TECH", padX + 5, padY + padSize - 15, 1);
   tft.drawRightString("HIP", padX + padSize - 5, padY + padSize - 15, 1);
+}
+
+// Chaos slider (vertical, right of the pad)
+void drawGridsChaos() {
+  int padSize = 200;
+  int padY = CONTENT_TOP + 10;
   
-  y += padSize + 20;
-  
-  // Density sliders visualization (below pad)
-  int sliderY = y;
+  tft.setTextColor(THEME_SECONDARY, THEME_BG);
+  tft.drawCentreString("CHAOS", 395, padY, 1);
+  tft.drawRect(380, padY + 12, 30, padSize - 12, THEME_TEXT);
+  int chaosFill = (grids.chaos * (padSize - 14)) / 255;
+  tft.fillRect(381, padY + 13, 28, padSize - 14 - chaosFill, THEME_BG);
+  if (chaosFill > 0) {
+    tft.fillRect(381, padY + padSize - 1 - chaosFill, 28, chaosFill, THEME_SECONDARY);
+  }
+}
+
+// Density sliders visualization (below pad)
+void drawGridsDensity() {
+  int sliderY = CONTENT_TOP + 220;  // 10 below the pad
   int sliderW = 120;
   int sliderH = 20;
-  int sliderSpacing = 10;
   
   // Kick density
   tft.setTextColor(THEME_ERROR, THEME_BG);
   tft.drawString("K", 20, sliderY, 2);
   tft.drawRect(45, sliderY, sliderW, sliderH, THEME_TEXT);
   int kickFill = (grids.kickDensity * sliderW) / 255;
+  tft.fillRect(46, sliderY + 1, sliderW - 2, sliderH - 2, THEME_BG);
   if (kickFill > 0) tft.fillRect(46, sliderY + 1, kickFill, sliderH - 2, THEME_ERROR);
   
   // Snare density  
@@ -156,6 +132,7 @@ void drawGridsMode() {
   tft.drawString("S", 180, sliderY, 2);
   tft.drawRect(205, sliderY, sliderW, sliderH, THEME_TEXT);
   int snareFill = (grids.snareDensity * sliderW) / 255;
+  tft.fillRect(206, sliderY + 1, sliderW - 2, sliderH - 2, THEME_BG);
   if (snareFill > 0) tft.fillRect(206, sliderY + 1, snareFill, sliderH - 2, THEME_WARNING);
   
   // Hat density
@@ -163,59 +140,52 @@ void drawGridsMode() {
   tft.drawString("H", 340, sliderY, 2);
   tft.drawRect(365, sliderY, sliderW, sliderH, THEME_TEXT);
   int hatFill = (grids.hatDensity * sliderW) / 255;
+  tft.fillRect(366, sliderY + 1, sliderW - 2, sliderH - 2, THEME_BG);
   if (hatFill > 0) tft.fillRect(366, sliderY + 1, hatFill, sliderH - 2, THEME_ACCENT);
-  
-  // Control buttons at bottom - calculated from screen dimensions
-  int btnSpacing = 10;
-  int btnY = SCREEN_HEIGHT - 60;
-  int btnH = 50;
-  int btnW = (SCREEN_WIDTH - (5 * btnSpacing)) / 4;  // 4 buttons instead of 5
-  
-  drawRoundButton(10, btnY, btnW, btnH, grids.playing ? "STOP" : "PLAY", THEME_PRIMARY, false);
-  drawRoundButton(100, btnY, btnW, btnH, "BPM-", THEME_SECONDARY, false);
-  drawRoundButton(190, btnY, btnW, btnH, "BPM+", THEME_SECONDARY, false);
-  drawRoundButton(280, btnY, btnW, btnH, "RNDM", THEME_ACCENT, false);
 }
 
-void handleGridsMode() {
-  updateTouch();
+// Step clock tick: playback timing and notes, no drawing
+static void tickGrids() {
+  if (!grids.playing) return;
+  
+  unsigned long now = millis();
+  grids.stepInterval = (60000.0 / grids.bpm) / 4.0; // 16th notes
   
-  // Handle playback timing
-  if (grids.playing) {
-    unsigned long now = millis();
-    grids.stepInterval = (60000.0 / grids.bpm) / 4.0; // 16th notes
+  if (now - grids.lastStepTime >= grids.stepInterval) {
+    grids.lastStepTime = now;
+    ParamRegistry::applyTick(GRIDS);
     
-    if (now - grids.lastStepTime >= grids.stepInterval) {
-      grids.lastStepTime = now;
-      
-      // Check each voice against its density threshold
-      bool kickTrigger = grids.kickPattern[grids.step] >= (255 - grids.kickDensity);
-      bool snareTrigger = grids.snarePattern[grids.step] >= (255 - grids.snareDensity);
-      bool hatTrigger = grids.hatPattern[grids.step] >= (255 - grids.hatDensity);
-      
-      // Determine velocity (accent)
-      uint8_t kickVel = grids.kickPattern[grids.step] >= grids.accentThreshold ? 127 : 100;
-      uint8_t snareVel = grids.snarePattern[grids.step] >= grids.accentThreshold ? 127 : 100;
-      uint8_t hatVel = grids.hatPattern[grids.step] >= grids.accentThreshold ? 127 : 90;
-      
-      // Send MIDI notes
-      if (kickTrigger) {
-        sendNoteOn(grids.kickNote, kickVel);
-        sendNoteOff(grids.kickNote); // Immediate note off for drums
-      }
-      if (snareTrigger) {
-        sendNoteOn(grids.snareNote, snareVel);
-        sendNoteOff(grids.snareNote);
-      }
-      if (hatTrigger) {
-        sendNoteOn(grids.hatNote, hatVel);
-        sendNoteOff(grids.hatNote);
-      }
-      
-      // Advance step
-      grids.step = (grids.step + 1) % GRIDS_STEPS;
+    // Check each voice against its density threshold
+    uint8_t density[GRIDS_VOICES] = {grids.kickDensity, grids.snareDensity, grids.hatDensity};
+    GridsHits hits = gridsEngine.evaluate(grids.step, grids.patternX, grids.patternY,
+                                          density, grids.chaos);
+    
+    // Determine velocity (accent)
+    uint8_t kickVel = hits.level[0] >= grids.accentThreshold ? 127 : 100;
+    uint8_t snareVel = hits.level[1] >= grids.accentThreshold ? 127 : 100;
+    uint8_t hatVel = hits.level[2] >= grids.accentThreshold ? 127 : 90;
+    
+    // Send MIDI notes
+    if (hits.trigger[0]) {
+      sendNoteOn(grids.kickNote, kickVel);
+      sendNoteOff(grids.kickNote); // Immediate note off for drums
     }
+    if (hits.trigger[1]) {
+      sendNoteOn(grids.snareNote, snareVel);
+      sendNoteOff(grids.snareNote);
+    }
+    if (hits.trigger[2]) {
+      sendNoteOn(grids.hatNote, hatVel);
+      sendNoteOff(grids.hatNote);
+    }
+    
+    // Advance step
+    grids.step = (grids.step + 1) % GRIDS_STEPS;
   }
+}
+
+void handleGridsMode() {
+  updateTouch();
   
   if (touch.justPressed) {
     // Check back button from header first
@@ -237,12 +207,19 @@ void handleGridsMode() {
       // Update pattern position
       grids.patternX = ((touch.x - padX) * 255) / padSize;
       grids.patternY = ((touch.y - padY) * 255) / padSize;
-      regenerateGridsPattern();
       drawGridsMode();
       Serial.printf("Pattern moved to (%d, %d)\n", grids.patternX, grids.patternY);
       return;
     }
     
+    // Chaos slider
+    if (touch.x >= 380 && touch.x < 410 && touch.y >= padY + 12 && touch.y < padY + padSize) {
+      grids.chaos = ((padY + padSize - 1 - touch.y) * 255) / (padSize - 13);
+      drawGridsMode();
+      Serial.printf("Chaos: %d\n", grids.chaos);
+      return;
+    }
+    
     // Check control buttons - calculate matching drawGridsMode
     int btnSpacing = 10;
     int btnY = SCREEN_HEIGHT - 60;
@@ -263,11 +240,13 @@ void handleGridsMode() {
       drawRoundButton(280, btnY, btnW, btnH, "RNDM", THEME_ACCENT, randomPressed);
     }
     if (playPressed) {
+      StepClock::lock();
       grids.playing = !grids.playing;
       if (grids.playing) {
         grids.step = 0;
         grids.lastStepTime = millis();
       }
+      StepClock::unlock();
       drawGridsMode();
       Serial.printf("Grids %s\n", grids.playing ? "started" : "stopped");
       return;
@@ -293,7 +272,6 @@ void handleGridsMode() {
     if (randomPressed) {
       grids.patternX = random(256);
       grids.patternY = random(256);
-      regenerateGridsPattern();
       drawGridsMode();
       Serial.printf("Random pattern: (%d, %d)\n", grids.patternX, grids.patternY);
       return;
@@ -329,3 +307,39 @@ void handleGridsMode() {
     }
   }
 }
+
+// Remote parameters; pattern changes apply at the next step, transport at once.
+// Pattern changes only repaint the control they belong to.
+void publishGridsParams() {
+  ParamRegistry::add("grids.playing", GRIDS, 0, 1, false,
+    []() -> int16_t { return grids.playing; },
+    [](int16_t v) {
+      if (grids.playing == (bool)v) return;
+      grids.playing = v;
+      if (grids.playing) {
+        grids.step = 0;
+        grids.lastStepTime = millis();
+      }
+    }, drawGridsMode);
+  ParamRegistry::add("grids.bpm", GRIDS, GRIDS_MIN_BPM, GRIDS_MAX_BPM, false,
+    []() -> int16_t { return (int16_t)grids.bpm; },
+    [](int16_t v) { grids.bpm = v; }, drawGridsMode);
+  ParamRegistry::add("grids.patternX", GRIDS, 0, 255, true,
+    []() -> int16_t { return grids.patternX; },
+    [](int16_t v) { grids.patternX = v; }, drawGridsPad);
+  ParamRegistry::add("grids.patternY", GRIDS, 0, 255, true,
+    []() -> int16_t { return grids.patternY; },
+    [](int16_t v) { grids.patternY = v; }, drawGridsPad);
+  ParamRegistry::add("grids.kickDensity", GRIDS, 0, 255, true,
+    []() -> int16_t { return grids.kickDensity; },
+    [](int16_t v) { grids.kickDensity = v; }, drawGridsDensity);
+  ParamRegistry::add("grids.snareDensity", GRIDS, 0, 255, true,
+    []() -> int16_t { return grids.snareDensity; },
+    [](int16_t v) { grids.snareDensity = v; }, drawGridsDensity);
+  ParamRegistry::add("grids.hatDensity", GRIDS, 0, 255, true,
+    []() -> int16_t { return grids.hatDensity; },
+    [](int16_t v) { grids.hatDensity = v; }, drawGridsDensity);
+  ParamRegistry::add("grids.chaos", GRIDS, 0, 255, true,
+    []() -> int16_t { return grids.chaos; },
+    [](int16_t v) { grids.chaos = v; }, drawGridsChaos);
+}
@@ -3,10 +3,10 @@
  Adapted for MIDI based on MI Grids by Emilie Gillet
  
  Features:
- - X/Y pad for pattern selection and variation
+ - X/Y pad over a 5x5 map of 32-step drum patterns
  - 3 drum voices (Kick, Snare, Hi-hat)
- - Pattern map interpolation
- - Density/Fill control per voice
+ - Bilinear interpolation between the surrounding map nodes
+ - Density/Fill control per voice, chaos (random perturbation)
  - BPM control
  *******************************************************************/
 
@@ -16,8 +16,8 @@
 #include "common_definitions.h"
 #include "ui_elements.h"
 #include "midi_utils.h"
+#include "grids_engine.h"
 
-#define GRIDS_STEPS 16
 #define GRIDS_MIN_BPM 60
 #define GRIDS_MAX_BPM 240
 
@@ -38,6 +38,9 @@ struct GridsState {
   uint8_t snareDensity = 150;
   uint8_t hatDensity = 180;
   
+  // Random perturbation of the levels, redrawn each pattern cycle (0-255)
+  uint8_t chaos = 0;
+  
   // MIDI note assignments
   uint8_t kickNote = 36;   // C1 - Kick
   uint8_t snareNote = 38;  // D1 - Snare
@@ -47,12 +50,7 @@ struct GridsState {
   uint8_t swing = 0;
   
   // Accent threshold (0-255)
-  uint8_t accentThreshold = 200;
-  
-  // Current pattern buffers (0-255 per step)
-  uint8_t kickPattern[GRIDS_STEPS];
-  uint8_t snarePattern[GRIDS_STEPS];
-  uint8_t hatPattern[GRIDS_STEPS];
+  uint8_t accentThreshold = GRIDS_ACCENT_LEVEL;
 };
 
 extern GridsState grids;
@@ -60,7 +58,10 @@ extern GridsState grids;
 // Function declarations
 void initializeGridsMode();
 void drawGridsMode();
+void drawGridsPad();
+void drawGridsChaos();
+void drawGridsDensity();
 void handleGridsMode();
-void regenerateGridsPattern();
+void publishGridsParams();
 
 #endif
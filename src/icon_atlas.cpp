@@ -0,0 +1,164 @@
+#include "icon_atlas.h"
+
+IconAtlas::Run* IconAtlas::icons[ICON_ATLAS_MAX_ICONS] = {nullptr};
+uint16_t IconAtlas::runCounts[ICON_ATLAS_MAX_ICONS] = {0};
+uint16_t* IconAtlas::bandBuffer = nullptr;
+int IconAtlas::iconCount = 0;
+int IconAtlas::iconSize = 0;
+size_t IconAtlas::bytesUsed = 0;
+int IconAtlas::shadowSource = -1;
+
+bool IconAtlas::isBuilt(int count, int size) {
+  return iconCount > 0 && iconCount == count && iconSize == size;
+}
+
+bool IconAtlas::build(int count, int size, IconRenderer render) {
+  if (isBuilt(count, size)) return true;
+  if (count > ICON_ATLAS_MAX_ICONS || size <= 0) return false;
+  
+  clear();
+  unsigned long startTime = micros();
+  
+  // One scratch sprite for rendering, released once everything is encoded
+  TFT_eSprite scratch = TFT_eSprite(&tft);
+  scratch.setColorDepth(16);
+  if (!scratch.createSprite(size, size)) {
+    Serial.println("IconAtlas: scratch sprite allocation failed");
+    return false;
+  }
+  
+  bandBuffer = (uint16_t*)malloc(size * ICON_ATLAS_BAND_ROWS * sizeof(uint16_t));
+  if (!bandBuffer) {
+    scratch.deleteSprite();
+    return false;
+  }
+  bytesUsed = size * ICON_ATLAS_BAND_ROWS * sizeof(uint16_t);
+  
+  for (int i = 0; i < count; i++) {
+    scratch.fillSprite(THEME_BG);
+    render(scratch, i, size);
+    
+    // First pass counts runs, second pass stores them
+    uint16_t runs = 0;
+    uint16_t prevColor = 0;
+    uint16_t runLength = 0;
+    for (int y = 0; y < size; y++) {
+      for (int x = 0; x < size; x++) {
+        uint16_t c = scratch.readPixel(x, y);
+        if (runLength == 0 || c != prevColor || runLength == 0xFFFF) {
+          runs++;
+          runLength = 0;
+          prevColor = c;
+        }
+        runLength++;
+      }
+    }
+    
+    icons[i] = (Run*)malloc(runs * sizeof(Run));
+    if (!icons[i]) {
+      Serial.println("IconAtlas: out of memory, falling back to direct drawing");
+      scratch.deleteSprite();
+      clear();
+      return false;
+    }
+    
+    int r = -1;
+    for (int y = 0; y < size; y++) {
+      for (int x = 0; x < size; x++) {
+        uint16_t c = scratch.readPixel(x, y);
+        uint16_t swapped = (c >> 8) | (c << 8);
+        if (r < 0 || icons[i][r].color != swapped || icons[i][r].length == 0xFFFF) {
+          r++;
+          icons[i][r].length = 0;
+          icons[i][r].color = swapped;
+        }
+        icons[i][r].length++;
+      }
+    }
+    
+    runCounts[i] = runs;
+    bytesUsed += runs * sizeof(Run);
+  }
+  
+  scratch.deleteSprite();
+  iconCount = count;
+  iconSize = size;
+  
+  Serial.printf("IconAtlas: %d icons at %dpx built in %lu us (%u bytes)\n",
+                count, size, micros() - startTime, (unsigned)bytesUsed);
+  return true;
+}
+
+void IconAtlas::draw(int index, int x, int y) {
+  if (index < 0 || index >= iconCount) return;
+  
+  const Run* run = icons[index];
+  const Run* end = run + runCounts[index];
+  uint16_t remaining = run->length;
+  
+  bool oldSwapBytes = tft.getSwapBytes();
+  tft.setSwapBytes(false);
+  tft.startWrite();
+  
+  // Decode a band of rows at a time and push it as one block
+  for (int bandY = 0; bandY < iconSize; bandY += ICON_ATLAS_BAND_ROWS) {
+    int rows = min(ICON_ATLAS_BAND_ROWS, iconSize - bandY);
+    int pixels = rows * iconSize;
+    
+    for (int p = 0; p < pixels; p++) {
+      while (remaining == 0 && run + 1 < end) {
+        run++;
+        remaining = run->length;
+      }
+      bandBuffer[p] = run->color;
+      remaining--;
+    }
+    
+    // Straight to the panel; the whole icon is recorded below
+    static_cast<TFT_eSPI&>(tft).pushImage(x, y + bandY, iconSize, rows, bandBuffer);
+  }
+  
+  tft.endWrite();
+  tft.setSwapBytes(oldSwapBytes);
+  
+  if (shadowSource < 0) shadowSource = tft.addImageSource(replay);
+  tft.markImage(x, y, iconSize, iconSize, shadowSource, index);
+}
+
+// Decode an icon's runs straight into the target as horizontal spans
+void IconAtlas::replay(TFT_eSPI& target, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t index) {
+  // Rebuilt at another size since it was drawn: nothing sensible to replay
+  if ((int)index >= iconCount || w != iconSize || h != iconSize) return;
+  
+  const Run* run = icons[index];
+  const Run* end = run + runCounts[index];
+  int col = 0;
+  int row = 0;
+  for (; run < end; run++) {
+    uint16_t color = (run->color >> 8) | (run->color << 8);  // Back from display byte order
+    int remaining = run->length;
+    while (remaining > 0 && row < iconSize) {
+      int span = min(remaining, iconSize - col);
+      target.drawFastHLine(x + col, y + row, span, color);
+      remaining -= span;
+      col += span;
+      if (col == iconSize) {
+        col = 0;
+        row++;
+      }
+    }
+  }
+}
+
+void IconAtlas::clear() {
+  for (int i = 0; i < ICON_ATLAS_MAX_ICONS; i++) {
+    free(icons[i]);
+    icons[i] = nullptr;
+    runCounts[i] = 0;
+  }
+  free(bandBuffer);
+  bandBuffer = nullptr;
+  iconCount = 0;
+  iconSize = 0;
+  bytesUsed = 0;
+}
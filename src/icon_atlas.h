@@ -0,0 +1,46 @@
+#ifndef ICON_ATLAS_H
+#define ICON_ATLAS_H
+
+#include "common_definitions.h"
+
+// Menu icon atlas
+// The menu icons are drawn procedurally (rounded rects, circles, trig curves).
+// The atlas renders each icon once into an off-screen sprite at the current
+// icon size and keeps it run-length encoded in RAM (icons are mostly flat
+// colour, so ~1-2KB each instead of 14KB raw). Menu draws then decode and blit
+// each icon in a few block transfers. Blits are recorded in the display list
+// by icon index, and screenshots decode the runs again to replay them.
+#define ICON_ATLAS_MAX_ICONS 16
+#define ICON_ATLAS_BAND_ROWS 8  // Rows decoded per pushImage
+
+class IconAtlas {
+public:
+  // Draws icon 'index' at (0, 0) into gfx; background is pre-filled with THEME_BG
+  typedef void (*IconRenderer)(TFT_eSPI& gfx, int index, int size);
+  
+  // Render and encode all icons. Skipped if already built for this count/size.
+  static bool build(int count, int size, IconRenderer render);
+  static bool isBuilt(int count, int size);
+  static void draw(int index, int x, int y);
+  static void clear();
+  static size_t getBytesUsed() { return bytesUsed; }
+  
+private:
+  struct Run {
+    uint16_t length;
+    uint16_t color;  // Display byte order, ready for pushImage
+  };
+  
+  static Run* icons[ICON_ATLAS_MAX_ICONS];
+  static uint16_t runCounts[ICON_ATLAS_MAX_ICONS];
+  static uint16_t* bandBuffer;
+  static int iconCount;
+  static int iconSize;
+  static size_t bytesUsed;
+  static int shadowSource;
+  
+  // Display list replay (ShadowTFT::ImageSource)
+  static void replay(TFT_eSPI& target, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t index);
+};
+
+#endif // ICON_ATLAS_H
@@ -4,6 +4,7 @@
 #include "common_definitions.h"
 #include "ui_elements.h"
 #include "midi_utils.h"
+#include "param_registry.h"
 
 // LFO mode variables
 struct LFOParams {
@@ -30,6 +31,7 @@ void updateLFO();
 float calculateLFOValue();
 void sendLFOValue(int value);
 void drawWaveform();
+void publishLFOParams();
 
 // Implementations
 void initializeLFOMode() {
@@ -345,7 +347,7 @@ float calculateLFOValue() {
 }
 
 void sendLFOValue(int value) {
-  if (!globalState.bleConnected) return;
+  if (!globalState.bleConnected && !networkMIDIActive()) return;
   
   if (lfo.pitchWheelMode) {
     // Send pitchwheel (14-bit value already calculated)
@@ -356,12 +358,32 @@ void sendLFOValue(int value) {
     midiPacket[2] = 0xE0;
     midiPacket[3] = lsb;
     midiPacket[4] = msb;
-    pCharacteristic->setValue(midiPacket, 5);
-    pCharacteristic->notify();
+    if (globalState.bleConnected) {
+      pCharacteristic->setValue(midiPacket, 5);
+      pCharacteristic->notify();
+    }
+    sendMIDIToNetwork(midiPacket + 2, 3);
   } else {
     // Send regular CC
     sendControlChange(lfo.ccTarget, value);
   }
 }
 
-#endif
\ No newline at end of file
+// Remote parameters; the LFO is free-running, so changes apply straight away
+void publishLFOParams() {
+  ParamRegistry::add("lfo.playing", LFO, 0, 1, false,
+    []() -> int16_t { return lfo.isRunning; },
+    [](int16_t v) {
+      if (lfo.isRunning == (bool)v) return;
+      lfo.isRunning = v;
+      if (lfo.isRunning) {
+        lfo.phase = 0.0;
+        lfo.lastUpdate = millis();
+      }
+    }, drawLFOMode);
+  ParamRegistry::add("lfo.rate", LFO, 1, 100, false,  // 0.1 Hz units
+    []() -> int16_t { return (int16_t)roundf(lfo.rate * 10); },
+    [](int16_t v) { lfo.rate = v / 10.0; }, drawLFOControls);
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "metrics.h"
+#include "common_definitions.h"
+#include "button_cache.h"
+#include <esp_heap_caps.h>
+
+// Bucket bounds, microseconds
+static const uint32_t LOOP_BOUNDS[] = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 250000};
+static const uint32_t STORAGE_BOUNDS[] = {500, 1000, 2000, 5000, 10000, 25000, 50000, 100000};
+static const char* STORAGE_LABELS[] = {"op=\"open\"", "op=\"read\"", "op=\"write\"",
+                                       "op=\"close\"", "op=\"remove\""};
+
+// Tasks whose stack high-water mark is reported (those not running are skipped)
+static const char* TASK_NAMES[] = {"loopTask", "TouchTask", "MIDITask", "StepClock", "RenderTask",
+                                   "WebServerTask", "StorageTask", "RtpMidiTask", "OscTask"};
+
+MetricsHistogram Metrics::loopTime(LOOP_BOUNDS, 8);
+MetricsHistogram Metrics::storageTime[SD_OP_COUNT] = {
+  MetricsHistogram(STORAGE_BOUNDS, 8), MetricsHistogram(STORAGE_BOUNDS, 8),
+  MetricsHistogram(STORAGE_BOUNDS, 8), MetricsHistogram(STORAGE_BOUNDS, 8),
+  MetricsHistogram(STORAGE_BOUNDS, 8)
+};
+volatile uint32_t Metrics::midiHighWater = 0;
+volatile uint32_t Metrics::midiDrops = 0;
+volatile uint32_t Metrics::bleNotifies = 0;
+volatile uint32_t Metrics::bleNotifyFailures = 0;
+
+MetricsHistogram::MetricsHistogram(const uint32_t* bounds, uint8_t boundCount)
+  : bounds(bounds), boundCount(min(boundCount, (uint8_t)METRICS_MAX_BUCKETS)), sumMicros(0) {
+  memset(counts, 0, sizeof(counts));
+}
+
+void MetricsHistogram::observe(uint32_t micros) {
+  uint8_t i = 0;
+  while (i < boundCount && micros > bounds[i]) i++;
+  counts[i]++;
+  sumMicros += micros;
+}
+
+void MetricsHistogram::format(String& out, const char* name, const char* labels) const {
+  char line[160];
+  const char* sep = labels[0] ? "," : "";
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i <= boundCount; i++) {
+    cumulative += counts[i];
+    if (i < boundCount) {
+      snprintf(line, sizeof(line), "%s_bucket{%s%sle=\"%g\"} %u\n", name, labels, sep,
+               bounds[i] / 1e6, (unsigned)cumulative);
+    } else {
+      snprintf(line, sizeof(line), "%s_bucket{%s%sle=\"+Inf\"} %u\n", name, labels, sep,
+               (unsigned)cumulative);
+    }
+    out += line;
+  }
+  const char* open = labels[0] ? "{" : "";
+  const char* close = labels[0] ? "}" : "";
+  snprintf(line, sizeof(line), "%s_sum%s%s%s %.6f\n%s_count%s%s%s %u\n",
+           name, open, labels, close, sumMicros / 1e6,
+           name, open, labels, close, (unsigned)cumulative);
+  out += line;
+}
+
+static void appendHeader(String& out, const char* name, const char* type, const char* help) {
+  out += "# HELP ";
+  out += name;
+  out += " ";
+  out += help;
+  out += "\n# TYPE ";
+  out += name;
+  out += " ";
+  out += type;
+  out += "\n";
+}
+
+static void appendValue(String& out, const char* name, const char* type, const char* help,
+                        uint32_t value) {
+  appendHeader(out, name, type, help);
+  out += name;
+  out += " ";
+  out += String(value);
+  out += "\n";
+}
+
+String Metrics::toText() {
+  String out;
+  out.reserve(4096);
+  
+  appendValue(out, "cyd_uptime_seconds", "gauge", "Seconds since boot", millis() / 1000);
+  
+  appendHeader(out, "cyd_loop_seconds", "histogram", "Main loop pass duration, excluding the idle delay");
+  loopTime.format(out, "cyd_loop_seconds", "");
+  
+  appendValue(out, "cyd_midi_queue_depth", "gauge", "Messages waiting in the MIDI output queue",
+              MIDIThread::queueDepth());
+  appendValue(out, "cyd_midi_queue_high_water", "gauge", "Deepest the MIDI output queue has been",
+              midiHighWater);
+  appendValue(out, "cyd_midi_queue_dropped_total", "counter", "MIDI messages dropped on a full queue",
+              midiDrops);
+  
+  appendValue(out, "cyd_ble_connected", "gauge", "1 while a BLE MIDI client is connected",
+              globalState.bleConnected ? 1 : 0);
+  appendValue(out, "cyd_ble_notify_total", "counter", "BLE MIDI notifications sent", bleNotifies);
+  appendValue(out, "cyd_ble_notify_failures_total", "counter", "BLE MIDI notifications that failed",
+              bleNotifyFailures);
+  
+  appendValue(out, "cyd_heap_free_bytes", "gauge", "Free heap", ESP.getFreeHeap());
+  appendValue(out, "cyd_heap_min_free_bytes", "gauge", "Lowest free heap since boot", ESP.getMinFreeHeap());
+  appendValue(out, "cyd_heap_largest_free_block_bytes", "gauge", "Largest allocatable block",
+              heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+  
+  appendValue(out, "cyd_display_shadow_overflows_total", "counter",
+              "Times the display list filled up and reads fell back to the panel",
+              tft.getOverflowCount());
+  
+  appendValue(out, "cyd_button_cache_hits_total", "counter", "Buttons drawn from the button cache",
+              ButtonCache::getHits());
+  appendValue(out, "cyd_button_cache_misses_total", "counter", "Buttons rendered and added to the button cache",
+              ButtonCache::getMisses());
+  appendValue(out, "cyd_button_cache_bytes", "gauge", "Pixel memory held by the button cache",
+              ButtonCache::getBytesUsed());
+  
+  appendHeader(out, "cyd_task_stack_high_water_bytes", "gauge", "Least free stack a task has had");
+  for (const char* task : TASK_NAMES) {
+    TaskHandle_t handle = xTaskGetHandle(task);
+    if (!handle) continue;
+    out += "cyd_task_stack_high_water_bytes{task=\"";
+    out += task;
+    out += "\"} ";
+    out += String(uxTaskGetStackHighWaterMark(handle));
+    out += "\n";
+  }
+  
+  appendHeader(out, "cyd_sd_op_seconds", "histogram", "Storage worker request duration on the card");
+  for (int op = 0; op < SD_OP_COUNT; op++) {
+    storageTime[op].format(out, "cyd_sd_op_seconds", STORAGE_LABELS[op]);
+  }
+  
+  return out;
+}
@@ -0,0 +1,55 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+
+// Runtime metrics, served at /metrics in Prometheus text format
+// Hot paths only bump counters (a few compares and increments, no locks, no
+// formatting); everything is read and formatted when /metrics is scraped.
+// Readers may see a counter mid-update from another core, which is fine for
+// monitoring. Gauges (heap, queue depth, stack high-water) are sampled at
+// scrape time.
+#define METRICS_MAX_BUCKETS 8
+
+// Fixed-bucket histogram of durations in microseconds
+class MetricsHistogram {
+public:
+  // 'bounds' are ascending upper bounds (us) and must outlive the histogram
+  MetricsHistogram(const uint32_t* bounds, uint8_t boundCount);
+  void observe(uint32_t micros);
+  // Appends the _bucket/_sum/_count lines; 'labels' is "" or e.g. op="read"
+  void format(String& out, const char* name, const char* labels) const;
+
+private:
+  const uint32_t* bounds;
+  uint8_t boundCount;
+  uint32_t counts[METRICS_MAX_BUCKETS + 1];  // Per bucket, last is +Inf
+  uint64_t sumMicros;
+};
+
+class Metrics {
+public:
+  enum StorageOp : uint8_t { SD_OPEN, SD_READ, SD_WRITE, SD_CLOSE, SD_REMOVE, SD_OP_COUNT };
+  
+  // Loop pass, from the top of loop() to the idle delay
+  static void recordLoop(uint32_t micros) { loopTime.observe(micros); }
+  // Storage worker request, time spent on the card
+  static void recordStorage(StorageOp op, uint32_t micros) { storageTime[op].observe(micros); }
+  // MIDIThread: depth after a successful enqueue, or a message dropped on a full queue
+  static void midiQueued(uint32_t depth) { if (depth > midiHighWater) midiHighWater = depth; }
+  static void midiDropped() { midiDrops++; }
+  // BLE characteristic status callback
+  static void bleNotified(bool ok) { if (ok) bleNotifies++; else bleNotifyFailures++; }
+  
+  static String toText();
+
+private:
+  static MetricsHistogram loopTime;
+  static MetricsHistogram storageTime[SD_OP_COUNT];
+  static volatile uint32_t midiHighWater;
+  static volatile uint32_t midiDrops;
+  static volatile uint32_t bleNotifies;
+  static volatile uint32_t bleNotifyFailures;
+};
+
+#endif // METRICS_H
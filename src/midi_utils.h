@@ -3,6 +3,7 @@
 
 #include "common_definitions.h"
 #include "ui_elements.h"  // For Button class
+#include "boot_timeline.h"
 
 // External variables
 extern uint8_t midiChannel;
@@ -19,7 +20,7 @@ extern const int NUM_SCALES;
 
 // Legacy MIDI utility functions (kept for backward compatibility)
 inline void sendMIDI(byte cmd, byte note, byte vel) {
-  if (!globalState.bleConnected) return;
+  if (!globalState.bleConnected && !networkMIDIActive()) return;
   
   // Apply MIDI channel (channels 1-16 are encoded as 0-15 in the lower nibble)
   byte channelCmd = (cmd & 0xF0) | ((midiChannel - 1) & 0x0F);
@@ -27,8 +28,12 @@ inline void sendMIDI(byte cmd, byte note, byte vel) {
   midiPacket[2] = channelCmd;
   midiPacket[3] = note;
   midiPacket[4] = vel;
-  pCharacteristic->setValue(midiPacket, 5);
-  pCharacteristic->notify();
+  if (globalState.bleConnected) {
+    pCharacteristic->setValue(midiPacket, 5);
+    pCharacteristic->notify();
+  }
+  sendMIDIToNetwork(midiPacket + 2, 3);
+  if ((cmd & 0xF0) == 0x90 && vel > 0) BootTimeline::markFirstNote();
 }
 
 // Threaded MIDI functions (preferred - use these for new code)
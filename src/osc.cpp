@@ -0,0 +1,270 @@
+#include "osc.h"
+#include <string.h>
+
+#define OSC_MAX_DEPTH 4  // Bundle nesting we unpack
+
+static size_t padded(size_t length) {
+  return (length + 3) & ~(size_t)3;
+}
+
+static uint32_t get32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// Length of the OSC string at p including its padding, 0 if it isn't terminated in time
+static size_t stringSize(const uint8_t* p, const uint8_t* end) {
+  const uint8_t* nul = (const uint8_t*)memchr(p, 0, end - p);
+  if (!nul) return 0;
+  size_t size = padded(nul - p + 1);
+  return (p + size <= end) ? size : 0;
+}
+
+// Writer
+
+OscWriter::OscWriter(uint8_t* buffer, size_t capacity)
+  : buffer(buffer), capacity(capacity) {
+  reset();
+}
+
+void OscWriter::reset() {
+  used = 0;
+  sizeField = 0;
+  inBundle = false;
+  messages = 0;
+}
+
+bool OscWriter::reserve(size_t bytes) {
+  return used + bytes <= capacity;
+}
+
+void OscWriter::put32(uint32_t value) {
+  buffer[used++] = value >> 24;
+  buffer[used++] = value >> 16;
+  buffer[used++] = value >> 8;
+  buffer[used++] = value;
+}
+
+void OscWriter::putString(const char* value) {
+  size_t length = strlen(value);
+  size_t size = padded(length + 1);
+  memcpy(buffer + used, value, length);
+  memset(buffer + used + length, 0, size - length);
+  used += size;
+}
+
+void OscWriter::beginBundle(uint64_t timetag) {
+  reset();
+  if (!reserve(16)) return;
+  memcpy(buffer, "#bundle", 8);
+  used = 8;
+  put32(timetag >> 32);
+  put32(timetag);
+  inBundle = true;
+}
+
+bool OscWriter::beginMessage(const char* address, const char* types) {
+  // Space for the whole message, so a message is never left half written
+  // (arguments are all 4 bytes)
+  size_t size = padded(strlen(address) + 1) + padded(strlen(types) + 2);
+  size += 4 * strlen(types);
+  if (inBundle) size += 4;
+  if (!reserve(size) || (!inBundle && messages > 0)) return false;
+  
+  if (inBundle) {
+    sizeField = used;
+    used += 4;
+  }
+  putString(address);
+  buffer[used] = ',';
+  size_t typesLength = strlen(types);
+  memcpy(buffer + used + 1, types, typesLength);
+  size_t typesSize = padded(typesLength + 2);
+  memset(buffer + used + 1 + typesLength, 0, typesSize - typesLength - 1);
+  used += typesSize;
+  return true;
+}
+
+void OscWriter::addInt(int32_t value) {
+  put32((uint32_t)value);
+}
+
+void OscWriter::addFloat(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, 4);
+  put32(bits);
+}
+
+void OscWriter::endMessage() {
+  if (inBundle) {
+    uint32_t size = used - sizeField - 4;
+    buffer[sizeField] = size >> 24;
+    buffer[sizeField + 1] = size >> 16;
+    buffer[sizeField + 2] = size >> 8;
+    buffer[sizeField + 3] = size;
+  }
+  messages++;
+}
+
+// Reader
+
+bool OscMessage::parse(const uint8_t* data, size_t length) {
+  end = data + length;
+  if (length < 4 || data[0] != '/' || (length & 3)) return false;
+  
+  size_t size = stringSize(data, end);
+  if (!size) return false;
+  address = (const char*)data;
+  const uint8_t* p = data + size;
+  
+  // Type tags are optional in old senders; treat their absence as no arguments
+  if (p == end || *p != ',') {
+    types = "";
+    args = p;
+    count = 0;
+    return true;
+  }
+  size = stringSize(p, end);
+  if (!size) return false;
+  types = (const char*)p + 1;
+  args = p + size;
+  count = strlen(types);
+  
+  // Check every argument is inside the packet
+  const uint8_t* a = args;
+  for (int i = 0; i < count; i++) {
+    switch (types[i]) {
+      case 'i':
+      case 'f':
+        a += 4;
+        break;
+      case 's':
+        size = stringSize(a, end);
+        if (!size) return false;
+        a += size;
+        break;
+      default:
+        count = i;  // Stop at types we don't read
+        return true;
+    }
+    if (a > end) return false;
+  }
+  return true;
+}
+
+const uint8_t* OscMessage::argument(int index) const {
+  if (index < 0 || index >= count) return nullptr;
+  const uint8_t* a = args;
+  for (int i = 0; i < index; i++) {
+    a += (types[i] == 's') ? stringSize(a, end) : 4;
+  }
+  return a;
+}
+
+bool OscMessage::getInt(int index, int32_t& value) const {
+  const uint8_t* a = argument(index);
+  if (!a) return false;
+  if (types[index] == 'i') {
+    value = (int32_t)get32(a);
+    return true;
+  }
+  float f;
+  if (!getFloat(index, f) || f != f) return false;  // NaN has no integer value
+  // Clamp before converting: an out of range float to int32_t is undefined.
+  // 2147483520 is the largest float below 2^31.
+  f = f < 0 ? f - 0.5f : f + 0.5f;
+  if (f <= -2147483648.0f) {
+    value = INT32_MIN;
+  } else if (f >= 2147483520.0f) {
+    value = INT32_MAX;
+  } else {
+    value = (int32_t)f;
+  }
+  return true;
+}
+
+bool OscMessage::getFloat(int index, float& value) const {
+  const uint8_t* a = argument(index);
+  if (!a) return false;
+  if (types[index] == 'f') {
+    uint32_t bits = get32(a);
+    memcpy(&value, &bits, 4);
+    return true;
+  }
+  if (types[index] == 'i') {
+    value = (float)(int32_t)get32(a);
+    return true;
+  }
+  return false;
+}
+
+bool OscMessage::getString(int index, const char*& value) const {
+  const uint8_t* a = argument(index);
+  if (!a || types[index] != 's') return false;
+  value = (const char*)a;
+  return true;
+}
+
+static bool dispatch(const uint8_t* data, size_t length, OscMessageHandler handler,
+                     void* context, int depth) {
+  if (length >= 16 && memcmp(data, "#bundle", 8) == 0) {
+    if (depth >= OSC_MAX_DEPTH) return false;
+    // Timetags are ignored: everything is applied on arrival
+    size_t pos = 16;
+    while (pos + 4 <= length) {
+      uint32_t size = get32(data + pos);
+      pos += 4;
+      if (size > length - pos) return false;
+      if (!dispatch(data + pos, size, handler, context, depth + 1)) return false;
+      pos += size;
+    }
+    return pos == length;
+  }
+  
+  OscMessage message;
+  if (!message.parse(data, length)) return false;
+  handler(message, context);
+  return true;
+}
+
+bool oscDispatch(const uint8_t* data, size_t length, OscMessageHandler handler, void* context) {
+  return dispatch(data, length, handler, context, 0);
+}
+
+// Routing
+
+// Parameters are int16
+static int32_t clampValue(int32_t value) {
+  return value < -32768 ? -32768 : (value > 32767 ? 32767 : value);
+}
+
+OscRoute oscRoute(const OscMessage& message) {
+  OscRoute route = {OscRoute::NONE, nullptr, -1, 0};
+  const char* address = message.address;
+  int32_t value = 0;
+  
+  if (strncmp(address, "/param/", 7) == 0) {
+    if (!message.getInt(0, value)) return route;
+    route.kind = OscRoute::PARAM_NAME;
+    route.name = address + 7;
+    route.value = clampValue(value);
+  } else if (strcmp(address, "/param") == 0) {
+    if (!message.getInt(0, route.id) || !message.getInt(1, value)) return route;
+    if (route.id < 0 || route.id > 255) return route;
+    route.kind = OscRoute::PARAM_ID;
+    route.value = clampValue(value);
+  } else if (strcmp(address, "/transport/play") == 0) {
+    if (!message.getInt(0, value)) return route;
+    route.kind = OscRoute::PLAY;
+    route.value = value != 0;
+  } else if (strcmp(address, "/transport/bpm") == 0) {
+    if (!message.getInt(0, value)) return route;
+    route.kind = OscRoute::BPM;
+    route.value = clampValue(value);
+  } else if (strcmp(address, "/cyd/subscribe") == 0) {
+    route.kind = OscRoute::SUBSCRIBE;
+    if (message.getInt(0, value) && value > 0 && value <= 65535) route.value = value;
+  } else if (strcmp(address, "/cyd/unsubscribe") == 0) {
+    route.kind = OscRoute::UNSUBSCRIBE;
+  }
+  return route;
+}
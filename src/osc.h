@@ -0,0 +1,89 @@
+#ifndef OSC_H
+#define OSC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Open Sound Control 1.0 encoding and decoding
+// Works in place on caller-owned buffers: nothing is allocated, and decoded
+// strings point into the packet. Supports int32 ('i'), float32 ('f') and
+// string ('s') arguments, messages and (nested) bundles.
+
+// Writes one message, or a bundle of messages, into a fixed buffer. Outgoing
+// arguments are int32/float32 only. If a message doesn't fit,
+// beginMessage() returns false and the buffer keeps the ones written so far.
+class OscWriter {
+public:
+  OscWriter(uint8_t* buffer, size_t capacity);
+  
+  void reset();
+  // Call first to collect the following messages into one bundle.
+  // Timetag 1 means "immediately".
+  void beginBundle(uint64_t timetag = 1);
+  // 'types' without the leading comma, e.g. "iif"; add exactly those arguments
+  bool beginMessage(const char* address, const char* types);
+  void addInt(int32_t value);
+  void addFloat(float value);
+  void endMessage();
+  
+  size_t length() const { return used; }
+  int messageCount() const { return messages; }
+  const uint8_t* data() const { return buffer; }
+
+private:
+  bool reserve(size_t bytes);
+  void putString(const char* value);
+  void put32(uint32_t value);
+  
+  uint8_t* buffer;
+  size_t capacity;
+  size_t used;
+  size_t sizeField;   // Offset of the open bundle element's size
+  bool inBundle;
+  int messages;
+};
+
+// A decoded message; arguments are read by index
+class OscMessage {
+public:
+  const char* address;
+  const char* types;  // Without the leading comma
+  
+  int argCount() const { return count; }
+  // Numeric arguments convert between int and float
+  bool getInt(int index, int32_t& value) const;
+  bool getFloat(int index, float& value) const;
+  bool getString(int index, const char*& value) const;
+  
+  // Parses one message (not a bundle)
+  bool parse(const uint8_t* data, size_t length);
+
+private:
+  const uint8_t* argument(int index) const;
+  
+  const uint8_t* args;
+  const uint8_t* end;
+  int count;
+};
+
+typedef void (*OscMessageHandler)(const OscMessage& message, void* context);
+
+// Calls 'handler' for every message in a packet, unpacking bundles.
+// Returns false if the packet is malformed (messages before the fault are
+// still delivered).
+bool oscDispatch(const uint8_t* data, size_t length, OscMessageHandler handler, void* context);
+
+// What an incoming control message asks the bridge to do (see osc_bridge.h
+// for the addresses). Values are clamped to a parameter's int16 range.
+struct OscRoute {
+  enum Kind : uint8_t { NONE, PARAM_NAME, PARAM_ID, PLAY, BPM, SUBSCRIBE, UNSUBSCRIBE };
+  Kind kind;
+  const char* name;  // PARAM_NAME: what follows "/param/", points into the message
+  int32_t id;        // PARAM_ID: 0-255
+  int32_t value;     // New value (PLAY: 0 or 1); SUBSCRIBE: reply port, 0 if not given
+};
+
+// NONE for unknown addresses, missing arguments or an out-of-range id
+OscRoute oscRoute(const OscMessage& message);
+
+#endif // OSC_H
@@ -0,0 +1,225 @@
+#include "osc_bridge.h"
+#include "param_registry.h"
+
+WiFiUDP OscBridge::udp;
+QueueHandle_t OscBridge::eventQueue = nullptr;
+SemaphoreHandle_t OscBridge::oscMutex = nullptr;
+bool OscBridge::running = false;
+OscBridge::Target OscBridge::targets[OSC_MAX_TARGETS];
+volatile int OscBridge::targetCount = 0;
+uint8_t OscBridge::outBuffer[OSC_PACKET_SIZE];
+uint8_t OscBridge::inBuffer[OSC_PACKET_SIZE];
+OscWriter OscBridge::writer(OscBridge::outBuffer, OSC_PACKET_SIZE);
+int OscBridge::lastPlaying = -1;
+int OscBridge::lastBpm = -1;
+uint32_t OscBridge::bundlesSent = 0;
+uint32_t OscBridge::eventsDropped = 0;
+
+// Sender of the packet being handled
+struct OscSender {
+  uint32_t address;
+  uint16_t port;
+};
+
+void OscBridge::begin() {
+  if (!oscMutex) {
+    oscMutex = xSemaphoreCreateMutex();
+    eventQueue = xQueueCreate(OSC_QUEUE_LENGTH, sizeof(Event));
+    xTaskCreatePinnedToCore(oscTask, "OscTask", OSC_TASK_STACK, nullptr,
+                            OSC_TASK_PRIORITY, nullptr, OSC_TASK_CORE);
+  }
+  
+  xSemaphoreTake(oscMutex, portMAX_DELAY);
+  if (!running) {
+    udp.begin(OSC_IN_PORT);
+    running = true;
+    Serial.printf("OSC on UDP %d (replies to port %d)\n", OSC_IN_PORT, OSC_OUT_PORT);
+  }
+  xSemaphoreGive(oscMutex);
+}
+
+void OscBridge::stop() {
+  if (!oscMutex) return;
+  xSemaphoreTake(oscMutex, portMAX_DELAY);
+  if (running) {
+    udp.stop();
+    targetCount = 0;
+    running = false;
+    xQueueReset(eventQueue);
+    Serial.printf("OSC stopped (%u bundles sent, %u events dropped)\n",
+                  (unsigned)bundlesSent, (unsigned)eventsDropped);
+  }
+  xSemaphoreGive(oscMutex);
+}
+
+void OscBridge::send(const uint8_t* message, size_t length) {
+  if (targetCount == 0 || length == 0 || length > 3) return;
+  if (message[0] == 0xF8) return;  // Clock isn't mirrored
+  Event event;
+  event.length = length;
+  memcpy(event.data, message, length);
+  if (xQueueSend(eventQueue, &event, 0) != pdTRUE) eventsDropped++;
+}
+
+void OscBridge::oscTask(void* parameter) {
+  while (true) {
+    xSemaphoreTake(oscMutex, portMAX_DELAY);
+    if (running) {
+      receive();
+    }
+    if (running && targetCount > 0) {
+      // Everything from this tick goes out as one bundle
+      writer.beginBundle();
+      Event event;
+      while (xQueueReceive(eventQueue, &event, 0) == pdTRUE) {
+        writeEvent(event);
+      }
+      writeTransport();
+      flush();
+    }
+    xSemaphoreGive(oscMutex);
+    vTaskDelay(OSC_TICK_MS / portTICK_PERIOD_MS);
+  }
+}
+
+void OscBridge::receive() {
+  int size;
+  while ((size = udp.parsePacket()) > 0) {
+    int length = udp.read(inBuffer, sizeof(inBuffer));
+    if (length <= 0 || size > (int)sizeof(inBuffer)) continue;  // Drop oversized packets
+    OscSender sender = {(uint32_t)udp.remoteIP(), udp.remotePort()};
+    addTarget(sender.address, OSC_OUT_PORT, false);
+    if (!oscDispatch(inBuffer, length, handleMessage, &sender)) {
+      Serial.println("OSC: malformed packet from " + udp.remoteIP().toString());
+    }
+  }
+}
+
+void OscBridge::handleMessage(const OscMessage& message, void* context) {
+  const OscSender& sender = *(const OscSender*)context;
+  OscRoute route = oscRoute(message);
+  int id = -1;
+  
+  switch (route.kind) {
+    case OscRoute::PARAM_NAME:
+      id = ParamRegistry::find(route.name);
+      break;
+    case OscRoute::PARAM_ID:
+      id = route.id;
+      break;
+    case OscRoute::PLAY:
+      id = ParamRegistry::findInMode(currentMode, ".playing");
+      break;
+    case OscRoute::BPM:
+      id = ParamRegistry::findInMode(currentMode, ".bpm");
+      break;
+    case OscRoute::SUBSCRIBE:
+      addTarget(sender.address, route.value ? route.value : OSC_OUT_PORT, true);
+      return;
+    case OscRoute::UNSUBSCRIBE:
+      removeTarget(sender.address);
+      return;
+    case OscRoute::NONE:
+      return;
+  }
+  
+  if (id < 0 || id > 255) return;
+  ParamRegistry::submit(id, route.value);
+}
+
+void OscBridge::addTarget(uint32_t address, uint16_t port, bool replacePort) {
+  for (int i = 0; i < targetCount; i++) {
+    if (targets[i].address == address) {
+      if (replacePort) targets[i].port = port;
+      return;
+    }
+  }
+  if (targetCount >= OSC_MAX_TARGETS) return;
+  targets[targetCount] = {address, port};
+  targetCount = targetCount + 1;
+  lastPlaying = -1;  // Send the transport state to the newcomer
+  lastBpm = -1;
+  Serial.printf("OSC: sending to %s:%u\n", IPAddress(address).toString().c_str(), port);
+}
+
+void OscBridge::removeTarget(uint32_t address) {
+  for (int i = 0; i < targetCount; i++) {
+    if (targets[i].address == address) {
+      targets[i] = targets[targetCount - 1];
+      targetCount = targetCount - 1;
+      return;
+    }
+  }
+}
+
+// Starts a message in the current bundle, sending the bundle first if it's full
+bool OscBridge::beginMessage(const char* address, const char* types) {
+  if (writer.beginMessage(address, types)) return true;
+  flush();
+  writer.beginBundle();
+  return writer.beginMessage(address, types);
+}
+
+void OscBridge::writeEvent(const Event& event) {
+  uint8_t status = event.data[0] & 0xF0;
+  int32_t channel = (event.data[0] & 0x0F) + 1;
+  
+  switch (status) {
+    case 0x90:
+    case 0x80:
+      if (!beginMessage("/midi/note", "iii")) return;
+      writer.addInt(channel);
+      writer.addInt(event.data[1]);
+      writer.addInt(status == 0x90 ? event.data[2] : 0);
+      break;
+    case 0xB0:
+      if (!beginMessage("/midi/cc", "iii")) return;
+      writer.addInt(channel);
+      writer.addInt(event.data[1]);
+      writer.addInt(event.data[2]);
+      break;
+    case 0xE0:
+      if (!beginMessage("/midi/bend", "ii")) return;
+      writer.addInt(channel);
+      writer.addInt(((event.data[2] << 7) | event.data[1]) - 8192);
+      break;
+    default:
+      if (event.data[0] == 0xFA || event.data[0] == 0xFC) {
+        const char* address = event.data[0] == 0xFA ? "/transport/start" : "/transport/stop";
+        if (!beginMessage(address, "")) return;
+        break;
+      }
+      return;
+  }
+  writer.endMessage();
+}
+
+// Reports the current mode's sequencer state when it changes
+void OscBridge::writeTransport() {
+  int playingId = ParamRegistry::findInMode(currentMode, ".playing");
+  int bpmId = ParamRegistry::findInMode(currentMode, ".bpm");
+  int playing = playingId >= 0 ? ParamRegistry::info(playingId)->get() : 0;
+  int bpm = bpmId >= 0 ? ParamRegistry::info(bpmId)->get() : 0;
+  
+  if (playing != lastPlaying && beginMessage("/transport/playing", "i")) {
+    writer.addInt(playing);
+    writer.endMessage();
+    lastPlaying = playing;
+  }
+  if (bpm != lastBpm && bpm > 0 && beginMessage("/transport/bpm", "i")) {
+    writer.addInt(bpm);
+    writer.endMessage();
+    lastBpm = bpm;
+  }
+}
+
+void OscBridge::flush() {
+  if (writer.messageCount() == 0) return;
+  for (int i = 0; i < targetCount; i++) {
+    udp.beginPacket(IPAddress(targets[i].address), targets[i].port);
+    udp.write(writer.data(), writer.length());
+    udp.endPacket();
+  }
+  writer.reset();
+  bundlesSent++;
+}
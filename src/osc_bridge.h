@@ -0,0 +1,83 @@
+#ifndef OSC_BRIDGE_H
+#define OSC_BRIDGE_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include "osc.h"
+
+// OSC over UDP
+// Listens on OSC_IN_PORT. Any sender becomes a target and gets our output on
+// OSC_OUT_PORT (or the port from /cyd/subscribe), up to OSC_MAX_TARGETS.
+//
+// Output, one bundle per OSC_TICK_MS holding everything since the last one:
+//   /midi/note iii       channel (1-16), note, velocity (0 = off)
+//   /midi/cc iii         channel, controller, value
+//   /midi/bend ii        channel, -8192..8191
+//   /transport/start, /transport/stop   (MIDI start/stop)
+//   /transport/playing i, /transport/bpm i   current mode's sequencer, on change
+// MIDI clock is not mirrored.
+//
+// Input (int or float arguments):
+//   /param/<name> v      e.g. /param/grids.patternX 200 (see ParamRegistry)
+//   /param ii            id, value
+//   /transport/play i    start (1) or stop (0) the current mode's sequencer
+//   /transport/bpm v     tempo of the current mode's sequencer
+//   /cyd/subscribe [i]   send output to this sender, optionally on another port
+//   /cyd/unsubscribe
+// Changes go through ParamRegistry, so the loop applies them.
+#define OSC_IN_PORT        8000
+#define OSC_OUT_PORT       9000
+#define OSC_MAX_TARGETS    4
+#define OSC_QUEUE_LENGTH   64
+#define OSC_PACKET_SIZE    512
+#define OSC_TICK_MS        10
+#define OSC_TASK_STACK     4096
+#define OSC_TASK_PRIORITY  1
+#define OSC_TASK_CORE      0
+
+class OscBridge {
+public:
+  // Call once WiFi is up (web task)
+  static void begin();
+  static void stop();
+  static bool hasTargets() { return targetCount > 0; }
+  // Any task: queue one complete MIDI message (1-3 bytes) for mirroring
+  static void send(const uint8_t* message, size_t length);
+
+private:
+  struct Event {
+    uint8_t length;
+    uint8_t data[3];
+  };
+  
+  struct Target {
+    uint32_t address;
+    uint16_t port;
+  };
+  
+  static void oscTask(void* parameter);
+  static void receive();
+  static void handleMessage(const OscMessage& message, void* context);
+  static void addTarget(uint32_t address, uint16_t port, bool replacePort);
+  static void removeTarget(uint32_t address);
+  static bool beginMessage(const char* address, const char* types);
+  static void writeEvent(const Event& event);
+  static void writeTransport();
+  static void flush();
+  
+  static WiFiUDP udp;
+  static QueueHandle_t eventQueue;
+  static SemaphoreHandle_t oscMutex;
+  static bool running;
+  static Target targets[OSC_MAX_TARGETS];
+  static volatile int targetCount;
+  static uint8_t outBuffer[OSC_PACKET_SIZE];
+  static uint8_t inBuffer[OSC_PACKET_SIZE];
+  static OscWriter writer;
+  static int lastPlaying;
+  static int lastBpm;
+  static uint32_t bundlesSent;
+  static uint32_t eventsDropped;
+};
+
+#endif // OSC_BRIDGE_H
@@ -0,0 +1,132 @@
+#include "param_control.h"
+#include "websocket.h"
+
+WiFiServer ParamControl::wsServer(PARAM_CONTROL_PORT);
+WiFiClient ParamControl::clients[PARAM_CONTROL_MAX_CLIENTS];
+bool ParamControl::running = false;
+unsigned long ParamControl::lastBroadcastTime = 0;
+int16_t ParamControl::lastSent[PARAM_MAX_COUNT];
+
+void ParamControl::begin() {
+  if (running) return;
+  for (int id = 0; id < ParamRegistry::count(); id++) {
+    lastSent[id] = ParamRegistry::info(id)->get();
+  }
+  wsServer.begin();
+  wsServer.setNoDelay(true);
+  running = true;
+  Serial.printf("Parameter control on ws://<ip>:%d (%d parameters)\n",
+                PARAM_CONTROL_PORT, ParamRegistry::count());
+}
+
+void ParamControl::stop() {
+  if (!running) return;
+  for (int slot = 0; slot < PARAM_CONTROL_MAX_CLIENTS; slot++) dropClient(slot);
+  wsServer.stop();
+  running = false;
+}
+
+void ParamControl::update() {
+  if (!running) return;
+  
+  WiFiClient incoming = wsServer.available();
+  if (incoming && WebSocket::accept(incoming)) {
+    int free = -1;
+    for (int slot = 0; slot < PARAM_CONTROL_MAX_CLIENTS; slot++) {
+      if (!clients[slot] || !clients[slot].connected()) {
+        free = slot;
+        break;
+      }
+    }
+    if (free < 0) {
+      Serial.println("Parameter control: too many clients");
+      incoming.stop();
+    } else {
+      dropClient(free);
+      clients[free] = incoming;
+      Serial.println("Parameter control: client connected from " + incoming.remoteIP().toString());
+    }
+  }
+  
+  for (int slot = 0; slot < PARAM_CONTROL_MAX_CLIENTS; slot++) {
+    if (!clients[slot]) continue;
+    if (!clients[slot].connected()) {
+      Serial.println("Parameter control: client disconnected");
+      dropClient(slot);
+      continue;
+    }
+    pollClient(slot);
+  }
+  
+  if (millis() - lastBroadcastTime < PARAM_CONTROL_BROADCAST_MS) return;
+  lastBroadcastTime = millis();
+  broadcastChanges();
+}
+
+void ParamControl::pollClient(int slot) {
+  uint8_t payload[PARAM_RECORD_SIZE * PARAM_MAX_COUNT];
+  size_t length;
+  while (clients[slot]) {
+    int opcode = WebSocket::poll(clients[slot], payload, sizeof(payload), length);
+    if (opcode < 0) {
+      dropClient(slot);
+    } else if (opcode == 0) {
+      break;
+    } else if (opcode == WebSocket::OP_TEXT) {
+      if (length == 4 && memcmp(payload, "list", 4) == 0) sendList(slot);
+    } else if (opcode == WebSocket::OP_BINARY) {
+      for (size_t i = 0; i + PARAM_RECORD_SIZE <= length; i += PARAM_RECORD_SIZE) {
+        int16_t value = (int16_t)(payload[i + 1] | (payload[i + 2] << 8));
+        if (!ParamRegistry::submit(payload[i], value)) {
+          Serial.printf("Parameter control: change to %u rejected\n", payload[i]);
+        }
+      }
+    }
+  }
+}
+
+void ParamControl::sendList(int slot) {
+  // Values are read without syncing with the loop; a stale one is corrected
+  // by the next broadcast
+  String json = "[";
+  for (int id = 0; id < ParamRegistry::count(); id++) {
+    const ParamInfo* p = ParamRegistry::info(id);
+    if (id > 0) json += ",";
+    json += "{\"id\":" + String(id) + ",\"name\":\"" + p->name + "\",\"min\":" + String(p->min) +
+            ",\"max\":" + String(p->max) + ",\"value\":" + String(p->get()) + "}";
+  }
+  json += "]";
+  sendFrame(slot, WebSocket::OP_TEXT, (const uint8_t*)json.c_str(), json.length());
+}
+
+void ParamControl::broadcastChanges() {
+  uint8_t records[PARAM_RECORD_SIZE * PARAM_MAX_COUNT];
+  size_t used = 0;
+  for (int id = 0; id < ParamRegistry::count(); id++) {
+    int16_t value = ParamRegistry::info(id)->get();
+    if (value == lastSent[id]) continue;
+    lastSent[id] = value;
+    records[used++] = id;
+    records[used++] = value & 0xFF;
+    records[used++] = (value >> 8) & 0xFF;
+  }
+  if (used == 0) return;
+  
+  for (int slot = 0; slot < PARAM_CONTROL_MAX_CLIENTS; slot++) {
+    if (clients[slot]) sendFrame(slot, WebSocket::OP_BINARY, records, used);
+  }
+}
+
+bool ParamControl::sendFrame(int slot, uint8_t opcode, const uint8_t* data, size_t length) {
+  if (!WebSocket::send(clients[slot], opcode, data, length)) {
+    Serial.println("Parameter control: send failed, dropping client");
+    dropClient(slot);
+    return false;
+  }
+  return true;
+}
+
+void ParamControl::dropClient(int slot) {
+  if (clients[slot]) clients[slot].stop();
+  clients[slot] = WiFiClient();
+}
@@ -0,0 +1,49 @@
+#ifndef PARAM_CONTROL_H
+#define PARAM_CONTROL_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "param_registry.h"
+
+// Remote parameter control over WebSocket
+// Exposes the ParamRegistry on PARAM_CONTROL_PORT to up to
+// PARAM_CONTROL_MAX_CLIENTS clients (a laptop or tablet control surface).
+//
+// Client -> device:
+//   text "list"  -> text reply, JSON array of
+//                   {"id":0,"name":"grids.patternX","min":0,"max":255,"value":128}
+//   binary       -> any number of 3-byte records: u8 id, i16 value (little-endian)
+// Device -> client:
+//   binary       -> the same records for every parameter whose value changed,
+//                   checked every PARAM_CONTROL_BROADCAST_MS. This confirms
+//                   remote changes once applied and follows on-device edits.
+//
+// Values are clamped to the parameter's range and applied by the loop at the
+// owning mode's next step (see ParamRegistry).
+#define PARAM_CONTROL_PORT          82
+#define PARAM_CONTROL_MAX_CLIENTS   4
+#define PARAM_CONTROL_BROADCAST_MS  100
+#define PARAM_RECORD_SIZE           3
+
+class ParamControl {
+public:
+  static void begin();
+  static void stop();
+  // Call from the web task
+  static void update();
+  
+private:
+  static void pollClient(int slot);
+  static void sendList(int slot);
+  static void broadcastChanges();
+  static bool sendFrame(int slot, uint8_t opcode, const uint8_t* data, size_t length);
+  static void dropClient(int slot);
+  
+  static WiFiServer wsServer;
+  static WiFiClient clients[PARAM_CONTROL_MAX_CLIENTS];
+  static bool running;
+  static unsigned long lastBroadcastTime;
+  static int16_t lastSent[PARAM_MAX_COUNT];
+};
+
+#endif // PARAM_CONTROL_H
@@ -0,0 +1,118 @@
+#include "param_registry.h"
+
+ParamInfo ParamRegistry::params[PARAM_MAX_COUNT];
+int ParamRegistry::paramCount = 0;
+int16_t ParamRegistry::pendingValue[PARAM_MAX_COUNT] = {0};
+bool ParamRegistry::pending[PARAM_MAX_COUNT] = {false};
+ParamRefresh ParamRegistry::refreshPending[PARAM_MAX_REFRESH] = {nullptr};
+AppMode ParamRegistry::refreshMode[PARAM_MAX_REFRESH];
+int ParamRegistry::refreshCount = 0;
+QueueHandle_t ParamRegistry::changeQueue = nullptr;
+AppMode ParamRegistry::lastTickMode = MENU;
+unsigned long ParamRegistry::lastTickTime = 0;
+
+int ParamRegistry::add(const char* name, AppMode mode, int16_t min, int16_t max, bool onTick,
+                       ParamGetter get, ParamSetter set, ParamRefresh refresh) {
+  if (paramCount >= PARAM_MAX_COUNT) {
+    Serial.printf("ParamRegistry: full, %s not published\n", name);
+    return -1;
+  }
+  if (!changeQueue) {
+    changeQueue = xQueueCreate(PARAM_QUEUE_LENGTH, sizeof(Change));
+  }
+  params[paramCount] = {name, mode, min, max, onTick, get, set, refresh};
+  return paramCount++;
+}
+
+const ParamInfo* ParamRegistry::info(int id) {
+  return (id >= 0 && id < paramCount) ? &params[id] : nullptr;
+}
+
+int ParamRegistry::find(const char* name) {
+  for (int id = 0; id < paramCount; id++) {
+    if (strcmp(params[id].name, name) == 0) return id;
+  }
+  return -1;
+}
+
+int ParamRegistry::findInMode(AppMode mode, const char* suffix) {
+  size_t suffixLength = strlen(suffix);
+  for (int id = 0; id < paramCount; id++) {
+    size_t nameLength = strlen(params[id].name);
+    if (params[id].mode == mode && nameLength >= suffixLength &&
+        strcmp(params[id].name + nameLength - suffixLength, suffix) == 0) {
+      return id;
+    }
+  }
+  return -1;
+}
+
+bool ParamRegistry::submit(uint8_t id, int16_t value) {
+  if (id >= paramCount || !changeQueue) return false;
+  Change change = {id, value};
+  return xQueueSend(changeQueue, &change, 0) == pdTRUE;
+}
+
+void ParamRegistry::service() {
+  if (!changeQueue) return;
+  
+  // Steps apply their params on the clock task (applyTick)
+  StepClock::lock();
+  
+  // Later changes to the same parameter replace earlier ones
+  Change change;
+  while (xQueueReceive(changeQueue, &change, 0) == pdTRUE) {
+    const ParamInfo& p = params[change.id];
+    pendingValue[change.id] = constrain(change.value, p.min, p.max);
+    pending[change.id] = true;
+  }
+  
+  // The current mode's tick-synced params wait for its step, unless it
+  // has stopped stepping
+  bool ticking = lastTickMode == currentMode && millis() - lastTickTime < PARAM_TICK_TIMEOUT;
+  apply(false, ticking ? currentMode : (AppMode)-1);
+  
+  // Redraws queued here or by the last step
+  ParamRefresh refreshes[PARAM_MAX_REFRESH];
+  int count = 0;
+  for (int i = 0; i < refreshCount; i++) {
+    if (refreshMode[i] == currentMode) refreshes[count++] = refreshPending[i];
+  }
+  refreshCount = 0;
+  StepClock::unlock();
+  
+  // Draw without holding up the clock
+  for (int i = 0; i < count; i++) refreshes[i]();
+}
+
+void ParamRegistry::applyTick(AppMode mode) {
+  lastTickMode = mode;
+  lastTickTime = millis();
+  apply(true, mode);
+}
+
+// tickOnly: apply the onTick params of 'mode'.
+// Otherwise: apply everything except the onTick params of 'mode'.
+// Redraws are only queued; a step must not wait for the display.
+void ParamRegistry::apply(bool tickOnly, AppMode mode) {
+  for (int id = 0; id < paramCount; id++) {
+    if (!pending[id]) continue;
+    const ParamInfo& p = params[id];
+    bool tickParam = p.onTick && p.mode == mode;
+    if (tickParam != tickOnly) continue;
+    
+    p.set(pendingValue[id]);
+    pending[id] = false;
+    
+    // Queue each redraw once
+    if (p.refresh && p.mode == currentMode) {
+      bool seen = false;
+      for (int i = 0; i < refreshCount; i++) seen |= refreshPending[i] == p.refresh;
+      if (!seen && refreshCount < PARAM_MAX_REFRESH) {
+        refreshPending[refreshCount] = p.refresh;
+        refreshMode[refreshCount] = p.mode;
+        refreshCount++;
+      }
+    }
+  }
+}
@@ -0,0 +1,80 @@
+#ifndef PARAM_REGISTRY_H
+#define PARAM_REGISTRY_H
+
+#include "common_definitions.h"
+
+// Remote parameter registry
+// Modes publish their tweakable parameters once at boot (publishXParams()).
+// Each gets a small integer id, in registration order. Values are int16;
+// non-integer parameters are published scaled (e.g. lfo.rate in 0.1 Hz).
+//
+// Remote changes arrive on the web task through submit() and are queued. The
+// loop drains the queue in service() and keeps the latest value per
+// parameter. Parameters of the mode on screen that are marked onTick are
+// applied by the mode itself at its next step (applyTick()), so a pattern
+// never changes mid-step; if that mode hasn't stepped for PARAM_TICK_TIMEOUT
+// (transport stopped) they are applied straight away. Everything else is
+// applied on the next loop pass. Refresh functions never run inside a step:
+// applying a batch only queues them, and service() calls each queued one once
+// on the loop, if its mode is still on screen. Tick-synced parameters should
+// use a refresh that repaints just what they change.
+#define PARAM_MAX_COUNT     32
+#define PARAM_QUEUE_LENGTH  32
+#define PARAM_TICK_TIMEOUT  500  // ms
+#define PARAM_MAX_REFRESH   8    // Distinct refresh functions queued between loop passes
+
+typedef int16_t (*ParamGetter)();
+typedef void (*ParamSetter)(int16_t value);
+typedef void (*ParamRefresh)();
+
+struct ParamInfo {
+  const char* name;     // "mode.param", must be a string literal
+  AppMode mode;         // Owning mode
+  int16_t min;
+  int16_t max;
+  bool onTick;          // Apply at the owning mode's next step
+  ParamGetter get;
+  ParamSetter set;      // Loop, or the step clock for onTick params; value already clamped
+  ParamRefresh refresh; // Redraw after changes while the mode is shown, on the loop (optional)
+};
+
+class ParamRegistry {
+public:
+  // Returns the new parameter's id, or -1 if the registry is full
+  static int add(const char* name, AppMode mode, int16_t min, int16_t max, bool onTick,
+                 ParamGetter get, ParamSetter set, ParamRefresh refresh = nullptr);
+  static int count() { return paramCount; }
+  static const ParamInfo* info(int id);
+  // Id by full name ("grids.patternX"), or -1
+  static int find(const char* name);
+  // Id of the parameter of 'mode' whose name ends in 'suffix' (".playing"), or -1
+  static int findInMode(AppMode mode, const char* suffix);
+  
+  // Any task: queue a new value. False for unknown ids or a full queue.
+  static bool submit(uint8_t id, int16_t value);
+  // Loop, every pass
+  static void service();
+  // Mode step code (clock task, under StepClock's lock), just before the step is played
+  static void applyTick(AppMode mode);
+  
+private:
+  struct Change {
+    uint8_t id;
+    int16_t value;
+  };
+  
+  static void apply(bool tickOnly, AppMode mode);
+  
+  static ParamInfo params[PARAM_MAX_COUNT];
+  static int paramCount;
+  static int16_t pendingValue[PARAM_MAX_COUNT];
+  static bool pending[PARAM_MAX_COUNT];
+  static ParamRefresh refreshPending[PARAM_MAX_REFRESH];
+  static AppMode refreshMode[PARAM_MAX_REFRESH];
+  static int refreshCount;
+  static QueueHandle_t changeQueue;
+  static AppMode lastTickMode;
+  static unsigned long lastTickTime;
+};
+
+#endif // PARAM_REGISTRY_H
@@ -0,0 +1,104 @@
+#include "qoi_encoder.h"
+#include <string.h>
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xC0
+#define QOI_OP_RGB   0xFE
+#define QOI_MAX_RUN  62
+
+QoiEncoder::QoiEncoder(WriteCallback write, void* context)
+  : writeCallback(write), writeContext(context), previous(0x000000FF), run(0), bufferUsed(0), bytesWritten(0) {
+  memset(index, 0, sizeof(index));
+}
+
+void QoiEncoder::begin(uint32_t width, uint32_t height) {
+  memset(index, 0, sizeof(index));
+  previous = 0x000000FF;  // Spec start pixel is r=0 g=0 b=0 a=255
+  run = 0;
+  bufferUsed = 0;
+  bytesWritten = 0;
+  
+  putByte('q'); putByte('o'); putByte('i'); putByte('f');
+  for (int shift = 24; shift >= 0; shift -= 8) putByte((width >> shift) & 0xFF);
+  for (int shift = 24; shift >= 0; shift -= 8) putByte((height >> shift) & 0xFF);
+  putByte(3);  // Channels: RGB
+  putByte(0);  // Colorspace: sRGB with linear alpha
+}
+
+void QoiEncoder::addPixels(const uint16_t* pixels, size_t count, bool swapped) {
+  for (size_t i = 0; i < count; i++) {
+    uint16_t color = swapped ? (uint16_t)((pixels[i] >> 8) | (pixels[i] << 8)) : pixels[i];
+    // Expand 565 to 888 by replicating the top bits so white stays 255
+    uint8_t r = (color >> 11) & 0x1F;
+    uint8_t g = (color >> 5) & 0x3F;
+    uint8_t b = color & 0x1F;
+    encodePixel((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+  }
+}
+
+void QoiEncoder::encodePixel(uint8_t r, uint8_t g, uint8_t b) {
+  // Alpha is kept in the packed value: a decoder's index starts out as
+  // RGBA 0,0,0,0, so an empty slot must never match opaque black
+  uint32_t pixel = ((uint32_t)r << 24) | ((uint32_t)g << 16) | ((uint32_t)b << 8) | 0xFF;
+  
+  if (pixel == previous) {
+    run++;
+    if (run == QOI_MAX_RUN) putRun();
+    return;
+  }
+  if (run > 0) putRun();
+  
+  // Alpha is always 255, so it contributes a constant 255 * 11 to the hash
+  uint8_t slot = (r * 3 + g * 5 + b * 7 + 255 * 11) % 64;
+  if (index[slot] == pixel) {
+    putByte(QOI_OP_INDEX | slot);
+  } else {
+    index[slot] = pixel;
+    
+    int8_t dr = (int8_t)(r - ((previous >> 24) & 0xFF));
+    int8_t dg = (int8_t)(g - ((previous >> 16) & 0xFF));
+    int8_t db = (int8_t)(b - ((previous >> 8) & 0xFF));
+    int8_t drDg = dr - dg;
+    int8_t dbDg = db - dg;
+    
+    if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+      putByte(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+    } else if (drDg > -9 && drDg < 8 && dg > -33 && dg < 32 && dbDg > -9 && dbDg < 8) {
+      putByte(QOI_OP_LUMA | (dg + 32));
+      putByte(((drDg + 8) << 4) | (dbDg + 8));
+    } else {
+      putByte(QOI_OP_RGB);
+      putByte(r);
+      putByte(g);
+      putByte(b);
+    }
+  }
+  previous = pixel;
+}
+
+void QoiEncoder::end() {
+  if (run > 0) putRun();
+  // End marker: seven 0x00 bytes followed by 0x01
+  for (int i = 0; i < 7; i++) putByte(0x00);
+  putByte(0x01);
+  flush();
+}
+
+void QoiEncoder::putRun() {
+  putByte(QOI_OP_RUN | (run - 1));
+  run = 0;
+}
+
+void QoiEncoder::putByte(uint8_t value) {
+  buffer[bufferUsed++] = value;
+  if (bufferUsed == QOI_OUTPUT_BUFFER) flush();
+}
+
+void QoiEncoder::flush() {
+  if (bufferUsed == 0) return;
+  writeCallback(buffer, bufferUsed, writeContext);
+  bytesWritten += bufferUsed;
+  bufferUsed = 0;
+}
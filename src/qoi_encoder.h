@@ -0,0 +1,45 @@
+#ifndef QOI_ENCODER_H
+#define QOI_ENCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Streaming QOI encoder (https://qoiformat.org)
+// Takes RGB565 pixels a row (or any run of pixels) at a time and emits the
+// encoded stream through a write callback in QOI_OUTPUT_BUFFER sized chunks,
+// so a full screen can be encoded in constant memory (~600 bytes of state).
+// UI screens are mostly flat colour, which QOI turns into long RUN/INDEX ops.
+#define QOI_OUTPUT_BUFFER 512
+
+class QoiEncoder {
+public:
+  typedef void (*WriteCallback)(const uint8_t* data, size_t length, void* context);
+  
+  QoiEncoder(WriteCallback write, void* context);
+  
+  // Writes the 14-byte header (3 channels, sRGB)
+  void begin(uint32_t width, uint32_t height);
+  // swapped = pixels are in display byte order (as returned by readRect)
+  void addPixels(const uint16_t* pixels, size_t count, bool swapped);
+  // Flushes any pending run, writes the end marker and flushes the buffer
+  void end();
+  
+  uint32_t getBytesWritten() const { return bytesWritten; }
+  
+private:
+  void encodePixel(uint8_t r, uint8_t g, uint8_t b);
+  void putByte(uint8_t value);
+  void putRun();
+  void flush();
+  
+  WriteCallback writeCallback;
+  void* writeContext;
+  uint32_t index[64];  // Previously seen pixels, packed 0xRRGGBBAA (empty = transparent black)
+  uint32_t previous;
+  uint8_t run;
+  uint8_t buffer[QOI_OUTPUT_BUFFER];
+  size_t bufferUsed;
+  uint32_t bytesWritten;
+};
+
+#endif // QOI_ENCODER_H
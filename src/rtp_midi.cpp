@@ -0,0 +1,171 @@
+#include "rtp_midi.h"
+#include <ESPmDNS.h>
+#include <esp_timer.h>
+
+RtpMidiSession* RtpMidi::session = nullptr;
+WiFiUDP RtpMidi::controlUdp;
+WiFiUDP RtpMidi::dataUdp;
+QueueHandle_t RtpMidi::eventQueue = nullptr;
+SemaphoreHandle_t RtpMidi::rtpMutex = nullptr;
+TaskHandle_t RtpMidi::rtpTaskHandle = nullptr;
+volatile bool RtpMidi::running = false;
+volatile int RtpMidi::connectedPeers = 0;
+uint8_t RtpMidi::packet[RTPMIDI_PACKET_SIZE];
+uint32_t RtpMidi::packetsSent = 0;
+uint32_t RtpMidi::eventsDropped = 0;
+
+// AppleMIDI clock, 100 us units
+uint64_t RtpMidi::clock() {
+  return esp_timer_get_time() / 100;
+}
+
+void RtpMidi::begin() {
+  if (!rtpMutex) {
+    rtpMutex = xSemaphoreCreateMutex();
+    eventQueue = xQueueCreate(RTPMIDI_QUEUE_LENGTH, sizeof(Event));
+    session = new RtpMidiSession(esp_random(), RTPMIDI_SESSION_NAME);
+    xTaskCreatePinnedToCore(rtpTask, "RtpMidiTask", RTPMIDI_TASK_STACK, nullptr,
+                            RTPMIDI_TASK_PRIORITY, &rtpTaskHandle, RTPMIDI_TASK_CORE);
+  }
+  
+  xSemaphoreTake(rtpMutex, portMAX_DELAY);
+  if (!running) {
+    controlUdp.begin(RTPMIDI_CONTROL_PORT);
+    dataUdp.begin(RTPMIDI_CONTROL_PORT + 1);
+    if (MDNS.begin("cyd-midi")) {
+      MDNS.addService("apple-midi", "udp", RTPMIDI_CONTROL_PORT);
+    }
+    running = true;
+    xTaskNotifyGive(rtpTaskHandle);
+    Serial.printf("RTP-MIDI session \"%s\" on UDP %d/%d\n", RTPMIDI_SESSION_NAME,
+                  RTPMIDI_CONTROL_PORT, RTPMIDI_CONTROL_PORT + 1);
+  }
+  xSemaphoreGive(rtpMutex);
+}
+
+void RtpMidi::stop() {
+  if (!rtpMutex) return;
+  xSemaphoreTake(rtpMutex, portMAX_DELAY);
+  if (running) {
+    // Say goodbye so peers don't wait for the timeout
+    for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+      const RtpMidiPeer& p = session->peer(i);
+      size_t length = session->encodeEnd(i, packet, sizeof(packet));
+      if (length == 0) continue;
+      controlUdp.beginPacket(IPAddress(p.address), p.controlPort);
+      controlUdp.write(packet, length);
+      controlUdp.endPacket();
+    }
+    session->removeAll();
+    connectedPeers = 0;
+    controlUdp.stop();
+    dataUdp.stop();
+    MDNS.end();
+    running = false;
+    xQueueReset(eventQueue);
+  }
+  xSemaphoreGive(rtpMutex);
+}
+
+void RtpMidi::send(const uint8_t* message, size_t length) {
+  if (connectedPeers == 0 || length == 0 || length > 3) return;
+  Event event;
+  event.length = length;
+  memcpy(event.data, message, length);
+  if (xQueueSend(eventQueue, &event, 0) != pdTRUE) eventsDropped++;
+}
+
+void RtpMidi::rtpTask(void* parameter) {
+  Event event;
+  unsigned long lastExpiry = 0;
+  
+  while (true) {
+    // With WiFi off there are no sockets to poll: sleep until begin()
+    if (!running) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    
+    bool received = xQueueReceive(eventQueue, &event, RTPMIDI_POLL_MS / portTICK_PERIOD_MS) == pdTRUE;
+    
+    xSemaphoreTake(rtpMutex, portMAX_DELAY);
+    if (running) {
+      if (received) sendQueued(event);
+      pollSocket(controlUdp, false);
+      pollSocket(dataUdp, true);
+      
+      if (millis() - lastExpiry > 1000) {
+        lastExpiry = millis();
+        int dropped = session->expirePeers(clock());
+        if (dropped) Serial.printf("RTP-MIDI: %d peer(s) timed out\n", dropped);
+      }
+      connectedPeers = session->connectedCount();
+    }
+    xSemaphoreGive(rtpMutex);
+  }
+}
+
+// Packs 'first' and whatever else is already queued into one packet
+void RtpMidi::sendQueued(const Event& first) {
+  uint8_t midi[RTPMIDI_MIDI_PER_PACKET];
+  size_t used = 0;
+  memcpy(midi, first.data, first.length);
+  used = first.length;
+  
+  Event event;
+  while (used + 3 <= sizeof(midi) && xQueueReceive(eventQueue, &event, 0) == pdTRUE) {
+    memcpy(midi + used, event.data, event.length);
+    used += event.length;
+  }
+  
+  size_t length = session->encodeMidi(midi, used, clock(), packet, sizeof(packet));
+  if (length == 0) return;
+  
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+    const RtpMidiPeer& p = session->peer(i);
+    if (!p.connected) continue;
+    dataUdp.beginPacket(IPAddress(p.address), p.dataPort);
+    dataUdp.write(packet, length);
+    dataUdp.endPacket();
+  }
+  packetsSent++;
+}
+
+void RtpMidi::pollSocket(WiFiUDP& udp, bool dataPort) {
+  uint8_t incoming[128];
+  while (udp.parsePacket() > 0) {
+    int length = udp.read(incoming, sizeof(incoming));
+    if (length <= 0) continue;
+    
+    IPAddress address = udp.remoteIP();
+    uint16_t port = udp.remotePort();
+    int before = session->connectedCount();
+    size_t replyLength = session->handlePacket(dataPort, (uint32_t)address, port, incoming, length,
+                                               clock(), packet, sizeof(packet));
+    if (replyLength) {
+      udp.beginPacket(address, port);
+      udp.write(packet, replyLength);
+      udp.endPacket();
+    }
+    
+    int after = session->connectedCount();
+    if (after > before) Serial.println("RTP-MIDI: peer connected from " + address.toString());
+    if (after < before) {
+      Serial.println("RTP-MIDI: peer left");
+      printStats();
+    }
+  }
+}
+
+void RtpMidi::printStats() {
+  Serial.printf("RTP-MIDI: %d peer(s), %u packets sent, %u events dropped\n",
+                (int)connectedPeers, (unsigned)packetsSent, (unsigned)eventsDropped);
+  if (!session) return;
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+    const RtpMidiPeer& p = session->peer(i);
+    if (p.connected) {
+      Serial.printf("  %s (%s), latency %.1f ms\n", p.name, IPAddress(p.address).toString().c_str(),
+                    p.latency / 10.0);
+    }
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef RTP_MIDI_H
+#define RTP_MIDI_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include "rtp_midi_protocol.h"
+
+// RTP-MIDI (AppleMIDI) network session
+// Sends the same MIDI output stream as BLE to up to RTPMIDI_MAX_PEERS peers
+// on the LAN. Peers connect to us: in macOS Audio MIDI Setup > MIDI Network
+// Setup, the device shows up as "CYD-MIDI" (advertised over mDNS), or add it
+// by IP with port 5004.
+//
+// send() only queues. A task on core 0 drains the queue, packs everything
+// that arrived together into one RTP packet (with the recovery journal) and
+// sends it to every connected peer, then services the session protocol on
+// the control and data ports. It wakes as soon as something is queued, so
+// latency is the WiFi hop rather than a BLE connection interval.
+#define RTPMIDI_CONTROL_PORT  5004  // Data port is control + 1
+#define RTPMIDI_SESSION_NAME  "CYD-MIDI"
+#define RTPMIDI_QUEUE_LENGTH  64
+#define RTPMIDI_PACKET_SIZE   1024
+#define RTPMIDI_MIDI_PER_PACKET 96  // MIDI bytes packed into one packet
+#define RTPMIDI_TASK_STACK    4096
+#define RTPMIDI_TASK_PRIORITY 2
+#define RTPMIDI_TASK_CORE     0
+#define RTPMIDI_POLL_MS       2     // Socket poll interval while no MIDI is queued
+
+class RtpMidi {
+public:
+  // Call once WiFi is up (web task); stop() ends every session
+  static void begin();
+  static void stop();
+  static bool hasPeers() { return connectedPeers > 0; }
+  // Any task: queue one complete MIDI message (1-3 bytes). Cheap no-op
+  // while no peer is connected.
+  static void send(const uint8_t* message, size_t length);
+  static void printStats();
+
+private:
+  struct Event {
+    uint8_t length;
+    uint8_t data[3];
+  };
+  
+  static void rtpTask(void* parameter);
+  static void sendQueued(const Event& first);
+  static void pollSocket(WiFiUDP& udp, bool dataPort);
+  static uint64_t clock();
+  
+  static RtpMidiSession* session;
+  static WiFiUDP controlUdp;
+  static WiFiUDP dataUdp;
+  static QueueHandle_t eventQueue;
+  static SemaphoreHandle_t rtpMutex;
+  static TaskHandle_t rtpTaskHandle;  // Notified by begin() to wake it from idle
+  static volatile bool running;
+  static volatile int connectedPeers;
+  static uint8_t packet[RTPMIDI_PACKET_SIZE];
+  
+  static uint32_t packetsSent;
+  static uint32_t eventsDropped;
+};
+
+#endif // RTP_MIDI_H
@@ -0,0 +1,452 @@
+#include "rtp_midi_protocol.h"
+#include <string.h>
+
+#define APPLEMIDI_VERSION   2
+#define RTPMIDI_PAYLOAD     0x61
+#define SYNC_PACKET_SIZE    36
+#define JOURNAL_OVERFLOW    ((size_t)-1)
+#define NOTE_LOGS_MAX       126  // 127 logs with LOW=15/HIGH=0 would mean 128
+
+// Chapter bits in a channel journal's table of contents
+#define TOC_C 0x40
+#define TOC_W 0x10
+#define TOC_N 0x08
+
+// Network byte order helpers
+static void put16(uint8_t* p, uint16_t v) { p[0] = v >> 8; p[1] = v; }
+static void put32(uint8_t* p, uint32_t v) { put16(p, v >> 16); put16(p + 2, v); }
+static void put64(uint8_t* p, uint64_t v) { put32(p, v >> 32); put32(p + 4, v); }
+static uint16_t get16(const uint8_t* p) { return (p[0] << 8) | p[1]; }
+static uint32_t get32(const uint8_t* p) { return ((uint32_t)get16(p) << 16) | get16(p + 2); }
+static uint64_t get64(const uint8_t* p) { return ((uint64_t)get32(p) << 32) | get32(p + 4); }
+
+// True if sequence number a comes after b (with wrap-around)
+static bool seqNewer(uint16_t a, uint16_t b) { return (int16_t)(a - b) > 0; }
+
+// Length of the MIDI message starting with 'status', 0 if it isn't a status byte
+static size_t messageLength(uint8_t status) {
+  if (status < 0x80) return 0;
+  switch (status & 0xF0) {
+    case 0xC0:
+    case 0xD0:
+      return 2;
+    case 0xF0:
+      if (status == 0xF2) return 3;
+      if (status == 0xF1 || status == 0xF3) return 2;
+      return 1;
+    default:
+      return 3;
+  }
+}
+
+// Recovery journal
+
+RtpMidiJournal::RtpMidiJournal() {
+  reset();
+}
+
+void RtpMidiJournal::reset() {
+  for (int i = 0; i < RTPMIDI_JOURNAL_CHANNELS; i++) channels[i].channel = -1;
+}
+
+RtpMidiJournal::Channel* RtpMidiJournal::channelFor(uint8_t channel) {
+  Channel* slot = nullptr;
+  for (int i = 0; i < RTPMIDI_JOURNAL_CHANNELS; i++) {
+    if (channels[i].channel == channel) return &channels[i];
+    if (channels[i].channel < 0 && !slot) slot = &channels[i];
+  }
+  if (!slot) return nullptr;  // Not journalled; receivers can't recover this channel
+  memset(slot, 0, sizeof(Channel));
+  slot->channel = channel;
+  return slot;
+}
+
+void RtpMidiJournal::record(const uint8_t* midi, size_t length, uint16_t seq) {
+  size_t pos = 0;
+  while (pos < length) {
+    size_t size = messageLength(midi[pos]);
+    if (size == 0 || pos + size > length) return;
+    
+    uint8_t status = midi[pos] & 0xF0;
+    if (status == 0x80 || status == 0x90 || status == 0xB0 || status == 0xE0) {
+      Channel* ch = channelFor(midi[pos] & 0x0F);
+      uint8_t d1 = midi[pos + 1] & 0x7F;
+      uint8_t d2 = midi[pos + 2] & 0x7F;
+      if (ch && status == 0xB0) {
+        ch->ccValue[d1] = d2;
+        ch->ccSeq[d1] = seq;
+        ch->ccLogged[d1 >> 3] |= 0x80 >> (d1 & 7);
+      } else if (ch && status == 0xE0) {
+        ch->bendLsb = d1;
+        ch->bendMsb = d2;
+        ch->bendSeq = seq;
+        ch->bendLogged = true;
+      } else if (ch) {
+        // Note on with velocity 0 is a note off
+        ch->noteVelocity[d1] = (status == 0x90) ? d2 : 0;
+        ch->noteSeq[d1] = seq;
+        ch->noteLogged[d1 >> 3] |= 0x80 >> (d1 & 7);
+      }
+    }
+    pos += size;
+  }
+}
+
+size_t RtpMidiJournal::encode(uint16_t checkpoint, uint16_t lastSeq, uint8_t* out, size_t capacity) {
+  if (capacity < 3) return 0;
+  
+  size_t pos = 3;
+  int count = 0;
+  bool single = true;  // S bit: nothing here changed in the previous packet alone
+  for (int i = 0; i < RTPMIDI_JOURNAL_CHANNELS; i++) {
+    if (channels[i].channel < 0) continue;
+    size_t n = encodeChannel(channels[i], checkpoint, lastSeq, out + pos, capacity - pos);
+    if (n == JOURNAL_OVERFLOW) return 0;
+    if (n == 0) continue;
+    single &= (out[pos] & 0x80) != 0;
+    pos += n;
+    count++;
+  }
+  if (count == 0) return 0;
+  
+  // S Y A H TOTCHAN, checkpoint packet sequence number
+  out[0] = (single ? 0x80 : 0) | 0x20 | ((count - 1) & 0x0F);
+  put16(out + 1, checkpoint);
+  return pos;
+}
+
+size_t RtpMidiJournal::encodeChannel(Channel& ch, uint16_t checkpoint, uint16_t lastSeq,
+                                     uint8_t* out, size_t capacity) {
+  // Forget what every peer has already acknowledged
+  int noteOns = 0;
+  int offLow = 16, offHigh = -1;
+  int ccCount = 0;
+  for (int n = 0; n < 128; n++) {
+    uint8_t bit = 0x80 >> (n & 7);
+    if (ch.noteLogged[n >> 3] & bit) {
+      if (!seqNewer(ch.noteSeq[n], checkpoint)) {
+        ch.noteLogged[n >> 3] &= ~bit;
+      } else if (ch.noteVelocity[n]) {
+        noteOns++;
+      } else {
+        if (offLow > (n >> 3)) offLow = n >> 3;
+        offHigh = n >> 3;
+      }
+    }
+    if (ch.ccLogged[n >> 3] & bit) {
+      if (!seqNewer(ch.ccSeq[n], checkpoint)) ch.ccLogged[n >> 3] &= ~bit;
+      else ccCount++;
+    }
+  }
+  if (ch.bendLogged && !seqNewer(ch.bendSeq, checkpoint)) ch.bendLogged = false;
+  if (noteOns > NOTE_LOGS_MAX) noteOns = NOTE_LOGS_MAX;
+  
+  size_t size = 3;
+  if (ccCount) size += 1 + 2 * ccCount;
+  if (ch.bendLogged) size += 2;
+  if (noteOns || offHigh >= 0) size += 2 + 2 * noteOns + (offHigh >= 0 ? offHigh - offLow + 1 : 0);
+  if (size == 3) return 0;
+  if (size > capacity) return JOURNAL_OVERFLOW;
+  
+  uint8_t toc = 0;
+  bool channelSingle = true;
+  size_t pos = 3;
+  
+  // Chapter C: controllers
+  if (ccCount) {
+    uint8_t* header = out + pos++;
+    bool single = true;
+    for (int n = 0; n < 128; n++) {
+      if (!(ch.ccLogged[n >> 3] & (0x80 >> (n & 7)))) continue;
+      bool s = ch.ccSeq[n] != lastSeq;
+      single &= s;
+      out[pos++] = (s ? 0x80 : 0) | n;
+      out[pos++] = ch.ccValue[n];  // A = 0: absolute value
+    }
+    *header = (single ? 0x80 : 0) | (ccCount - 1);
+    channelSingle &= single;
+    toc |= TOC_C;
+  }
+  
+  // Chapter W: pitch wheel
+  if (ch.bendLogged) {
+    bool s = ch.bendSeq != lastSeq;
+    out[pos++] = (s ? 0x80 : 0) | ch.bendLsb;
+    out[pos++] = ch.bendMsb;
+    channelSingle &= s;
+    toc |= TOC_W;
+  }
+  
+  // Chapter N: note logs for notes on, OFFBITS for notes turned off
+  if (noteOns || offHigh >= 0) {
+    uint8_t* header = out + pos;
+    pos += 2;
+    bool single = true;
+    int logs = 0;
+    for (int n = 0; n < 128 && logs < noteOns; n++) {
+      if (!(ch.noteLogged[n >> 3] & (0x80 >> (n & 7))) || !ch.noteVelocity[n]) continue;
+      bool s = ch.noteSeq[n] != lastSeq;
+      single &= s;
+      out[pos++] = (s ? 0x80 : 0) | n;
+      out[pos++] = 0x80 | ch.noteVelocity[n];  // Y = 1: still worth playing
+      logs++;
+    }
+    if (offHigh >= 0) {
+      for (int octet = offLow; octet <= offHigh; octet++) {
+        uint8_t bits = 0;
+        for (int b = 0; b < 8; b++) {
+          int n = octet * 8 + b;
+          if ((ch.noteLogged[octet] & (0x80 >> b)) && !ch.noteVelocity[n]) {
+            bits |= 0x80 >> b;
+            single &= ch.noteSeq[n] != lastSeq;
+          }
+        }
+        out[pos++] = bits;
+      }
+    } else {
+      offLow = 15;  // LOW > HIGH: no OFFBITS
+      offHigh = 0;
+    }
+    header[0] = (single ? 0x80 : 0) | logs;
+    header[1] = (offLow << 4) | offHigh;
+    channelSingle &= single;
+    toc |= TOC_N;
+  }
+  
+  // S CHAN H LENGTH, table of contents
+  out[0] = (channelSingle ? 0x80 : 0) | ((ch.channel & 0x0F) << 3) | ((pos >> 8) & 0x03);
+  out[1] = pos & 0xFF;
+  out[2] = toc;
+  return pos;
+}
+
+// Session
+
+RtpMidiSession::RtpMidiSession(uint32_t ssrc, const char* sessionName)
+  : ssrc(ssrc), nextSeq((uint16_t)(ssrc >> 16)) {
+  strncpy(name, sessionName, RTPMIDI_NAME_MAX - 1);
+  name[RTPMIDI_NAME_MAX - 1] = '\0';
+  memset(peers, 0, sizeof(peers));
+}
+
+int RtpMidiSession::findPeer(uint32_t peerSsrc) const {
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+    if (peers[i].active && peers[i].ssrc == peerSsrc) return i;
+  }
+  return -1;
+}
+
+void RtpMidiSession::removePeer(int index) {
+  peers[index].active = false;
+  peers[index].connected = false;
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+    if (peers[i].active) return;
+  }
+  journal.reset();  // Nobody left to recover anything
+}
+
+void RtpMidiSession::removeAll() {
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) removePeer(i);
+}
+
+int RtpMidiSession::connectedCount() const {
+  int count = 0;
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) count += peers[i].connected;
+  return count;
+}
+
+// The oldest sequence number acknowledged by every connected peer
+uint16_t RtpMidiSession::checkpoint() const {
+  uint16_t oldest = nextSeq - 1;
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+    if (peers[i].connected && seqNewer(oldest, peers[i].ackedSeq)) oldest = peers[i].ackedSeq;
+  }
+  return oldest;
+}
+
+// IN/OK/NO layout: signature, command, version, token, SSRC, name
+size_t RtpMidiSession::encodeSessionReply(const char* command, uint32_t token,
+                                          uint8_t* out, size_t capacity) const {
+  size_t nameLength = strlen(name) + 1;
+  if (capacity < 16 + nameLength) return 0;
+  out[0] = 0xFF;
+  out[1] = 0xFF;
+  out[2] = command[0];
+  out[3] = command[1];
+  put32(out + 4, APPLEMIDI_VERSION);
+  put32(out + 8, token);
+  put32(out + 12, ssrc);
+  memcpy(out + 16, name, nameLength);
+  return 16 + nameLength;
+}
+
+size_t RtpMidiSession::encodeEnd(int index, uint8_t* out, size_t capacity) const {
+  if (capacity < 16 || !peers[index].active) return 0;
+  out[0] = 0xFF;
+  out[1] = 0xFF;
+  out[2] = 'B';
+  out[3] = 'Y';
+  put32(out + 4, APPLEMIDI_VERSION);
+  put32(out + 8, peers[index].token);
+  put32(out + 12, ssrc);
+  return 16;
+}
+
+size_t RtpMidiSession::handlePacket(bool dataPort, uint32_t address, uint16_t port,
+                                    const uint8_t* data, size_t length, uint64_t now,
+                                    uint8_t* reply, size_t capacity) {
+  // RTP from a peer (it may send us MIDI too); only counts as a sign of life
+  if (length >= 12 && data[0] != 0xFF && (data[0] & 0xC0) == 0x80) {
+    int index = findPeer(get32(data + 8));
+    if (index >= 0) peers[index].lastSeen = now;
+    return 0;
+  }
+  if (length < 12 || data[0] != 0xFF || data[1] != 0xFF) return 0;
+  
+  char c0 = data[2], c1 = data[3];
+  
+  // Invitation: first on the control port, then on the data port
+  if (c0 == 'I' && c1 == 'N' && length >= 16) {
+    uint32_t token = get32(data + 8);
+    uint32_t peerSsrc = get32(data + 12);
+    int index = findPeer(peerSsrc);
+    
+    if (!dataPort) {
+      if (index < 0) {
+        for (int i = 0; i < RTPMIDI_MAX_PEERS && index < 0; i++) {
+          if (!peers[i].active) index = i;
+        }
+        if (index < 0) return encodeSessionReply("NO", token, reply, capacity);
+      }
+      RtpMidiPeer& p = peers[index];
+      memset(&p, 0, sizeof(p));
+      p.active = true;
+      p.ssrc = peerSsrc;
+      p.token = token;
+      p.address = address;
+      p.controlPort = port;
+      p.lastSeen = now;
+      size_t nameLength = length - 16;
+      if (nameLength > RTPMIDI_NAME_MAX - 1) nameLength = RTPMIDI_NAME_MAX - 1;
+      memcpy(p.name, data + 16, nameLength);
+      p.name[nameLength] = '\0';
+      return encodeSessionReply("OK", token, reply, capacity);
+    }
+    
+    if (index < 0 || peers[index].address != address) {
+      return encodeSessionReply("NO", token, reply, capacity);
+    }
+    RtpMidiPeer& p = peers[index];
+    p.dataPort = port;
+    p.connected = true;
+    p.ackedSeq = nextSeq - 1;  // Nothing before this to recover
+    p.lastSeen = now;
+    return encodeSessionReply("OK", token, reply, capacity);
+  }
+  
+  // End of session
+  if (c0 == 'B' && c1 == 'Y' && length >= 16) {
+    int index = findPeer(get32(data + 12));
+    if (index >= 0) removePeer(index);
+    return 0;
+  }
+  
+  // Clock sync: the peer sends count 0 with ts1, we answer count 1 with our
+  // time as ts2, the peer finishes with count 2 and ts3 (both its own clock)
+  if (c0 == 'C' && c1 == 'K' && length >= SYNC_PACKET_SIZE) {
+    int index = findPeer(get32(data + 4));
+    if (index < 0) return 0;
+    RtpMidiPeer& p = peers[index];
+    p.lastSeen = now;
+    uint8_t count = data[8];
+    
+    if (count == 0 && capacity >= SYNC_PACKET_SIZE) {
+      memcpy(reply, data, SYNC_PACKET_SIZE);
+      put32(reply + 4, ssrc);
+      reply[8] = 1;
+      put64(reply + 20, now);
+      return SYNC_PACKET_SIZE;
+    }
+    if (count == 2) {
+      p.latency = (uint32_t)((get64(data + 28) - get64(data + 12)) / 2);
+    }
+    return 0;
+  }
+  
+  // Receiver feedback: everything up to this sequence number has arrived
+  if (c0 == 'R' && c1 == 'S') {
+    int index = findPeer(get32(data + 4));
+    if (index >= 0) {
+      peers[index].ackedSeq = get16(data + 8);
+      peers[index].lastSeen = now;
+    }
+    return 0;
+  }
+  
+  return 0;
+}
+
+size_t RtpMidiSession::encodeMidi(const uint8_t* midi, size_t length, uint64_t now,
+                                  uint8_t* out, size_t capacity) {
+  // Command list: messages with a zero delta time between them
+  size_t messages = 0;
+  for (size_t pos = 0; pos < length; ) {
+    size_t size = messageLength(midi[pos]);
+    if (size == 0 || pos + size > length) return 0;
+    pos += size;
+    messages++;
+  }
+  if (messages == 0) return 0;
+  size_t listLength = length + messages - 1;
+  size_t headerLength = listLength > 15 ? 2 : 1;
+  if (listLength > 0x0FFF || capacity < 12 + headerLength + listLength) return 0;
+  
+  uint16_t seq = nextSeq;
+  
+  // RTP header: V=2, payload type, sequence number, timestamp, SSRC
+  out[0] = 0x80;
+  out[1] = RTPMIDI_PAYLOAD;
+  put16(out + 2, seq);
+  put32(out + 4, (uint32_t)now);
+  put32(out + 8, ssrc);
+  
+  uint8_t* list = out + 12 + headerLength;
+  size_t listPos = 0;
+  for (size_t pos = 0; pos < length; ) {
+    size_t size = messageLength(midi[pos]);
+    if (pos > 0) list[listPos++] = 0;  // Delta time
+    memcpy(list + listPos, midi + pos, size);
+    listPos += size;
+    pos += size;
+  }
+  
+  // Journal of everything since the checkpoint, up to the previous packet
+  size_t end = 12 + headerLength + listLength;
+  size_t journalLength = journal.encode(checkpoint(), seq - 1, out + end, capacity - end);
+  uint8_t j = journalLength ? 0x40 : 0;
+  
+  // MIDI command section header: B J Z P LEN (Z = 0: first command has no delta)
+  if (headerLength == 1) {
+    out[12] = j | listLength;
+  } else {
+    out[12] = 0x80 | j | (listLength >> 8);
+    out[13] = listLength & 0xFF;
+  }
+  
+  journal.record(midi, length, seq);
+  nextSeq++;
+  return end + journalLength;
+}
+
+int RtpMidiSession::expirePeers(uint64_t now) {
+  int dropped = 0;
+  for (int i = 0; i < RTPMIDI_MAX_PEERS; i++) {
+    if (!peers[i].active) continue;
+    uint64_t limit = peers[i].connected ? RTPMIDI_PEER_TIMEOUT : RTPMIDI_INVITE_TIMEOUT;
+    if (now - peers[i].lastSeen > limit) {
+      removePeer(i);
+      dropped++;
+    }
+  }
+  return dropped;
+}
@@ -0,0 +1,116 @@
+#ifndef RTP_MIDI_PROTOCOL_H
+#define RTP_MIDI_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// RTP-MIDI (RFC 6295) with the AppleMIDI session protocol
+// Pure protocol logic: session handshake, clock sync, receiver feedback,
+// RTP-MIDI payload encoding and the recovery journal. The caller owns the
+// sockets and the clock; packets go in as bytes plus the sender's address,
+// replies come out as bytes to send back.
+//
+// We are always the session listener: peers (macOS Audio MIDI Setup,
+// rtpMIDI on Windows, ...) invite us on the control port, then on the data
+// port (control + 1), and run the clock sync on the data port.
+//
+// Times are in the AppleMIDI clock unit of 100 us.
+#define RTPMIDI_MAX_PEERS        4
+#define RTPMIDI_NAME_MAX         32
+#define RTPMIDI_JOURNAL_CHANNELS 4      // Channels tracked by the recovery journal
+#define RTPMIDI_PEER_TIMEOUT     600000 // 60 s without a packet (peers sync every ~10 s)
+#define RTPMIDI_INVITE_TIMEOUT   50000  // 5 s between control and data invitations
+
+struct RtpMidiPeer {
+  bool active;
+  bool connected;        // Both ports accepted
+  uint32_t ssrc;
+  uint32_t token;        // Initiator token from the invitation
+  uint32_t address;      // IPv4, as stored by the caller
+  uint16_t controlPort;
+  uint16_t dataPort;
+  uint64_t lastSeen;
+  uint16_t ackedSeq;     // Highest sequence number the peer reported receiving
+  uint32_t latency;      // One-way estimate from the last clock sync, 100 us units
+  char name[RTPMIDI_NAME_MAX];
+};
+
+// Recovery journal for our outgoing stream (RFC 6295 section 5)
+// Keeps the state a receiver needs to recover from lost packets: per channel,
+// the notes on and off (chapter N), controller values (chapter C) and the
+// pitch wheel (chapter W). Entries changed after the checkpoint (the oldest
+// sequence number every peer has acknowledged) go into each packet.
+// System messages (clock, start, stop) are not journalled.
+class RtpMidiJournal {
+public:
+  RtpMidiJournal();
+  void reset();
+  // Records complete MIDI messages sent in packet 'seq'
+  void record(const uint8_t* midi, size_t length, uint16_t seq);
+  // Writes the journal for the packet after 'lastSeq'. Returns its length,
+  // 0 if there is nothing to recover or it doesn't fit in 'capacity'.
+  size_t encode(uint16_t checkpoint, uint16_t lastSeq, uint8_t* out, size_t capacity);
+
+private:
+  struct Channel {
+    int8_t channel;            // -1 = slot free
+    uint8_t noteVelocity[128]; // 0 = off
+    uint16_t noteSeq[128];
+    uint8_t noteLogged[16];    // Bitset: changed since the checkpoint
+    uint8_t ccValue[128];
+    uint16_t ccSeq[128];
+    uint8_t ccLogged[16];
+    uint8_t bendLsb;
+    uint8_t bendMsb;
+    uint16_t bendSeq;
+    bool bendLogged;
+  };
+  
+  Channel* channelFor(uint8_t channel);
+  size_t encodeChannel(Channel& ch, uint16_t checkpoint, uint16_t lastSeq,
+                       uint8_t* out, size_t capacity);
+  
+  Channel channels[RTPMIDI_JOURNAL_CHANNELS];
+};
+
+class RtpMidiSession {
+public:
+  RtpMidiSession(uint32_t ssrc, const char* name);
+  
+  // Handles an AppleMIDI command or RTP packet from (address, port) on the
+  // control or data port. Returns the length of a reply for the sender
+  // written to 'reply', or 0 if there is none.
+  size_t handlePacket(bool dataPort, uint32_t address, uint16_t port,
+                      const uint8_t* data, size_t length, uint64_t now,
+                      uint8_t* reply, size_t capacity);
+  
+  // Builds one RTP-MIDI packet holding complete MIDI messages, with the
+  // recovery journal. Every connected peer gets the same packet.
+  size_t encodeMidi(const uint8_t* midi, size_t length, uint64_t now,
+                    uint8_t* out, size_t capacity);
+  
+  // Builds the BY (end session) message for peer 'index'
+  size_t encodeEnd(int index, uint8_t* out, size_t capacity) const;
+  
+  // Drops peers that went quiet; returns how many
+  int expirePeers(uint64_t now);
+  void removeAll();
+  
+  int connectedCount() const;
+  const RtpMidiPeer& peer(int index) const { return peers[index]; }
+
+private:
+  int findPeer(uint32_t ssrc) const;
+  void removePeer(int index);
+  uint16_t checkpoint() const;
+  size_t encodeSessionReply(const char* command, uint32_t token,
+                            uint8_t* out, size_t capacity) const;
+  
+  uint32_t ssrc;
+  char name[RTPMIDI_NAME_MAX];
+  uint16_t nextSeq;
+  RtpMidiPeer peers[RTPMIDI_MAX_PEERS];
+  RtpMidiJournal journal;
+};
+
+#endif // RTP_MIDI_PROTOCOL_H
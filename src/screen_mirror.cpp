@@ -0,0 +1,197 @@
+#include "screen_mirror.h"
+#include "common_definitions.h"
+#include "websocket.h"
+#include <WebServer.h>
+
+extern WebServer server;
+
+WiFiServer ScreenMirror::wsServer(MIRROR_PORT);
+WiFiClient ScreenMirror::client;
+bool ScreenMirror::running = false;
+unsigned long ScreenMirror::lastFrameTime = 0;
+int ScreenMirror::scanCursor = 0;
+bool ScreenMirror::resync = false;
+uint8_t* ScreenMirror::message = nullptr;
+size_t ScreenMirror::messageUsed = 0;
+uint32_t ScreenMirror::framesSent = 0;
+uint32_t ScreenMirror::bytesSent = 0;
+
+void ScreenMirror::begin() {
+  if (running) return;
+  message = (uint8_t*)malloc(MIRROR_MESSAGE_BUFFER);
+  if (!message) {
+    Serial.println("Screen mirror: buffer allocation failed");
+    return;
+  }
+  wsServer.begin();
+  wsServer.setNoDelay(true);
+  running = true;
+  Serial.printf("Screen mirror on ws://<ip>:%d (viewer at /mirror)\n", MIRROR_PORT);
+}
+
+void ScreenMirror::stop() {
+  if (!running) return;
+  dropClient();
+  wsServer.stop();
+  free(message);
+  message = nullptr;
+  running = false;
+}
+
+bool ScreenMirror::hasViewer() {
+  return running && client && client.connected();
+}
+
+void ScreenMirror::update() {
+  if (!running) return;
+  
+  WiFiClient incoming = wsServer.available();
+  if (incoming) {
+    if (WebSocket::accept(incoming)) {
+      dropClient();
+      client = incoming;
+      framesSent = 0;
+      bytesSent = 0;
+      
+      String hello = "{\"width\":" + String(tft.width()) + ",\"height\":" + String(tft.height()) +
+                     ",\"tile\":" + String(SHADOW_TILE_SIZE) + "}";
+      sendFrame(WebSocket::OP_TEXT, (const uint8_t*)hello.c_str(), hello.length());
+      resync = true;  // Whole screen goes out once the display is free
+      scanCursor = 0;
+      Serial.println("Screen mirror: viewer connected from " + client.remoteIP().toString());
+    }
+  }
+  
+  if (!client) return;
+  if (!client.connected()) {
+    Serial.printf("Screen mirror: viewer disconnected (%u messages, %u bytes)\n",
+                  (unsigned)framesSent, (unsigned)bytesSent);
+    dropClient();
+    return;
+  }
+  
+  pollClient();
+  if (!client) return;
+  
+  if (millis() - lastFrameTime < 1000 / MIRROR_MAX_FPS) return;
+  lastFrameTime = millis();
+  sendDirtyTiles();
+}
+
+void ScreenMirror::pollClient() {
+  // The viewer only sends control frames; data frames are ignored
+  uint8_t ignored[16];
+  size_t length;
+  while (client) {
+    int opcode = WebSocket::poll(client, ignored, sizeof(ignored), length);
+    if (opcode < 0) {
+      Serial.println("Screen mirror: viewer closed connection");
+      dropClient();
+    } else if (opcode == 0) {
+      break;
+    }
+  }
+}
+
+void ScreenMirror::sendDirtyTiles() {
+  int cols = (tft.width() + SHADOW_TILE_SIZE - 1) / SHADOW_TILE_SIZE;
+  int rows = (tft.height() + SHADOW_TILE_SIZE - 1) / SHADOW_TILE_SIZE;
+  int total = cols * rows;
+  int sent = 0;
+  TickType_t wait = pdMS_TO_TICKS(MIRROR_DISPLAY_WAIT_MS);
+  
+  if (resync) {
+    if (!RenderThread::lockDisplay(wait)) return;
+    tft.markAllDirty();
+    RenderThread::unlockDisplay();
+    resync = false;
+  }
+  
+  // Scan round-robin from where the last capped frame stopped. A tile is read
+  // in the same borrow that clears its dirty bit, so giving up on a busy
+  // display (a modal screen) never loses a change.
+  messageUsed = 0;
+  uint16_t pixels[SHADOW_TILE_SIZE * SHADOW_TILE_SIZE];
+  for (int n = 0; n < total && sent < MIRROR_TILES_PER_FRAME; n++) {
+    int index = (scanCursor + n) % total;
+    int tileX = index % cols;
+    int tileY = index / cols;
+    int x = tileX * SHADOW_TILE_SIZE;
+    int y = tileY * SHADOW_TILE_SIZE;
+    int w = min(SHADOW_TILE_SIZE, tft.width() - x);
+    int h = min(SHADOW_TILE_SIZE, tft.height() - y);
+    
+    if (!RenderThread::lockDisplay(wait)) {
+      scanCursor = index;
+      break;
+    }
+    bool dirty = tft.getDirtyRow(tileY) & (1UL << tileX);
+    if (dirty) {
+      tft.readRect(x, y, w, h, pixels);  // Served from the display shadow when valid
+      tft.clearDirtyTile(tileX, tileY);
+    }
+    RenderThread::unlockDisplay();
+    if (!dirty) continue;
+    
+    encodeTile(tileX, tileY, w, h, pixels);
+    if (!client) return;
+    sent++;
+    if (sent == MIRROR_TILES_PER_FRAME) scanCursor = (index + 1) % total;
+  }
+  flushMessage();
+}
+
+void ScreenMirror::encodeTile(int tileX, int tileY, int w, int h, const uint16_t* pixels) {
+  // Worst case is one run per pixel
+  size_t worstCase = 4 + (size_t)w * h * 3;
+  if (messageUsed + worstCase > MIRROR_MESSAGE_BUFFER) {
+    flushMessage();
+    if (!client) return;
+  }
+  
+  uint8_t* out = message + messageUsed;
+  uint8_t* runCountPtr = out + 2;
+  out[0] = tileX;
+  out[1] = tileY;
+  out += 4;
+  
+  uint16_t runCount = 0;
+  int count = w * h;
+  int i = 0;
+  while (i < count) {
+    uint16_t color = pixels[i];
+    int run = 1;
+    while (i + run < count && pixels[i + run] == color && run < 256) run++;
+    // Display byte order -> little-endian RGB565
+    *out++ = run - 1;
+    *out++ = color >> 8;
+    *out++ = color & 0xFF;
+    runCount++;
+    i += run;
+  }
+  runCountPtr[0] = runCount & 0xFF;
+  runCountPtr[1] = runCount >> 8;
+  messageUsed = out - message;
+}
+
+void ScreenMirror::flushMessage() {
+  if (messageUsed == 0) return;
+  sendFrame(WebSocket::OP_BINARY, message, messageUsed);
+  messageUsed = 0;
+}
+
+bool ScreenMirror::sendFrame(uint8_t opcode, const uint8_t* data, size_t length) {
+  if (!WebSocket::send(client, opcode, data, length)) {
+    Serial.println("Screen mirror: send failed, dropping viewer");
+    dropClient();
+    return false;
+  }
+  framesSent++;
+  bytesSent += length;
+  return true;
+}
+
+void ScreenMirror::dropClient() {
+  if (client) client.stop();
+  client = WiFiClient();
+}
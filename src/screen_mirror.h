@@ -0,0 +1,53 @@
+#ifndef SCREEN_MIRROR_H
+#define SCREEN_MIRROR_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Live screen mirroring over WebSocket
+// A minimal WebSocket server on MIRROR_PORT pushes the tiles that ShadowTFT
+// marked dirty since the last frame, at most MIRROR_MAX_FPS times a second.
+// One viewer at a time; a new connection replaces the old one. The viewer
+// page is served by the main web server at /mirror.
+//
+// On connect the server sends a text message with the screen size:
+//   {"width":480,"height":320,"tile":16}
+// followed by binary messages holding any number of tiles, little-endian:
+//   u8 tileX, u8 tileY, u16 runCount, then runCount x (u8 length-1, u16 RGB565)
+// Runs cover the tile row by row (edge tiles are clipped to the screen).
+#define MIRROR_PORT             81
+#define MIRROR_MAX_FPS          10
+#define MIRROR_TILES_PER_FRAME  150   // Caps loop time per frame; the rest go next frame
+#define MIRROR_MESSAGE_BUFFER   4096
+#define MIRROR_DISPLAY_WAIT_MS  50    // Skip the rest of a frame if the display stays busy
+
+class ScreenMirror {
+public:
+  static void begin();
+  static void stop();
+  // Call from the web task. Takes the display lock per tile, so the loop
+  // waits at most one tile read; socket writes happen without it.
+  static void update();
+  static bool hasViewer();
+  
+private:
+  static void pollClient();
+  static void sendDirtyTiles();
+  static void encodeTile(int tileX, int tileY, int w, int h, const uint16_t* pixels);
+  static void flushMessage();
+  static bool sendFrame(uint8_t opcode, const uint8_t* data, size_t length);
+  static void dropClient();
+  
+  static WiFiServer wsServer;
+  static WiFiClient client;
+  static bool running;
+  static unsigned long lastFrameTime;
+  static int scanCursor;
+  static bool resync;  // A new viewer needs every tile
+  static uint8_t* message;
+  static size_t messageUsed;
+  static uint32_t framesSent;
+  static uint32_t bytesSent;
+};
+
+#endif // SCREEN_MIRROR_H
@@ -15,6 +15,20 @@ unsigned long noteOffTime[SEQ_TRACKS] = {0};
 int stepInterval;
 bool sequencerPlaying = false;
 
+// 808-style track labels and colors
+const char* const seqTrackLabels[SEQ_TRACKS] = {"KICK", "SNRE", "HHAT", "OPEN"};
+const uint16_t seqTrackColors[SEQ_TRACKS] = {THEME_ERROR, THEME_WARNING, THEME_PRIMARY, THEME_ACCENT};
+
+// Grid layout cache - cell rects are computed once per layout, and the color
+// last painted into each cell is tracked so redraws only touch changed cells
+struct SeqCellRect {
+  int16_t x, y, w, h;
+};
+SeqCellRect seqCellRects[SEQ_TRACKS][SEQ_STEPS];
+uint16_t seqCellDrawnColor[SEQ_TRACKS][SEQ_STEPS];
+int seqLabelX = 0;
+bool seqGridLayoutValid = false;
+
 // Control buttons
 Button seqBtnPlayStop;
 Button seqBtnClear;
@@ -27,6 +41,10 @@ void initializeSequencerMode();
 void drawSequencerMode();
 void handleSequencerMode();
 void drawSequencerGrid();
+void refreshSequencerGrid();
+void calculateSequencerGridLayout();
+uint16_t getSequencerCellColor(int track, int step);
+void drawSequencerCell(int track, int step);
 void toggleSequencerStep(int track, int step);
 void updateSequencer();
 void playSequencerStep();
@@ -72,6 +90,7 @@ void initializeSequencerMode() {
   seqBtnMenu.setColor(THEME_PRIMARY);
   
   drawSequencerMode();
+  StepClock::start(SEQUENCER, updateSequencer);
 }
 
 void drawSequencerMode() {
@@ -107,7 +126,7 @@ void drawSequencerMode() {
   }
 }
 
-void drawSequencerGrid() {
+void calculateSequencerGridLayout() {
   // Calculate grid layout from screen dimensions
   int gridSpacing = 10;
   int gridX = gridSpacing;
@@ -121,37 +140,75 @@ void drawSequencerGrid() {
   int cellW = (availableWidth - labelWidth - (SEQ_STEPS + 1) * cellSpacing) / SEQ_STEPS;
   int cellH = (availableHeight - (SEQ_TRACKS + 1) * cellSpacing) / SEQ_TRACKS;
   
-  // 808-style track labels and colors
-  String trackLabels[] = {"KICK", "SNRE", "HHAT", "OPEN"};
-  uint16_t trackColors[] = {THEME_ERROR, THEME_WARNING, THEME_PRIMARY, THEME_ACCENT};
+  seqLabelX = gridX;
+  for (int track = 0; track < SEQ_TRACKS; track++) {
+    for (int step = 0; step < SEQ_STEPS; step++) {
+      seqCellRects[track][step].x = gridX + labelWidth + step * (cellW + cellSpacing);
+      seqCellRects[track][step].y = gridY + track * (cellH + cellSpacing);
+      seqCellRects[track][step].w = cellW;
+      seqCellRects[track][step].h = cellH;
+    }
+  }
+  
+  seqGridLayoutValid = true;
+}
+
+uint16_t getSequencerCellColor(int track, int step) {
+  bool active = sequencePattern[track][step];
+  bool current = (sequencerPlaying && step == currentStep);
+  
+  if (current && active) return THEME_TEXT;
+  if (current || active) return seqTrackColors[track];
+  return THEME_SURFACE;
+}
+
+void drawSequencerCell(int track, int step) {
+  const SeqCellRect& cell = seqCellRects[track][step];
+  uint16_t color = getSequencerCellColor(track, step);
+  
+  tft.fillRect(cell.x, cell.y, cell.w, cell.h, color);
+  tft.drawRect(cell.x, cell.y, cell.w, cell.h, THEME_TEXT_DIM);
+  seqCellDrawnColor[track][step] = color;
+}
+
+// Full grid draw - labels, 808 beat markers and every cell
+void drawSequencerGrid() {
+  if (!seqGridLayoutValid) calculateSequencerGridLayout();
   
   for (int track = 0; track < SEQ_TRACKS; track++) {
-    int y = gridY + track * (cellH + cellSpacing);
+    const SeqCellRect& first = seqCellRects[track][0];
     
     // Track name with color coding
-    tft.setTextColor(trackColors[track], THEME_BG);
-    tft.drawString(trackLabels[track], gridX, y + cellH/2 - 6, 1);
+    tft.setTextColor(seqTrackColors[track], THEME_BG);
+    tft.drawString(seqTrackLabels[track], seqLabelX, first.y + first.h/2 - 6, 1);
     
     // Steps - 16 steps in 808 style
     for (int step = 0; step < SEQ_STEPS; step++) {
-      int x = gridX + labelWidth + step * (cellW + cellSpacing);
-      
-      bool active = sequencePattern[track][step];
-      bool current = (sequencerPlaying && step == currentStep);
-      
-      uint16_t color;
-      if (current && active) color = THEME_TEXT;
-      else if (current) color = trackColors[track];
-      else if (active) color = trackColors[track];
-      else color = THEME_SURFACE;
+      const SeqCellRect& cell = seqCellRects[track][step];
       
       // Highlight every 4th step (like 808)
       if (step % 4 == 0) {
-        tft.drawRect(x-1, y-1, cellW+2, cellH+2, THEME_TEXT_DIM);
+        tft.drawRect(cell.x-1, cell.y-1, cell.w+2, cell.h+2, THEME_TEXT_DIM);
       }
       
-      tft.fillRect(x, y, cellW, cellH, color);
-      tft.drawRect(x, y, cellW, cellH, THEME_TEXT_DIM);
+      drawSequencerCell(track, step);
+    }
+  }
+}
+
+// Incremental grid update - repaints only cells whose color changed since they
+// were last drawn (normally the old and new playhead columns, or toggled cells)
+void refreshSequencerGrid() {
+  if (!seqGridLayoutValid) {
+    drawSequencerGrid();
+    return;
+  }
+  
+  for (int track = 0; track < SEQ_TRACKS; track++) {
+    for (int step = 0; step < SEQ_STEPS; step++) {
+      if (getSequencerCellColor(track, step) != seqCellDrawnColor[track][step]) {
+        drawSequencerCell(track, step);
+      }
     }
   }
 }
@@ -181,11 +238,13 @@ void handleSequencerMode() {
   if (touch.justPressed) {
     // Transport controls
     if (isButtonPressed(btnSpacing, btnY, btn1W, btnH)) {
+      StepClock::lock();
       sequencerPlaying = !sequencerPlaying;
       if (sequencerPlaying) {
         currentStep = 0;
         lastStepTime = millis();
       }
+      StepClock::unlock();
       drawSequencerMode();
       return;
     }
@@ -197,7 +256,7 @@ void handleSequencerMode() {
           sequencePattern[t][s] = false;
         }
       }
-      drawSequencerGrid();
+      refreshSequencerGrid();
       return;
     }
     
@@ -217,39 +276,29 @@ void handleSequencerMode() {
       return;
     }
     
-    // Grid interaction - recalculate grid layout
-    int gridSpacing = 10;
-    int gridX = gridSpacing;
-    int gridY = CONTENT_TOP + 5;
-    int availableWidth = SCREEN_WIDTH - (2 * gridSpacing);
-    int availableHeight = SCREEN_HEIGHT - gridY - 80;
-    int labelWidth = 35;
-    int cellSpacing = 2;
-    int cellW = (availableWidth - labelWidth - (SEQ_STEPS + 1) * cellSpacing) / SEQ_STEPS;
-    int cellH = (availableHeight - (SEQ_TRACKS + 1) * cellSpacing) / SEQ_TRACKS;
-    
+    // Grid interaction - use cached cell rects
     for (int track = 0; track < SEQ_TRACKS; track++) {
       for (int step = 0; step < SEQ_STEPS; step++) {
-        int x = gridX + labelWidth + step * (cellW + cellSpacing);
-        int y = gridY + track * (cellH + cellSpacing);
+        const SeqCellRect& cell = seqCellRects[track][step];
         
-        if (isButtonPressed(x, y, cellW, cellH)) {
+        if (isButtonPressed(cell.x, cell.y, cell.w, cell.h)) {
           toggleSequencerStep(track, step);
-          drawSequencerGrid();
+          refreshSequencerGrid();
           return;
         }
       }
     }
   }
   
-  // Update sequencer timing
-  updateSequencer();
+  // Steps run on the step clock; repaint the playhead columns it moved
+  refreshSequencerGrid();
 }
 
 void toggleSequencerStep(int track, int step) {
   sequencePattern[track][step] = !sequencePattern[track][step];
 }
 
+// Step clock tick: note timing only, the handler redraws
 void updateSequencer() {
   if (!sequencerPlaying) return;
   
@@ -285,7 +334,6 @@ void updateSequencer() {
     playSequencerStep();
     currentStep = (currentStep + 1) % SEQ_STEPS;
     lastStepTime = now;
-    drawSequencerGrid();
   }
 }
 
@@ -0,0 +1,414 @@
+#include "storage.h"
+#include "web_server.h"
+#include "metrics.h"
+#include <unistd.h>
+
+SemaphoreHandle_t Storage::mutex = nullptr;
+bool Storage::mounted = false;
+unsigned long Storage::lastMountAttempt = 0;
+unsigned long Storage::lastCardCheck = 0;
+uint32_t Storage::generation = 0;
+
+bool Storage::begin() {
+  if (!mutex) {
+    mutex = xSemaphoreCreateRecursiveMutex();
+  }
+  xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+  bool ok = mounted || mount();
+  xSemaphoreGiveRecursive(mutex);
+  return ok;
+}
+
+bool Storage::mount() {
+  lastMountAttempt = millis();
+  
+  if (!SD.begin(SD_CS, sdSPI, STORAGE_SPI_FREQUENCY, STORAGE_MOUNT_POINT)) {
+    Serial.println("Storage: SD.begin() failed");
+    return false;
+  }
+  if (SD.cardType() == CARD_NONE) {
+    Serial.println("Storage: no SD card detected");
+    SD.end();
+    return false;
+  }
+  
+  mounted = true;
+  generation++;
+  sdCardAvailable = true;
+  lastCardCheck = millis();
+  Serial.println("Storage: SD card mounted");
+  return true;
+}
+
+bool Storage::checkCard() {
+  if (!mounted) return false;
+  lastCardCheck = millis();
+  
+  // Opening the root goes through FatFs's disk status check, which fails
+  // once the card stops answering
+  File root = SD.open("/");
+  if (root) {
+    root.close();
+    return true;
+  }
+  
+  Serial.println("Storage: SD card not responding, unmounting");
+  SD.end();
+  mounted = false;
+  sdCardAvailable = false;
+  return false;
+}
+
+bool Storage::acquire(TickType_t wait) {
+  if (!mutex) return false;
+  if (xSemaphoreTakeRecursive(mutex, wait) != pdTRUE) return false;
+  
+  if (mounted && millis() - lastCardCheck >= STORAGE_REMOUNT_INTERVAL) {
+    checkCard();
+  }
+  if (!mounted && millis() - lastMountAttempt >= STORAGE_REMOUNT_INTERVAL) {
+    mount();
+  }
+  if (!mounted) {
+    xSemaphoreGiveRecursive(mutex);
+    return false;
+  }
+  return true;
+}
+
+void Storage::release() {
+  xSemaphoreGiveRecursive(mutex);
+}
+
+// ============================================================================
+// StorageFuture
+// ============================================================================
+
+StorageFuture::StorageFuture() {
+  done = xSemaphoreCreateBinary();
+  value = {false, 0, 0};
+}
+
+StorageFuture::~StorageFuture() {
+  vSemaphoreDelete(done);
+}
+
+bool StorageFuture::wait(TickType_t timeout) {
+  return xSemaphoreTake(done, timeout) == pdTRUE;
+}
+
+void StorageFuture::complete(const StorageResult& result, void* context) {
+  StorageFuture* future = (StorageFuture*)context;
+  future->value = result;
+  xSemaphoreGive(future->done);
+}
+
+// ============================================================================
+// StorageWorker
+// ============================================================================
+
+QueueHandle_t StorageWorker::requestQueue = nullptr;
+QueueHandle_t StorageWorker::bufferPool = nullptr;
+File StorageWorker::files[STORAGE_MAX_HANDLES];
+bool StorageWorker::handleInUse[STORAGE_MAX_HANDLES] = {false};
+portMUX_TYPE StorageWorker::handleLock = portMUX_INITIALIZER_UNLOCKED;
+bool StorageWorker::handleFailed[STORAGE_MAX_HANDLES] = {false};
+uint32_t StorageWorker::handleGeneration[STORAGE_MAX_HANDLES] = {0};
+uint32_t StorageWorker::handleWritten[STORAGE_MAX_HANDLES] = {0};
+uint32_t StorageWorker::handlePreallocated[STORAGE_MAX_HANDLES] = {0};
+char StorageWorker::handlePaths[STORAGE_MAX_HANDLES][STORAGE_PATH_MAX];
+bool StorageWorker::running = false;
+uint32_t StorageWorker::bytesWritten = 0;
+uint32_t StorageWorker::bytesRead = 0;
+uint32_t StorageWorker::requestsDone = 0;
+uint32_t StorageWorker::requestsFailed = 0;
+uint32_t StorageWorker::busyMicros = 0;
+UBaseType_t StorageWorker::maxQueueDepth = 0;
+
+bool StorageWorker::begin() {
+  if (running) return true;
+  
+  requestQueue = xQueueCreate(STORAGE_QUEUE_LENGTH, sizeof(Request));
+  bufferPool = xQueueCreate(STORAGE_BUFFER_COUNT, sizeof(uint8_t*));
+  if (!requestQueue || !bufferPool) {
+    Serial.println("Storage worker: queue allocation failed");
+    return false;
+  }
+  
+  int buffers = 0;
+  for (int i = 0; i < STORAGE_BUFFER_COUNT; i++) {
+    uint8_t* buffer = (uint8_t*)malloc(STORAGE_BUFFER_SIZE);
+    if (!buffer) break;
+    xQueueSend(bufferPool, &buffer, 0);
+    buffers++;
+  }
+  if (buffers == 0) {
+    Serial.println("Storage worker: buffer allocation failed");
+    return false;
+  }
+  
+  running = true;
+  xTaskCreatePinnedToCore(
+    storageTask,
+    "StorageTask",
+    4096,
+    nullptr,
+    1,  // Priority
+    nullptr,
+    0   // Core 0
+  );
+  
+  Serial.printf("Storage worker started (%d x %d byte buffers)\n", buffers, STORAGE_BUFFER_SIZE);
+  return true;
+}
+
+uint8_t* StorageWorker::acquireBuffer(TickType_t wait) {
+  uint8_t* buffer = nullptr;
+  if (!running || xQueueReceive(bufferPool, &buffer, wait) != pdTRUE) return nullptr;
+  return buffer;
+}
+
+void StorageWorker::releaseBuffer(uint8_t* buffer) {
+  if (buffer) xQueueSend(bufferPool, &buffer, 0);
+}
+
+bool StorageWorker::submit(Request& request) {
+  if (!running) return false;
+  if (xQueueSend(requestQueue, &request, portMAX_DELAY) != pdTRUE) return false;
+  
+  UBaseType_t depth = uxQueueMessagesWaiting(requestQueue);
+  if (depth > maxQueueDepth) maxQueueDepth = depth;
+  return true;
+}
+
+// Slots are claimed by the loop and the web task and freed by the worker, so
+// the scan and the claim happen under one lock
+int StorageWorker::claimHandle() {
+  int claimed = -1;
+  portENTER_CRITICAL(&handleLock);
+  for (int i = 0; i < STORAGE_MAX_HANDLES; i++) {
+    if (handleInUse[i]) continue;
+    handleInUse[i] = true;
+    handleFailed[i] = false;
+    claimed = i;
+    break;
+  }
+  portEXIT_CRITICAL(&handleLock);
+  return claimed;
+}
+
+int StorageWorker::openWrite(const String& path, uint32_t preallocate) {
+  if (!running || path.length() >= STORAGE_PATH_MAX) return -1;
+  
+  int handle = claimHandle();
+  if (handle < 0) return -1;
+  
+  Request request = {OP_OPEN_WRITE, (int8_t)handle, false, nullptr, preallocate, nullptr, nullptr, {0}};
+  strncpy(request.path, path.c_str(), STORAGE_PATH_MAX - 1);
+  if (!submit(request)) {
+    handleInUse[handle] = false;
+    return -1;
+  }
+  return handle;
+}
+
+int StorageWorker::openRead(const String& path, uint32_t offset) {
+  if (!running || path.length() >= STORAGE_PATH_MAX) return -1;
+  
+  int handle = claimHandle();
+  if (handle < 0) return -1;
+  
+  Request request = {OP_OPEN_READ, (int8_t)handle, false, nullptr, offset, nullptr, nullptr, {0}};
+  strncpy(request.path, path.c_str(), STORAGE_PATH_MAX - 1);
+  if (!submit(request)) {
+    handleInUse[handle] = false;
+    return -1;
+  }
+  return handle;
+}
+
+bool StorageWorker::write(int handle, uint8_t* buffer, size_t length,
+                          StorageCallback callback, void* context) {
+  Request request = {OP_WRITE, (int8_t)handle, true, buffer, length, callback, context, {0}};
+  if (handle < 0 || handle >= STORAGE_MAX_HANDLES || !submit(request)) {
+    releaseBuffer(buffer);
+    return false;
+  }
+  return true;
+}
+
+bool StorageWorker::read(int handle, uint8_t* buffer, size_t length,
+                         StorageCallback callback, void* context) {
+  if (handle < 0 || handle >= STORAGE_MAX_HANDLES) return false;
+  Request request = {OP_READ, (int8_t)handle, false, buffer, length, callback, context, {0}};
+  return submit(request);
+}
+
+bool StorageWorker::close(int handle, StorageCallback callback, void* context) {
+  if (handle < 0 || handle >= STORAGE_MAX_HANDLES) return false;
+  Request request = {OP_CLOSE, (int8_t)handle, false, nullptr, 0, callback, context, {0}};
+  return submit(request);
+}
+
+bool StorageWorker::remove(const String& path, StorageCallback callback, void* context) {
+  if (path.length() >= STORAGE_PATH_MAX) return false;
+  Request request = {OP_REMOVE, -1, false, nullptr, 0, callback, context, {0}};
+  strncpy(request.path, path.c_str(), STORAGE_PATH_MAX - 1);
+  return submit(request);
+}
+
+void StorageWorker::waitIdle() {
+  if (!running) return;
+  StorageFuture future;
+  Request request = {OP_SYNC, -1, false, nullptr, 0, StorageFuture::complete, &future, {0}};
+  if (submit(request)) future.wait();
+}
+
+void StorageWorker::printStats() {
+  Serial.printf("Storage worker: %u requests (%u failed), %u KB written, %u KB read, "
+                "%u ms busy, max queue %u/%d\n",
+                (unsigned)requestsDone, (unsigned)requestsFailed,
+                (unsigned)(bytesWritten / 1024), (unsigned)(bytesRead / 1024),
+                (unsigned)(busyMicros / 1000), (unsigned)maxQueueDepth, STORAGE_QUEUE_LENGTH);
+}
+
+// Card time per operation for /metrics
+void StorageWorker::recordMetrics(Op op, uint32_t micros) {
+  switch (op) {
+    case OP_OPEN_WRITE:
+    case OP_OPEN_READ:
+      Metrics::recordStorage(Metrics::SD_OPEN, micros);
+      break;
+    case OP_WRITE:
+      Metrics::recordStorage(Metrics::SD_WRITE, micros);
+      break;
+    case OP_READ:
+      Metrics::recordStorage(Metrics::SD_READ, micros);
+      break;
+    case OP_CLOSE:
+      Metrics::recordStorage(Metrics::SD_CLOSE, micros);
+      break;
+    case OP_REMOVE:
+      Metrics::recordStorage(Metrics::SD_REMOVE, micros);
+      break;
+    case OP_SYNC:
+      break;  // Never touches the card
+  }
+}
+
+// A File opened before the card was unmounted or remounted still points at
+// the old mount's descriptor, which the new mount may have handed to another
+// file, so it must not be read, written or even closed. The handle fails and
+// the File object is parked on the heap instead of being destroyed; a card
+// pulled mid-transfer is rare enough that the few bytes don't matter.
+void StorageWorker::dropStaleFile(int handle) {
+  Serial.printf("Storage worker: handle %d was opened on an earlier mount\n", handle);
+  if (files[handle]) new File(files[handle]);
+  files[handle] = File();
+  handleFailed[handle] = true;
+}
+
+void StorageWorker::process(Request& request) {
+  StorageResult result = {false, 0, 0};
+  uint32_t start = micros();
+  int h = request.handle;
+  
+  {
+    StorageSession session;
+    bool opening = request.op == OP_OPEN_WRITE || request.op == OP_OPEN_READ;
+    if (h >= 0 && !opening && files[h] &&
+        (!Storage::isMounted() || handleGeneration[h] != Storage::mountGeneration())) {
+      dropStaleFile(h);
+    }
+    bool usable = session && (h < 0 || !handleFailed[h]);
+    
+    switch (request.op) {
+      case OP_OPEN_WRITE:
+        if (session) files[h] = SD.open(request.path, FILE_WRITE);
+        handleGeneration[h] = Storage::mountGeneration();
+        result.ok = session && files[h];
+        handleFailed[h] = !result.ok;
+        handleWritten[h] = 0;
+        handlePreallocated[h] = 0;
+        strcpy(handlePaths[h], request.path);
+        if (!result.ok) {
+          Serial.printf("Storage worker: can't open %s for writing\n", request.path);
+        } else if (request.length > 0) {
+          // Seeking past the end of a file opened for writing makes FatFs
+          // allocate the clusters; if it fails (card full) just grow as we go
+          if (files[h].seek(request.length)) handlePreallocated[h] = request.length;
+          result.ok = files[h].seek(0);
+          handleFailed[h] = !result.ok;
+        }
+        break;
+        
+      case OP_OPEN_READ:
+        if (session) files[h] = SD.open(request.path, FILE_READ);
+        handleGeneration[h] = Storage::mountGeneration();
+        result.ok = session && files[h] && (request.length == 0 || files[h].seek(request.length));
+        handleFailed[h] = !result.ok;
+        break;
+        
+      case OP_WRITE:
+        if (usable) {
+          result.bytes = files[h].write(request.buffer, request.length);
+          result.ok = result.bytes == request.length;
+          bytesWritten += result.bytes;
+          handleWritten[h] += result.bytes;
+          if (!result.ok) handleFailed[h] = true;  // Card full or gone - fail the rest
+        }
+        break;
+        
+      case OP_READ:
+        if (usable) {
+          result.bytes = files[h].read(request.buffer, request.length);
+          result.ok = true;
+          bytesRead += result.bytes;
+        }
+        break;
+        
+      case OP_CLOSE:
+        if (files[h]) files[h].close();
+        result.ok = session && !handleFailed[h];
+        if (result.ok && handlePreallocated[h] > handleWritten[h]) {
+          // Give back the unused part of the preallocation
+          String fullPath = String(STORAGE_MOUNT_POINT) + handlePaths[h];
+          result.ok = truncate(fullPath.c_str(), handleWritten[h]) == 0;
+        }
+        handlePreallocated[h] = 0;
+        files[h] = File();
+        handleFailed[h] = false;
+        handleInUse[h] = false;
+        break;
+        
+      case OP_REMOVE:
+        result.ok = session && SD.remove(request.path);
+        break;
+        
+      case OP_SYNC:
+        result.ok = true;
+        break;
+    }
+    
+    // A pulled card shows up as failed requests
+    if (!result.ok && session) Storage::checkCard();
+  }
+  
+  result.micros = micros() - start;
+  busyMicros += result.micros;
+  recordMetrics(request.op, result.micros);
+  requestsDone++;
+  if (!result.ok) requestsFailed++;
+  
+  if (request.ownsBuffer) releaseBuffer(request.buffer);
+  if (request.callback) request.callback(result, request.context);
+}
+
+void StorageWorker::storageTask(void* parameter) {
+  Request request;
+  while (true) {
+    if (xQueueReceive(requestQueue, &request, portMAX_DELAY) == pdTRUE) {
+      process(request);
+    }
+  }
+}
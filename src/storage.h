@@ -0,0 +1,178 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include <FS.h>
+#include <SPI.h>
+
+// Storage service
+// The SD card is mounted once at boot and stays mounted. Anything that touches
+// SD borrows it through a StorageSession for the duration of one operation:
+//
+//   StorageSession session;
+//   if (!session) return;        // No card
+//   File f = SD.open(...);
+//
+// Sessions serialise SD access across tasks with a recursive mutex, so a
+// handler can call a helper that opens its own session. If the card wasn't
+// present at boot, a session retries the mount at most every
+// STORAGE_REMOUNT_INTERVAL ms, so inserting a card later works. The driver
+// doesn't notice a pulled card, so while mounted a session probes it at the
+// same interval (and the worker probes after any failed request); a card that
+// doesn't answer is unmounted and the retry takes over.
+#define STORAGE_SPI_FREQUENCY   4000000
+#define STORAGE_REMOUNT_INTERVAL 3000
+
+class Storage {
+public:
+  // Mount the card. Returns false if no card is present.
+  static bool begin();
+  static bool isMounted() { return mounted; }
+  // Changes on every mount, so a File kept open across sessions can tell
+  // whether it still belongs to the current mount
+  static uint32_t mountGeneration() { return generation; }
+  // Take/release the card. acquire() fails if the card isn't mounted.
+  static bool acquire(TickType_t wait = portMAX_DELAY);
+  static void release();
+  // Probe a mounted card; unmounts and returns false if it has gone.
+  // Call with the card held.
+  static bool checkCard();
+  
+private:
+  static bool mount();
+  static SemaphoreHandle_t mutex;
+  static bool mounted;
+  static unsigned long lastMountAttempt;
+  static unsigned long lastCardCheck;
+  static uint32_t generation;
+};
+
+class StorageSession {
+public:
+  StorageSession() : held(Storage::acquire()) {}
+  ~StorageSession() { if (held) Storage::release(); }
+  explicit operator bool() const { return held; }
+  
+private:
+  StorageSession(const StorageSession&) = delete;
+  StorageSession& operator=(const StorageSession&) = delete;
+  bool held;
+};
+
+// Storage worker
+// Moves SD I/O off the main loop. Requests go into a bounded queue and are run
+// in order by a task on core 0, each inside its own StorageSession; the
+// optional callback runs on that task when the request completes.
+//
+// Files are opened into one of STORAGE_MAX_HANDLES slots. open*() reserves the
+// slot immediately and returns its handle, so writes can be queued before the
+// open has actually run; if the open fails, later requests on the handle fail
+// too and close() reports it.
+//
+// Writes take ownership of a transfer buffer from acquireBuffer() and give it
+// back to the pool when done. acquireBuffer() blocks while all buffers are in
+// flight, which throttles producers to the speed of the card.
+//
+// openWrite() can preallocate the expected size: the cluster chain is reserved
+// in one go instead of growing (and updating the FAT) cluster by cluster, and
+// close() trims the file back to the bytes actually written.
+#define STORAGE_QUEUE_LENGTH  16
+#define STORAGE_BUFFER_SIZE   8192
+#define STORAGE_BUFFER_COUNT  4
+#define STORAGE_MAX_HANDLES   4
+#define STORAGE_PATH_MAX      96
+#define STORAGE_MOUNT_POINT   "/sd"  // VFS path of the card, for POSIX calls
+
+struct StorageResult {
+  bool ok;
+  size_t bytes;
+  uint32_t micros;  // Time spent on the card
+};
+
+typedef void (*StorageCallback)(const StorageResult& result, void* context);
+
+// Lets a task block on a queued request: pass StorageFuture::complete as the
+// callback and the future as its context, then wait()
+class StorageFuture {
+public:
+  StorageFuture();
+  ~StorageFuture();
+  bool wait(TickType_t timeout = portMAX_DELAY);
+  const StorageResult& result() const { return value; }
+  static void complete(const StorageResult& result, void* context);
+  
+private:
+  StorageFuture(const StorageFuture&) = delete;
+  StorageFuture& operator=(const StorageFuture&) = delete;
+  SemaphoreHandle_t done;
+  StorageResult value;
+};
+
+class StorageWorker {
+public:
+  static bool begin();
+  static bool isRunning() { return running; }
+  
+  // Returns a handle, or -1 if no slot is free or the queue is full
+  static int openWrite(const String& path, uint32_t preallocate = 0);
+  static int openRead(const String& path, uint32_t offset = 0);
+  static bool write(int handle, uint8_t* buffer, size_t length,
+                    StorageCallback callback = nullptr, void* context = nullptr);
+  // Reads the next 'length' bytes into the caller's buffer; result.bytes is the count read
+  static bool read(int handle, uint8_t* buffer, size_t length,
+                   StorageCallback callback, void* context);
+  static bool close(int handle, StorageCallback callback = nullptr, void* context = nullptr);
+  static bool remove(const String& path, StorageCallback callback = nullptr, void* context = nullptr);
+  
+  // Transfer buffers of STORAGE_BUFFER_SIZE bytes
+  static uint8_t* acquireBuffer(TickType_t wait = portMAX_DELAY);
+  static void releaseBuffer(uint8_t* buffer);
+  
+  // Block until everything queued so far has completed
+  static void waitIdle();
+  static void printStats();
+  
+private:
+  enum Op : uint8_t { OP_OPEN_WRITE, OP_OPEN_READ, OP_WRITE, OP_READ, OP_CLOSE, OP_REMOVE, OP_SYNC };
+  
+  struct Request {
+    Op op;
+    int8_t handle;
+    bool ownsBuffer;
+    uint8_t* buffer;
+    size_t length;      // Also the seek offset for OP_OPEN_READ, preallocation for OP_OPEN_WRITE
+    StorageCallback callback;
+    void* context;
+    char path[STORAGE_PATH_MAX];
+  };
+  
+  static int claimHandle();
+  static bool submit(Request& request);
+  static void process(Request& request);
+  static void dropStaleFile(int handle);
+  static void recordMetrics(Op op, uint32_t micros);
+  static void storageTask(void* parameter);
+  
+  static QueueHandle_t requestQueue;
+  static QueueHandle_t bufferPool;
+  static File files[STORAGE_MAX_HANDLES];
+  static bool handleInUse[STORAGE_MAX_HANDLES];
+  static portMUX_TYPE handleLock;  // Guards claiming a slot
+  static bool handleFailed[STORAGE_MAX_HANDLES];
+  static uint32_t handleGeneration[STORAGE_MAX_HANDLES];  // Mount the file was opened on
+  static uint32_t handleWritten[STORAGE_MAX_HANDLES];
+  static uint32_t handlePreallocated[STORAGE_MAX_HANDLES];
+  static char handlePaths[STORAGE_MAX_HANDLES][STORAGE_PATH_MAX];  // For trimming on close
+  static bool running;
+  
+  // I/O accounting
+  static uint32_t bytesWritten;
+  static uint32_t bytesRead;
+  static uint32_t requestsDone;
+  static uint32_t requestsFailed;
+  static uint32_t busyMicros;
+  static UBaseType_t maxQueueDepth;
+};
+
+#endif // STORAGE_H
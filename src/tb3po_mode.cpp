@@ -3,6 +3,7 @@
  *******************************************************************/
 
 #include "tb3po_mode.h"
+#include "param_registry.h"
 
 TB3POState tb3po;
 
@@ -154,6 +155,24 @@ static bool stepIsAccent(int stepNum) {
   return (tb3po.accents & (1 << stepNum)) != 0;
 }
 
+static void tickTB3PO();
+
+static void drawDensity(int y) {
+  int displayDens = abs((int)tb3po.density - 7);
+  String densStr = "DENS: ";
+  if (tb3po.density < 7) densStr += "-";
+  densStr += String(displayDens);
+  tft.fillRect(300, y, SCREEN_WIDTH - 300, 16, THEME_BG);
+  tft.setTextColor(THEME_TEXT, THEME_BG);
+  tft.drawString(densStr, 300, y, 2);
+}
+
+// Remote density change: the label and the steps it re-gated
+static void refreshDensity() {
+  drawDensity(CONTENT_TOP + 40);
+  updateTB3POSteps();
+}
+
 void initializeTB3POMode() {
   Serial.println("\n=== TB-3PO Mode Initialization ===");
   
@@ -181,6 +200,7 @@ void initializeTB3POMode() {
   tft.fillScreen(THEME_BG);
   drawModuleHeader("TB-3PO", true);
   drawTB3POMode();
+  StepClock::start(TB3PO, tickTB3PO);
   
   Serial.println("TB-3PO initialized and drawn");
 }
@@ -207,11 +227,7 @@ void drawTB3POMode() {
   tft.drawString("STEPS: " + String(tb3po.numSteps), 150, y, 2);
   
   // Density
-  int displayDens = abs((int)tb3po.density - 7);
-  String densStr = "DENS: ";
-  if (tb3po.density < 7) densStr += "-";
-  densStr += String(displayDens);
-  tft.drawString(densStr, 300, y, 2);
+  drawDensity(y);
   
   y += 30;
   
@@ -229,10 +245,13 @@ void drawTB3POMode() {
   int stepHeight = 40;
   int startX = 10;
   
+  // The step clock may move on while we draw; the handler catches up next pass
+  tb3po.drawnStep = tb3po.playing ? tb3po.step : 0xFF;
+  
   for (int i = 0; i < tb3po.numSteps; i++) {
     int x = startX + (i * stepWidth);
     
-    bool isCurrentStep = (i == tb3po.step && tb3po.playing);
+    bool isCurrentStep = (i == tb3po.drawnStep);
     bool isGated = stepIsGated(i);
     bool isSlid = stepIsSlid(i);
     bool isAccent = stepIsAccent(i);
@@ -279,10 +298,13 @@ void updateTB3POSteps() {
   int stepHeight = 40;
   int startX = 10;
   
+  // The step clock may move on while we draw; the handler catches up next pass
+  tb3po.drawnStep = tb3po.playing ? tb3po.step : 0xFF;
+  
   for (int i = 0; i < tb3po.numSteps; i++) {
     int x = startX + (i * stepWidth);
     
-    bool isCurrentStep = (i == tb3po.step && tb3po.playing);
+    bool isCurrentStep = (i == tb3po.drawnStep);
     bool isGated = stepIsGated(i);
     bool isSlid = stepIsSlid(i);
     bool isAccent = stepIsAccent(i);
@@ -309,6 +331,48 @@ void updateTB3POSteps() {
   }
 }
 
+// Step clock tick: playback timing and notes, no drawing
+static void tickTB3PO() {
+  if (!tb3po.playing || !tb3po.useInternalClock) return;
+  
+  unsigned long now = millis();
+  
+  // Calculate step interval from BPM (16th notes)
+  tb3po.stepInterval = (60000.0 / tb3po.bpm) / 4.0;
+  
+  if (now - tb3po.lastStepTime >= tb3po.stepInterval) {
+    tb3po.lastStepTime = now;
+    ParamRegistry::applyTick(TB3PO);
+    
+    Serial.printf("TB3PO Step %d: gate=%d accent=%d slide=%d\n", 
+                  tb3po.step, stepIsGated(tb3po.step), 
+                  stepIsAccent(tb3po.step), stepIsSlid(tb3po.step));
+    
+    // Stop previous note if playing
+    if (tb3po.currentNote >= 0) {
+      sendNoteOff(tb3po.currentNote);
+      Serial.printf("  Note OFF: %d\n", tb3po.currentNote);
+      tb3po.currentNote = -1;
+    }
+    
+    // Play current step if gated
+    if (stepIsGated(tb3po.step)) {
+      int note = getMIDINoteForStep(tb3po.step);
+      int velocity = stepIsAccent(tb3po.step) ? 127 : 100;
+      
+      Serial.printf("  Note ON: %d vel=%d\n", note, velocity);
+      sendNoteOn(note, velocity);
+      tb3po.currentNote = note;
+    }
+    
+    // Advance step
+    tb3po.step++;
+    if (tb3po.step >= tb3po.numSteps) {
+      tb3po.step = 0;
+    }
+  }
+}
+
 void handleTB3POMode() {
   updateTouch();
   
@@ -318,7 +382,6 @@ void handleTB3POMode() {
       tb3po.readyForInput = true;
       Serial.println("TB3PO ready for input");
     }
-    // Still handle playback timing even during wait
   }
   
   // Calculate button layout matching drawTB3POMode
@@ -346,45 +409,9 @@ void handleTB3POMode() {
     drawRoundButton(310, btnY, 90, btnH, "SCALE", THEME_SUCCESS, scalePressed);
   }
   
-  // Handle playback timing
-  if (tb3po.playing && tb3po.useInternalClock) {
-    unsigned long now = millis();
-    
-    // Calculate step interval from BPM (16th notes)
-    tb3po.stepInterval = (60000.0 / tb3po.bpm) / 4.0;
-    
-    if (now - tb3po.lastStepTime >= tb3po.stepInterval) {
-      tb3po.lastStepTime = now;
-      
-      Serial.printf("TB3PO Step %d: gate=%d accent=%d slide=%d\n", 
-                    tb3po.step, stepIsGated(tb3po.step), 
-                    stepIsAccent(tb3po.step), stepIsSlid(tb3po.step));
-      
-      // Stop previous note if playing
-      if (tb3po.currentNote >= 0) {
-        sendNoteOff(tb3po.currentNote);
-        Serial.printf("  Note OFF: %d\n", tb3po.currentNote);
-        tb3po.currentNote = -1;
-      }
-      
-      // Play current step if gated
-      if (stepIsGated(tb3po.step)) {
-        int note = getMIDINoteForStep(tb3po.step);
-        int velocity = stepIsAccent(tb3po.step) ? 127 : 100;
-        
-        Serial.printf("  Note ON: %d vel=%d\n", note, velocity);
-        sendNoteOn(note, velocity);
-        tb3po.currentNote = note;
-      }
-      
-      // Advance step
-      tb3po.step++;
-      if (tb3po.step >= tb3po.numSteps) {
-        tb3po.step = 0;
-      }
-      
-      updateTB3POSteps();  // Only redraw step indicators, not entire screen
-    }
+  // Steps run on the step clock; move the highlight when it has advanced
+  if ((tb3po.playing ? tb3po.step : 0xFF) != tb3po.drawnStep) {
+    updateTB3POSteps();
   }
   
   // Debug touch state changes only
@@ -402,6 +429,7 @@ void handleTB3POMode() {
     // Play/Stop button
     if (playPressed) {
       Serial.printf("PLAY/STOP pressed. Was playing: %d\n", tb3po.playing);
+      StepClock::lock();
       tb3po.playing = !tb3po.playing;
       if (!tb3po.playing && tb3po.currentNote >= 0) {
         sendNoteOff(tb3po.currentNote);
@@ -409,6 +437,9 @@ void handleTB3POMode() {
       }
       if (tb3po.playing) {
         tb3po.lastStepTime = millis();
+      }
+      StepClock::unlock();
+      if (tb3po.playing) {
         Serial.printf("Now playing. Step interval: %lu ms\n", tb3po.stepInterval);
       } else {
         Serial.println("Stopped");
@@ -418,7 +449,9 @@ void handleTB3POMode() {
     // Regenerate button
     else if (regenPressed) {
       Serial.println("REGEN pressed");
+      StepClock::lock();
       regenerateAll();
+      StepClock::unlock();
       drawTB3POMode();
     }
     // Seed lock button
@@ -426,25 +459,30 @@ void handleTB3POMode() {
       Serial.printf("SEED pressed. Locked: %d -> %d\n", tb3po.lockSeed, !tb3po.lockSeed);
       tb3po.lockSeed = !tb3po.lockSeed;
       if (!tb3po.lockSeed) {
+        StepClock::lock();
         reseed();
         regenerateAll();
+        StepClock::unlock();
       }
       drawTB3POMode();
     }
     // Scale button
     else if (scalePressed) {
       Serial.printf("SCALE pressed. Index: %d -> %d\n", tb3po.scaleIndex, (tb3po.scaleIndex + 1) % NUM_SCALES);
+      StepClock::lock();
       tb3po.scaleIndex++;
       if (tb3po.scaleIndex >= NUM_SCALES) {
         tb3po.scaleIndex = 0;
       }
       regenerateAll();
+      StepClock::unlock();
       drawTB3POMode();
     }
 
     // Check back button from header (standard position)
     else if (isButtonPressed(BACK_BTN_X, BACK_BTN_Y, BTN_BACK_W, BTN_BACK_H)) {
       Serial.println("BACK pressed (header)");
+      StepClock::stop();
       if (tb3po.currentNote >= 0) {
         sendNoteOff(tb3po.currentNote);
       }
@@ -455,9 +493,11 @@ void handleTB3POMode() {
     // Density control (tap on density display area)
     else if (isButtonPressed(300, CONTENT_TOP + 30, 150, 20)) {
       Serial.printf("DENSITY pressed: %d -> %d\n", tb3po.density, (tb3po.density + 1) % 15);
+      StepClock::lock();
       tb3po.density++;
       if (tb3po.density > 14) tb3po.density = 0;
       applyDensity();
+      StepClock::unlock();
       drawTB3POMode();
     }
     // BPM control
@@ -471,12 +511,35 @@ void handleTB3POMode() {
     // Root note control
     else if (isButtonPressed(250, CONTENT_TOP + 60, 80, 20)) {
       Serial.printf("ROOT pressed: %d -> %d\n", tb3po.rootNote, (tb3po.rootNote + 1) % 12);
+      StepClock::lock();
       tb3po.rootNote++;
       if (tb3po.rootNote > 11) tb3po.rootNote = 0;
       regenerateAll();
+      StepClock::unlock();
       drawTB3POMode();
     } else {
       Serial.println("TB3PO touch - no button hit");
     }
   }
 }
+
+// Remote parameters
+void publishTB3POParams() {
+  ParamRegistry::add("tb3po.playing", TB3PO, 0, 1, false,
+    []() -> int16_t { return tb3po.playing; },
+    [](int16_t v) {
+      if (tb3po.playing == (bool)v) return;
+      tb3po.playing = v;
+      if (!tb3po.playing && tb3po.currentNote >= 0) {
+        sendNoteOff(tb3po.currentNote);
+        tb3po.currentNote = -1;
+      }
+      if (tb3po.playing) tb3po.lastStepTime = millis();
+    }, drawTB3POMode);
+  ParamRegistry::add("tb3po.bpm", TB3PO, TB3PO_MIN_BPM, TB3PO_MAX_BPM, false,
+    []() -> int16_t { return (int16_t)tb3po.bpm; },
+    [](int16_t v) { tb3po.bpm = v; }, drawTB3POMode);
+  ParamRegistry::add("tb3po.density", TB3PO, 0, 14, true,
+    []() -> int16_t { return tb3po.density; },
+    [](int16_t v) { tb3po.density = v; applyDensity(); }, refreshDensity);
+}
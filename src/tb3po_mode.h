@@ -35,6 +35,7 @@ struct TB3POState {
   unsigned long lastStepTime = 0;
   unsigned long stepInterval = 125; // milliseconds per step (120 BPM, 16th notes)
   int currentNote = -1;
+  uint8_t drawnStep = 0xFF; // Step highlighted on screen (0xFF = none)
   
   // Generation parameters
   uint16_t seed = 12345;
@@ -59,5 +60,6 @@ void initializeTB3POMode();
 void drawTB3POMode();
 void updateTB3POSteps();  // Efficient partial redraw
 void handleTB3POMode();
+void publishTB3POParams();
 
 #endif
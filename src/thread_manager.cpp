@@ -1,5 +1,10 @@
 #include "common_definitions.h"
+#include "boot_timeline.h"
+#include "rtp_midi.h"
+#include "osc_bridge.h"
+#include "metrics.h"
 #include <Arduino.h>
+#include <esp_heap_caps.h>
 
 // Global state instance
 GlobalState globalState;
@@ -94,7 +99,7 @@ void MIDIThread::sendNoteOn(uint8_t note, uint8_t velocity) {
   msg.type = MIDIMessage::NOTE_ON;
   msg.data1 = note;
   msg.data2 = velocity;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
 }
 
 void MIDIThread::sendNoteOff(uint8_t note, uint8_t velocity) {
@@ -102,7 +107,7 @@ void MIDIThread::sendNoteOff(uint8_t note, uint8_t velocity) {
   msg.type = MIDIMessage::NOTE_OFF;
   msg.data1 = note;
   msg.data2 = velocity;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
 }
 
 void MIDIThread::sendCC(uint8_t controller, uint8_t value) {
@@ -110,32 +115,41 @@ void MIDIThread::sendCC(uint8_t controller, uint8_t value) {
   msg.type = MIDIMessage::CC;
   msg.data1 = controller;
   msg.data2 = value;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
 }
 
 void MIDIThread::sendPitchBend(int16_t value) {
   MIDIMessage msg;
   msg.type = MIDIMessage::PITCH_BEND;
   msg.data16 = value;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
 }
 
 void MIDIThread::sendClock() {
   MIDIMessage msg;
   msg.type = MIDIMessage::CLOCK;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
 }
 
 void MIDIThread::sendStart() {
   MIDIMessage msg;
   msg.type = MIDIMessage::START;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
 }
 
 void MIDIThread::sendStop() {
   MIDIMessage msg;
   msg.type = MIDIMessage::STOP;
-  xQueueSend(midiQueue, &msg, 0);
+  enqueue(msg);
+}
+
+// Never blocks the caller; a full queue drops the message
+void MIDIThread::enqueue(const MIDIMessage& msg) {
+  if (xQueueSend(midiQueue, &msg, 0) != pdTRUE) {
+    Metrics::midiDropped();
+    return;
+  }
+  Metrics::midiQueued(uxQueueMessagesWaiting(midiQueue));
 }
 
 void MIDIThread::setBPM(float bpm) {
@@ -177,70 +191,278 @@ void MIDIThread::midiTask(void* parameter) {
     
     // Process queued MIDI messages
     if (xQueueReceive(midiQueue, &msg, 1 / portTICK_PERIOD_MS)) {
-      if (!globalState.bleConnected) {
-        continue;  // Skip if no BLE connection
+      if (!globalState.bleConnected && !networkMIDIActive()) {
+        continue;  // Skip if nobody is listening
       }
       
       uint8_t channel = globalState.currentMidiChannel - 1;  // 0-15
+      uint8_t message[3];
+      size_t length = 3;
       
       switch (msg.type) {
         case MIDIMessage::NOTE_ON:
-          midiPacket[2] = 0x90 | channel;  // Note On + channel
-          midiPacket[3] = msg.data1;       // Note
-          midiPacket[4] = msg.data2;       // Velocity
-          pCharacteristic->setValue(midiPacket, 5);
-          pCharacteristic->notify();
+          message[0] = 0x90 | channel;  // Note On + channel
+          message[1] = msg.data1;       // Note
+          message[2] = msg.data2;       // Velocity
+          BootTimeline::markFirstNote();
           break;
           
         case MIDIMessage::NOTE_OFF:
-          midiPacket[2] = 0x80 | channel;  // Note Off + channel
-          midiPacket[3] = msg.data1;       // Note
-          midiPacket[4] = msg.data2;       // Velocity
-          pCharacteristic->setValue(midiPacket, 5);
-          pCharacteristic->notify();
+          message[0] = 0x80 | channel;  // Note Off + channel
+          message[1] = msg.data1;       // Note
+          message[2] = msg.data2;       // Velocity
           break;
           
         case MIDIMessage::CC:
-          midiPacket[2] = 0xB0 | channel;  // CC + channel
-          midiPacket[3] = msg.data1;       // Controller
-          midiPacket[4] = msg.data2;       // Value
-          pCharacteristic->setValue(midiPacket, 5);
-          pCharacteristic->notify();
+          message[0] = 0xB0 | channel;  // CC + channel
+          message[1] = msg.data1;       // Controller
+          message[2] = msg.data2;       // Value
           break;
           
         case MIDIMessage::PITCH_BEND:
           {
             uint16_t bend = msg.data16 + 8192;  // Center at 8192
-            midiPacket[2] = 0xE0 | channel;     // Pitch Bend + channel
-            midiPacket[3] = bend & 0x7F;        // LSB
-            midiPacket[4] = (bend >> 7) & 0x7F; // MSB
-            pCharacteristic->setValue(midiPacket, 5);
-            pCharacteristic->notify();
+            message[0] = 0xE0 | channel;        // Pitch Bend + channel
+            message[1] = bend & 0x7F;           // LSB
+            message[2] = (bend >> 7) & 0x7F;    // MSB
           }
           break;
           
         case MIDIMessage::CLOCK:
-          midiPacket[2] = 0xF8;  // MIDI Clock
-          pCharacteristic->setValue(midiPacket, 3);
-          pCharacteristic->notify();
+          message[0] = 0xF8;  // MIDI Clock
+          length = 1;
           break;
           
         case MIDIMessage::START:
-          midiPacket[2] = 0xFA;  // MIDI Start
-          pCharacteristic->setValue(midiPacket, 3);
-          pCharacteristic->notify();
+          message[0] = 0xFA;  // MIDI Start
+          length = 1;
           globalState.isPlaying = true;
           break;
           
         case MIDIMessage::STOP:
-          midiPacket[2] = 0xFC;  // MIDI Stop
-          pCharacteristic->setValue(midiPacket, 3);
-          pCharacteristic->notify();
+          message[0] = 0xFC;  // MIDI Stop
+          length = 1;
           globalState.isPlaying = false;
           break;
       }
+      
+      // Same stream to every transport
+      if (globalState.bleConnected) {
+        memcpy(midiPacket + 2, message, length);
+        pCharacteristic->setValue(midiPacket, length + 2);
+        pCharacteristic->notify();
+      }
+      sendMIDIToNetwork(message, length);
     }
     
     vTaskDelay(1 / portTICK_PERIOD_MS);  // 1ms tick
   }
 }
+
+
+bool networkMIDIActive() {
+  return RtpMidi::hasPeers() || OscBridge::hasTargets();
+}
+
+void sendMIDIToNetwork(const uint8_t* message, size_t length) {
+  RtpMidi::send(message, length);
+  OscBridge::send(message, length);
+}
+
+
+// StepClock implementation
+SemaphoreHandle_t StepClock::clockMutex = nullptr;
+AppMode StepClock::tickMode = MENU;
+StepTick StepClock::tickFunction = nullptr;
+
+void StepClock::begin() {
+  clockMutex = xSemaphoreCreateMutex();
+  
+  // Same core as the loop but above it, so a step preempts a redraw
+  xTaskCreatePinnedToCore(
+    clockTask,
+    "StepClock",
+    4096,
+    nullptr,
+    2,  // Priority (loop runs at 1)
+    nullptr,
+    1   // Core 1
+  );
+}
+
+void StepClock::start(AppMode mode, StepTick tick) {
+  lock();
+  tickMode = mode;
+  tickFunction = tick;
+  unlock();
+}
+
+void StepClock::stop() {
+  start(MENU, nullptr);
+}
+
+void StepClock::lock() {
+  if (clockMutex) xSemaphoreTake(clockMutex, portMAX_DELAY);
+}
+
+void StepClock::unlock() {
+  if (clockMutex) xSemaphoreGive(clockMutex);
+}
+
+void StepClock::clockTask(void* parameter) {
+  TickType_t lastWake = xTaskGetTickCount();
+  
+  while (true) {
+    vTaskDelayUntil(&lastWake, max<TickType_t>(1, STEP_CLOCK_PERIOD_MS / portTICK_PERIOD_MS));
+    
+    // Modes that return to the menu by setting currentMode skip stop()
+    lock();
+    if (tickFunction && tickMode == currentMode) tickFunction();
+    unlock();
+  }
+}
+
+// RenderThread implementation
+QueueHandle_t RenderThread::tileQueue = nullptr;
+QueueHandle_t RenderThread::freeQueue = nullptr;
+SemaphoreHandle_t RenderThread::displayMutex = nullptr;
+uint16_t* RenderThread::tileBuffers[RENDER_TILE_BUFFERS] = {nullptr};
+bool RenderThread::running = false;
+bool RenderThread::dmaEnabled = false;
+int16_t RenderThread::inFlight = -1;
+
+void RenderThread::begin() {
+  displayMutex = xSemaphoreCreateMutex();
+  tileQueue = xQueueCreate(RENDER_TILE_BUFFERS, sizeof(RenderTile));
+  freeQueue = xQueueCreate(RENDER_TILE_BUFFERS, sizeof(uint8_t));
+  
+  // Tile buffers must be DMA-capable internal RAM
+  for (uint8_t i = 0; i < RENDER_TILE_BUFFERS; i++) {
+    tileBuffers[i] = (uint16_t*)heap_caps_malloc(RENDER_TILE_MAX_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA);
+    if (!tileBuffers[i]) {
+      Serial.println("RenderThread: tile buffer allocation failed, drawing stays synchronous");
+      return;
+    }
+    xQueueSend(freeQueue, &i, 0);
+  }
+  
+#ifdef ESP32_DMA
+  // Not available on ILI9488 (18-bit SPI) - tiles fall back to blocking pushImage
+  dmaEnabled = tft.initDMA();
+#endif
+  
+  // Create render task on Core 0, away from the loop and MIDI task on Core 1
+  xTaskCreatePinnedToCore(
+    renderTask,
+    "RenderTask",
+    3072,
+    nullptr,
+    1,  // Priority
+    nullptr,
+    0   // Core 0
+  );
+  
+  running = true;
+}
+
+bool RenderThread::isRunning() {
+  return running;
+}
+
+bool RenderThread::lockDisplay(TickType_t wait) {
+  if (!displayMutex) return true;
+  return xSemaphoreTake(displayMutex, wait) == pdTRUE;
+}
+
+void RenderThread::unlockDisplay() {
+  if (displayMutex) xSemaphoreGive(displayMutex);
+}
+
+bool RenderThread::submitSprite(TFT_eSprite& sprite, int32_t x, int32_t y, int32_t w, int32_t h) {
+  if (!running || w <= 0 || h <= 0 || w * h > RENDER_TILE_MAX_PIXELS) return false;
+  
+  uint8_t buffer;
+  if (xQueueReceive(freeQueue, &buffer, 0) != pdTRUE) {
+    // All buffers queued - we own the display, so drain them here
+    flush();
+    if (xQueueReceive(freeQueue, &buffer, 0) != pdTRUE) return false;
+  }
+  
+  // Sprite pixels are already in display byte order
+  const uint16_t* src = (const uint16_t*)sprite.getPointer();
+  uint16_t* dst = tileBuffers[buffer];
+  int32_t spriteW = sprite.width();
+  for (int32_t row = 0; row < h; row++) {
+    memcpy(dst + row * w, src + row * spriteW, w * sizeof(uint16_t));
+  }
+  
+  RenderTile tile = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, buffer};
+  xQueueSend(tileQueue, &tile, 0);
+  return true;
+}
+
+void RenderThread::flush() {
+  if (!running) return;
+  
+  RenderTile tile;
+  while (xQueueReceive(tileQueue, &tile, 0) == pdTRUE) {
+    pushTile(tile);
+  }
+  finishTiles();
+}
+
+// Starts a tile on its way. With DMA the transfer runs on after this returns;
+// the buffer is freed once the next transfer starts (pushImageDMA first waits
+// for the previous one) or finishTiles() has waited for it.
+void RenderThread::pushTile(const RenderTile& tile) {
+  bool oldSwapBytes = tft.getSwapBytes();
+  tft.setSwapBytes(false);
+  
+#ifdef ESP32_DMA
+  if (dmaEnabled) {
+    if (inFlight < 0) tft.startWrite();  // One transaction per batch
+    tft.pushImageDMA(tile.x, tile.y, tile.w, tile.h, tileBuffers[tile.buffer]);
+    tft.setSwapBytes(oldSwapBytes);
+    if (inFlight >= 0) {
+      uint8_t done = inFlight;
+      xQueueSend(freeQueue, &done, 0);
+    }
+    inFlight = tile.buffer;
+    return;
+  }
+#endif
+  
+  tft.pushImage(tile.x, tile.y, tile.w, tile.h, tileBuffers[tile.buffer]);
+  tft.setSwapBytes(oldSwapBytes);
+  xQueueSend(freeQueue, &tile.buffer, 0);
+}
+
+// Waits for the last transfer of a batch; call before giving up the bus
+void RenderThread::finishTiles() {
+#ifdef ESP32_DMA
+  if (inFlight < 0) return;
+  tft.dmaWait();
+  tft.endWrite();
+  uint8_t done = inFlight;
+  xQueueSend(freeQueue, &done, 0);
+  inFlight = -1;
+#endif
+}
+
+void RenderThread::renderTask(void* parameter) {
+  RenderTile tile;
+  
+  while (true) {
+    // Wait for work without holding the bus
+    xQueuePeek(tileQueue, &tile, portMAX_DELAY);
+    
+    // Take ownership, then re-check: the loop may have flushed in the meantime
+    if (xSemaphoreTake(displayMutex, portMAX_DELAY)) {
+      while (xQueueReceive(tileQueue, &tile, 0) == pdTRUE) {
+        pushTile(tile);
+      }
+      finishTiles();
+      xSemaphoreGive(displayMutex);
+    }
+  }
+}
@@ -0,0 +1,154 @@
+#include "thumbnail.h"
+#include <SD.h>
+
+ThumbnailBuilder::ThumbnailBuilder(WriteCallback write, void* context)
+  : writeCallback(write), writeContext(context), sourceWidth(0), thumbWidth(0), thumbHeight(0),
+    rowsSummed(0), rowsWritten(0), thumbRowBytes(0), sums(nullptr), rowOut(nullptr) {
+}
+
+ThumbnailBuilder::~ThumbnailBuilder() {
+  free(sums);
+  free(rowOut);
+}
+
+static void putLE32(uint8_t* dst, uint32_t value) {
+  dst[0] = value & 0xFF;
+  dst[1] = (value >> 8) & 0xFF;
+  dst[2] = (value >> 16) & 0xFF;
+  dst[3] = (value >> 24) & 0xFF;
+}
+
+static uint32_t getLE32(const uint8_t* src) {
+  return src[0] | (src[1] << 8) | (src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+bool ThumbnailBuilder::begin(int width, int height) {
+  sourceWidth = width;
+  thumbWidth = width / THUMBNAIL_SCALE;
+  thumbHeight = height / THUMBNAIL_SCALE;
+  thumbRowBytes = (thumbWidth * 3 + 3) & ~3;
+  rowsSummed = 0;
+  rowsWritten = 0;
+  
+  sums = (uint16_t*)calloc(thumbWidth * 3, sizeof(uint16_t));
+  rowOut = (uint8_t*)calloc(thumbRowBytes, 1);
+  if (!sums || !rowOut || thumbWidth == 0 || thumbHeight == 0) return false;
+  
+  uint32_t imageSize = thumbRowBytes * thumbHeight;
+  uint8_t header[54] = {0};
+  header[0] = 'B'; header[1] = 'M';
+  putLE32(header + 2, imageSize + 54);
+  putLE32(header + 6, esp_random() | 1);  // Reserved field: ETag stamp (never 0)
+  putLE32(header + 10, 54);
+  putLE32(header + 14, 40);
+  putLE32(header + 18, thumbWidth);
+  putLE32(header + 22, thumbHeight);
+  header[26] = 1;
+  header[28] = 24;
+  putLE32(header + 34, imageSize);
+  writeCallback(header, sizeof(header), writeContext);
+  return true;
+}
+
+void ThumbnailBuilder::addRow(const uint8_t* bgr) {
+  if (!sums || rowsWritten >= thumbHeight) return;
+  
+  for (int tx = 0; tx < thumbWidth; tx++) {
+    const uint8_t* src = bgr + tx * THUMBNAIL_SCALE * 3;
+    uint16_t* sum = sums + tx * 3;
+    for (int i = 0; i < THUMBNAIL_SCALE; i++, src += 3) {
+      sum[0] += src[0];
+      sum[1] += src[1];
+      sum[2] += src[2];
+    }
+  }
+  
+  if (++rowsSummed < THUMBNAIL_SCALE) return;
+  
+  // A full block of rows: average and emit one thumbnail row
+  const int area = THUMBNAIL_SCALE * THUMBNAIL_SCALE;
+  for (int i = 0; i < thumbWidth * 3; i++) {
+    rowOut[i] = (sums[i] + area / 2) / area;
+  }
+  writeCallback(rowOut, thumbRowBytes, writeContext);
+  memset(sums, 0, thumbWidth * 3 * sizeof(uint16_t));
+  rowsSummed = 0;
+  rowsWritten++;
+}
+
+void ThumbnailBuilder::end() {
+  // Pad with black if the source ended early so the file matches its header
+  memset(rowOut, 0, thumbRowBytes);
+  while (rowOut && rowsWritten < thumbHeight) {
+    writeCallback(rowOut, thumbRowBytes, writeContext);
+    rowsWritten++;
+  }
+}
+
+String ThumbnailBuilder::pathFor(const String& imagePath) {
+  if (!imagePath.endsWith(".bmp") || isThumbnail(imagePath.c_str())) return String();
+  return imagePath.substring(0, imagePath.length() - 4) + ".thumb.bmp";
+}
+
+bool ThumbnailBuilder::isThumbnail(const char* name) {
+  size_t length = strlen(name);
+  return length > 10 && strcmp(name + length - 10, ".thumb.bmp") == 0;
+}
+
+uint32_t ThumbnailBuilder::readStamp(const String& thumbPath) {
+  File file = SD.open(thumbPath, FILE_READ);
+  if (!file) return 0;
+  uint8_t header[10];
+  size_t got = file.read(header, sizeof(header));
+  file.close();
+  return got == sizeof(header) ? getLE32(header + 6) : 0;
+}
+
+static void writeToFile(const uint8_t* data, size_t length, void* context) {
+  ((File*)context)->write(data, length);
+}
+
+bool ThumbnailBuilder::generate(const String& imagePath) {
+  File source = SD.open(imagePath, FILE_READ);
+  if (!source) return false;
+  
+  // Only the uncompressed 24-bit bottom-up BMPs that saveScreenshot writes
+  uint8_t header[54];
+  if (source.read(header, sizeof(header)) != sizeof(header) || header[0] != 'B' || header[1] != 'M' ||
+      header[28] != 24 || getLE32(header + 30) != 0 || (int32_t)getLE32(header + 22) <= 0) {
+    source.close();
+    return false;
+  }
+  int width = getLE32(header + 18);
+  int height = getLE32(header + 22);
+  size_t rowBytes = (width * 3 + 3) & ~3;
+  
+  uint8_t* row = (uint8_t*)malloc(rowBytes);
+  String thumbPath = pathFor(imagePath);
+  File thumb = (row && thumbPath.length() > 0) ? SD.open(thumbPath, FILE_WRITE) : File();
+  if (!thumb) {
+    free(row);
+    source.close();
+    return false;
+  }
+  
+  unsigned long startTime = millis();
+  ThumbnailBuilder builder(writeToFile, &thumb);
+  bool ok = builder.begin(width, height) && source.seek(getLE32(header + 10));
+  for (int y = 0; ok && y < height; y++) {
+    ok = source.read(row, rowBytes) == rowBytes;
+    if (ok) builder.addRow(row);
+  }
+  builder.end();
+  
+  thumb.close();
+  source.close();
+  free(row);
+  
+  if (!ok) {
+    SD.remove(thumbPath);
+    return false;
+  }
+  Serial.printf("Thumbnail generated: %s (%lu ms)\n", thumbPath.c_str(), millis() - startTime);
+  return true;
+}
@@ -0,0 +1,51 @@
+#ifndef THUMBNAIL_H
+#define THUMBNAIL_H
+
+#include <Arduino.h>
+
+// Screenshot thumbnails
+// ThumbnailBuilder box-filters 24-bit BMP rows (BGR, bottom-up, as written by
+// saveScreenshot) down by THUMBNAIL_SCALE in both directions and emits a
+// smaller 24-bit BMP through a write callback, one output row at a time.
+// Only one row of sums is kept, so it works while the source is streaming.
+//
+// Thumbnails live next to their screenshot as NAME.thumb.bmp. The reserved
+// BMP header field holds a random stamp picked at generation time, which
+// /thumb uses as the ETag, since FAT timestamps are meaningless without an RTC.
+#define THUMBNAIL_SCALE 4
+
+class ThumbnailBuilder {
+public:
+  typedef void (*WriteCallback)(const uint8_t* data, size_t length, void* context);
+  
+  ThumbnailBuilder(WriteCallback write, void* context);
+  ~ThumbnailBuilder();
+  
+  // Writes the header. Returns false if the row buffers can't be allocated.
+  bool begin(int sourceWidth, int sourceHeight);
+  // Feed source rows in file order (bottom row first)
+  void addRow(const uint8_t* bgr);
+  void end();
+  
+  // "" unless imagePath is a .bmp that isn't itself a thumbnail
+  static String pathFor(const String& imagePath);
+  static bool isThumbnail(const char* name);
+  // Reads the stamp from a thumbnail's header; 0 if unreadable
+  static uint32_t readStamp(const String& thumbPath);
+  // Builds the thumbnail for an existing screenshot (caller holds a StorageSession)
+  static bool generate(const String& imagePath);
+  
+private:
+  WriteCallback writeCallback;
+  void* writeContext;
+  int sourceWidth;
+  int thumbWidth;
+  int thumbHeight;
+  int rowsSummed;
+  int rowsWritten;
+  size_t thumbRowBytes;
+  uint16_t* sums;
+  uint8_t* rowOut;
+};
+
+#endif // THUMBNAIL_H
@@ -22,7 +22,7 @@ struct TouchCalibration {
   bool valid;
 };
 
-extern TFT_eSPI tft;
+extern ShadowTFT tft;
 extern XPT2046_Touchscreen ts;
 
 static TouchCalibration calibration;
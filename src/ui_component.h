@@ -69,7 +69,7 @@ protected:
 };
 
 // Global references (defined in main .ino file)
-extern TFT_eSPI tft;
+extern ShadowTFT tft;
 extern TouchState touch;
 
 // Layout grid helper for consistent spacing
@@ -3,6 +3,7 @@
 
 #include "common_definitions.h"
 #include "touch_calibration.h"
+#include "button_cache.h"
 
 // UI function declarations
 void updateTouch();
@@ -159,6 +160,9 @@ inline bool isButtonPressed(int x, int y, int w, int h) {
 }
 
 inline void drawRoundButton(int x, int y, int w, int h, String text, uint16_t color, bool pressed) {
+  // Blit a pre-rendered copy when possible
+  if (ButtonCache::draw(x, y, w, h, text, color, pressed)) return;
+  
   uint16_t bgColor = pressed ? color : THEME_BG;  // Transparent (background color) when not pressed
   uint16_t borderColor = color;
   uint16_t textColor = pressed ? THEME_BG : color;
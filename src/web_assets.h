@@ -0,0 +1,270 @@
+// web_assets.h
+// Generated by scripts/embed_web_assets.py from web/ - do not edit by hand
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+  const uint8_t* data;     // Gzip-compressed, in flash
+  size_t length;
+  const char* etag;        // Quoted, ready for the ETag header
+  const char* contentType;
+};
+
+// index.html: 8087 bytes, 2871 gzipped
+const uint8_t WEB_INDEX_DATA[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x59, 0x4b, 0x8f, 0xdb, 0xc8,
+  0x11, 0xbe, 0xcf, 0xaf, 0xa0, 0x65, 0x04, 0x4d, 0xee, 0x48, 0x94, 0x34, 0x8f, 0xcd, 0x80, 0x14,
+  0x65, 0xac, 0x3d, 0xe3, 0x8d, 0x13, 0xbf, 0xe0, 0x19, 0x63, 0xb1, 0xf0, 0x1a, 0x41, 0x8b, 0x6c,
+  0x4a, 0xed, 0xe1, 0x6b, 0xc9, 0xe6, 0x3c, 0x56, 0xab, 0x43, 0x4e, 0xb9, 0x65, 0x11, 0x04, 0x48,
+  0x8e, 0xc9, 0x25, 0xb7, 0x9c, 0x83, 0x0d, 0x90, 0x5f, 0x93, 0x3f, 0x90, 0xfc, 0x84, 0x54, 0x75,
+  0xf3, 0xd1, 0xd4, 0x63, 0x3c, 0xde, 0x04, 0x06, 0x64, 0xb2, 0x59, 0x5d, 0x5d, 0xf5, 0x55, 0x7d,
+  0xd5, 0xd5, 0x3d, 0x93, 0x07, 0xa7, 0xaf, 0x9e, 0x5c, 0x7c, 0xfd, 0xfa, 0xcc, 0x58, 0x88, 0x38,
+  0x9a, 0x4e, 0xaa, 0x5f, 0x46, 0x83, 0xe9, 0x24, 0x66, 0x82, 0x1a, 0xfe, 0x82, 0xe6, 0x05, 0x13,
+  0x1e, 0x79, 0x7b, 0xf1, 0x74, 0x70, 0x42, 0xaa, 0xd1, 0x84, 0xc6, 0xcc, 0x23, 0x57, 0x9c, 0x5d,
+  0x67, 0x69, 0x2e, 0x88, 0xe1, 0xa7, 0x89, 0x60, 0x09, 0x48, 0x5d, 0xf3, 0x40, 0x2c, 0xbc, 0x80,
+  0x5d, 0x71, 0x9f, 0x0d, 0xe4, 0x4b, 0x9f, 0x27, 0x5c, 0x70, 0x1a, 0x0d, 0x0a, 0x9f, 0x46, 0xcc,
+  0x1b, 0x83, 0x0a, 0xc1, 0x45, 0xc4, 0xa6, 0x4f, 0xbe, 0x3e, 0x35, 0x5e, 0xd0, 0x84, 0xce, 0x59,
+  0x3e, 0x19, 0xaa, 0xa1, 0x49, 0x21, 0x6e, 0xe1, 0xbf, 0xbd, 0xcf, 0x96, 0x31, 0xcd, 0xe7, 0x3c,
+  0x71, 0x46, 0x6e, 0x46, 0x83, 0x80, 0x27, 0x73, 0x78, 0x9a, 0xa5, 0x37, 0x83, 0x82, 0x7f, 0x87,
+  0x2f, 0xb3, 0x34, 0x0f, 0x58, 0x3e, 0x80, 0x91, 0xd5, 0x2c, 0x0d, 0x6e, 0x97, 0x21, 0x2c, 0x3f,
+  0x08, 0x69, 0xcc, 0xa3, 0x5b, 0xe7, 0x8b, 0x1c, 0x16, 0xeb, 0x17, 0x34, 0x29, 0x06, 0x05, 0xcb,
+  0x79, 0xe8, 0xce, 0xa8, 0x7f, 0x39, 0xcf, 0xd3, 0x32, 0x09, 0x9c, 0x87, 0x07, 0x07, 0x07, 0xae,
+  0x9f, 0x46, 0x69, 0xee, 0x3c, 0x0c, 0xc3, 0xb0, 0x51, 0x3e, 0x1e, 0x65, 0x37, 0xab, 0xbd, 0xc5,
+  0x78, 0x29, 0xd8, 0x8d, 0x18, 0xd0, 0x88, 0xcf, 0x13, 0xc7, 0x07, 0x7f, 0x58, 0xee, 0x2a, 0x43,
+  0x60, 0x29, 0x21, 0xd2, 0x58, 0x0a, 0xba, 0x72, 0x35, 0xb0, 0x84, 0x39, 0x63, 0xfb, 0x90, 0xc5,
+  0xab, 0x59, 0x09, 0xdf, 0x92, 0x65, 0xad, 0xec, 0xf3, 0xec, 0xc6, 0x90, 0x72, 0x9d, 0x85, 0x4f,
+  0xa8, 0xab, 0xac, 0x76, 0x92, 0x34, 0x61, 0xd5, 0xf3, 0x20, 0xa7, 0x01, 0x2f, 0x0b, 0xe7, 0x08,
+  0xa4, 0x35, 0xb3, 0xfc, 0x32, 0x2f, 0xe0, 0x39, 0x4b, 0xb9, 0x66, 0x82, 0x73, 0xd0, 0x5d, 0xfa,
+  0x10, 0x4d, 0x56, 0x4b, 0x3b, 0x8b, 0xf4, 0x8a, 0xe5, 0x4b, 0x7d, 0xbd, 0x43, 0x1a, 0xac, 0x78,
+  0x92, 0x95, 0xe2, 0x9d, 0xb8, 0xcd, 0x20, 0x54, 0x21, 0x8f, 0x18, 0x79, 0xdf, 0xd7, 0x87, 0xd0,
+  0xd7, 0xb5, 0xa1, 0x8c, 0x16, 0xc5, 0x35, 0x58, 0x46, 0xde, 0xeb, 0xde, 0xd4, 0x86, 0x8f, 0xc1,
+  0xb1, 0x22, 0x8d, 0x78, 0x60, 0x3c, 0x3c, 0x3e, 0x3e, 0xde, 0xe2, 0x42, 0xc7, 0x80, 0xc3, 0x43,
+  0xdd, 0xa5, 0x9d, 0x3e, 0xb8, 0x32, 0x49, 0x1c, 0xc8, 0x0d, 0xdf, 0x1c, 0x8f, 0x46, 0x3f, 0x33,
+  0x06, 0x06, 0xa8, 0xb2, 0x56, 0x7b, 0xf6, 0x2c, 0x87, 0x2c, 0xf4, 0xf3, 0x32, 0x9e, 0x2d, 0xd7,
+  0x15, 0xd7, 0xc6, 0x9d, 0x34, 0xc6, 0xe9, 0x66, 0x74, 0x43, 0x76, 0xd2, 0x5d, 0x12, 0x04, 0x56,
+  0x9a, 0x6a, 0x83, 0x2e, 0x2b, 0x2b, 0x01, 0xb1, 0x75, 0xe0, 0x65, 0x36, 0x04, 0xcc, 0x4f, 0x73,
+  0x2a, 0x38, 0xc0, 0x8c, 0x91, 0xeb, 0x18, 0x66, 0xd0, 0x0a, 0xfa, 0x75, 0x49, 0xb0, 0x94, 0xe5,
+  0x11, 0x07, 0xf1, 0x32, 0x5a, 0x46, 0xbc, 0x80, 0xd5, 0x31, 0xb3, 0x95, 0x86, 0x88, 0x77, 0xd0,
+  0xad, 0xa0, 0x01, 0x2c, 0x8c, 0xd1, 0x06, 0x84, 0x9b, 0xde, 0x05, 0xbc, 0xc8, 0x22, 0x7a, 0xeb,
+  0x84, 0x11, 0xbb, 0x71, 0x3f, 0x94, 0x85, 0xe0, 0xe1, 0xed, 0xa0, 0xe2, 0x9f, 0x53, 0x64, 0x14,
+  0x78, 0x37, 0x63, 0xe2, 0x9a, 0xb1, 0xc4, 0x95, 0x89, 0x3c, 0xe0, 0x82, 0xc5, 0x45, 0x9d, 0xce,
+  0x38, 0x6b, 0x70, 0x9d, 0xd3, 0xcc, 0xc1, 0x1f, 0x70, 0x06, 0x13, 0x63, 0xc0, 0x93, 0x30, 0x5d,
+  0xe2, 0x27, 0x67, 0xec, 0xc6, 0x00, 0x9d, 0x8a, 0xc9, 0xf8, 0x00, 0x69, 0xa1, 0x24, 0x90, 0xf0,
+  0x8a, 0x66, 0xd7, 0x8c, 0xcf, 0x17, 0x02, 0x28, 0x18, 0x6d, 0xe0, 0xd5, 0x22, 0xa9, 0xcd, 0xfa,
+  0x28, 0x42, 0x4a, 0x14, 0xa3, 0xb3, 0x4c, 0xc1, 0x7c, 0x2e, 0x6e, 0x9d, 0x91, 0xfd, 0x73, 0x2d,
+  0x66, 0x23, 0xfb, 0xe4, 0x98, 0xc5, 0x75, 0x58, 0x23, 0x16, 0x0a, 0x0c, 0x2a, 0xda, 0x0e, 0x36,
+  0x80, 0xea, 0x3a, 0xcd, 0xe8, 0x08, 0x22, 0x2b, 0x12, 0x58, 0x25, 0x62, 0x82, 0x75, 0x92, 0xc6,
+  0x3f, 0x3c, 0xd4, 0xbf, 0x6d, 0x21, 0x0c, 0x3b, 0x3a, 0x5a, 0xd9, 0x85, 0xa0, 0xa2, 0x2c, 0xb6,
+  0x45, 0xe7, 0x73, 0x15, 0x9d, 0x9d, 0xd1, 0x90, 0xa4, 0x5e, 0x67, 0xa7, 0x5d, 0x94, 0xbe, 0xcf,
+  0x8a, 0xa2, 0xb3, 0xd0, 0x01, 0x3d, 0x5e, 0xd9, 0x2c, 0xcf, 0xd3, 0x7c, 0xd3, 0xc2, 0x82, 0xf9,
+  0x08, 0x4e, 0x5d, 0xfd, 0xb0, 0x8a, 0x18, 0xa3, 0x6e, 0xb6, 0x77, 0x34, 0xe1, 0xbf, 0x4d, 0xa3,
+  0x1a, 0x3d, 0xc6, 0xe2, 0x60, 0xa9, 0x17, 0xab, 0x71, 0x8b, 0x62, 0x45, 0x8e, 0xcf, 0xa5, 0x99,
+  0xd7, 0x3c, 0xe4, 0x83, 0x30, 0xcd, 0x63, 0x23, 0xa2, 0x33, 0x16, 0x2d, 0x6b, 0xa7, 0x66, 0x51,
+  0xea, 0x5f, 0xd6, 0x33, 0x44, 0x9a, 0x49, 0x40, 0xd6, 0x9c, 0x54, 0x93, 0x55, 0x02, 0xb5, 0x5f,
+  0x90, 0xe7, 0x6d, 0x30, 0x4f, 0x74, 0x1d, 0x47, 0x72, 0xc9, 0x39, 0x8d, 0x22, 0x96, 0xdf, 0x36,
+  0x4b, 0xcd, 0x73, 0x1e, 0xb8, 0xf8, 0x33, 0x80, 0x6c, 0x85, 0x11, 0xc1, 0x20, 0xa7, 0xa3, 0x32,
+  0x4e, 0x0a, 0x27, 0x67, 0x19, 0xa3, 0xc2, 0xa4, 0xa5, 0x48, 0x07, 0x90, 0x2a, 0x51, 0x1f, 0x32,
+  0x34, 0xa6, 0x37, 0xe6, 0xf8, 0x18, 0xe0, 0xe9, 0x8f, 0xc3, 0xdc, 0xb2, 0xdc, 0x39, 0x24, 0xf4,
+  0x49, 0x4b, 0x7d, 0x5c, 0xe7, 0x44, 0x5f, 0x47, 0x92, 0x60, 0xf9, 0x71, 0x72, 0x61, 0x5a, 0x84,
+  0x51, 0x7a, 0xed, 0x2c, 0x78, 0x10, 0x00, 0x83, 0x36, 0xf7, 0x83, 0xb5, 0x94, 0xaf, 0x4a, 0xe3,
+  0x41, 0x5b, 0x1a, 0x8f, 0x8e, 0x8e, 0x5c, 0x91, 0xc3, 0xf6, 0xc3, 0x65, 0x9e, 0x2b, 0x01, 0x63,
+  0x64, 0x1f, 0x14, 0x6b, 0xe6, 0xd4, 0x49, 0xa8, 0x8c, 0xd0, 0xb9, 0x53, 0x4b, 0x89, 0x05, 0x16,
+  0xbf, 0x6e, 0x34, 0x2a, 0x6a, 0x42, 0xa5, 0x74, 0x17, 0x8a, 0x89, 0x92, 0xa6, 0x9d, 0xc4, 0x18,
+  0x8f, 0xc7, 0x6e, 0x3a, 0xfb, 0x00, 0x49, 0x00, 0x80, 0x09, 0x07, 0x8b, 0x03, 0xe5, 0x89, 0xcb,
+  0x63, 0xd8, 0x6b, 0x07, 0x39, 0x43, 0xe6, 0x61, 0x3e, 0x65, 0xfc, 0x86, 0x21, 0xd2, 0x81, 0x66,
+  0x98, 0xe4, 0xb9, 0x9e, 0xff, 0x6b, 0x41, 0xc5, 0xdd, 0x61, 0x80, 0x05, 0xf0, 0xd2, 0x91, 0xbf,
+  0x03, 0x1c, 0xd8, 0x0e, 0x5b, 0x33, 0xc8, 0xa2, 0x88, 0x67, 0x05, 0xd7, 0xfd, 0x47, 0x93, 0xf2,
+  0x34, 0x2a, 0x96, 0x9d, 0x6a, 0x86, 0x51, 0xc4, 0x28, 0xd4, 0xeb, 0xe3, 0xf3, 0x7a, 0x85, 0x53,
+  0x61, 0xd8, 0xa2, 0xca, 0x58, 0xdb, 0x86, 0x61, 0xb2, 0xb1, 0xe6, 0xc0, 0x18, 0x53, 0x62, 0x32,
+  0x54, 0x4d, 0xc6, 0x64, 0xa8, 0xba, 0x1c, 0x6c, 0x20, 0xa6, 0x7b, 0x93, 0xc5, 0x78, 0xfa, 0x9f,
+  0x3f, 0xff, 0xee, 0x1f, 0x46, 0xa7, 0x2b, 0x81, 0xc1, 0xbd, 0x49, 0xc0, 0xaf, 0x0c, 0x3f, 0x82,
+  0x9d, 0xd1, 0x23, 0x15, 0xaf, 0x08, 0xca, 0x1f, 0x80, 0xfc, 0x1f, 0x7e, 0x34, 0xce, 0xfd, 0x1c,
+  0x4a, 0x6d, 0xb1, 0x48, 0x45, 0x61, 0x7c, 0xa9, 0x4c, 0x82, 0x79, 0x07, 0x20, 0xa1, 0xec, 0x31,
+  0xd2, 0xc4, 0x8f, 0xb8, 0x7f, 0xe9, 0x91, 0x28, 0xa5, 0x81, 0x26, 0x6d, 0x5a, 0x64, 0xfa, 0x86,
+  0x85, 0x39, 0x2b, 0x16, 0xed, 0x44, 0x35, 0x67, 0xcb, 0xe4, 0x20, 0xbd, 0x4e, 0x50, 0xc1, 0x17,
+  0x51, 0xb4, 0xa6, 0xe3, 0x5f, 0x7f, 0xfb, 0xed, 0xbf, 0x7f, 0xfc, 0xc1, 0x38, 0xad, 0x04, 0x0c,
+  0x90, 0xd0, 0xf4, 0x68, 0xc6, 0x57, 0x80, 0x11, 0x83, 0x07, 0xed, 0xcb, 0x54, 0x4a, 0x48, 0x44,
+  0x60, 0x10, 0xf9, 0xa7, 0x68, 0xe7, 0x8c, 0x87, 0x83, 0xf1, 0x96, 0xf4, 0xaf, 0xd1, 0xc5, 0x9c,
+  0x23, 0xd3, 0xe7, 0xb0, 0x20, 0xbc, 0xd9, 0xb6, 0x3d, 0x19, 0x82, 0x9e, 0xa9, 0xfa, 0xdd, 0xab,
+  0xff, 0xbb, 0x0b, 0xb9, 0xdf, 0x18, 0x4f, 0xa1, 0xec, 0x17, 0x15, 0x56, 0x9a, 0x64, 0xbb, 0xbb,
+  0x2a, 0x4b, 0xb5, 0xf7, 0xe9, 0xb0, 0xd6, 0x2c, 0x8b, 0x15, 0x7e, 0x2d, 0x33, 0x62, 0xb0, 0xc4,
+  0x57, 0xed, 0x4b, 0x5c, 0x46, 0x82, 0x67, 0x34, 0x17, 0x43, 0xfc, 0x3e, 0x08, 0xa8, 0xa0, 0xb8,
+  0xa0, 0xec, 0x70, 0x0c, 0xad, 0x0f, 0xaa, 0xda, 0x57, 0xf5, 0x8c, 0x5a, 0x42, 0x4e, 0x8c, 0x9c,
+  0x7d, 0x5b, 0xf2, 0x9c, 0x05, 0x2d, 0xf8, 0x6a, 0x46, 0x51, 0xce, 0x62, 0x2e, 0xc8, 0xf4, 0x6d,
+  0x86, 0xf0, 0x6e, 0x86, 0x48, 0x49, 0xa9, 0x17, 0xd2, 0x06, 0x4c, 0xd0, 0x4b, 0xd6, 0x46, 0x0a,
+  0x03, 0xb5, 0x96, 0x2e, 0x8d, 0xa6, 0xbb, 0x15, 0xf5, 0xae, 0x79, 0x02, 0xc1, 0xb7, 0xd3, 0x8c,
+  0x25, 0x26, 0x19, 0xc6, 0x1c, 0x77, 0x0e, 0x62, 0xf5, 0x40, 0xdd, 0x1f, 0xff, 0x8a, 0x81, 0x7f,
+  0xce, 0xaf, 0x98, 0x66, 0x95, 0x74, 0x7d, 0x0d, 0x7b, 0xb9, 0xab, 0x29, 0x4f, 0x0b, 0xf0, 0xa4,
+  0x06, 0xb1, 0x8c, 0x94, 0xf3, 0x11, 0x0c, 0x45, 0xbc, 0x13, 0x4c, 0x78, 0x9d, 0x0c, 0xcb, 0x68,
+  0x47, 0x16, 0xcb, 0xc8, 0x69, 0xf9, 0xab, 0x2f, 0xff, 0xf1, 0xc8, 0xff, 0xdd, 0xf8, 0x8a, 0x3f,
+  0xe5, 0xc6, 0x93, 0x34, 0x09, 0xf9, 0xbc, 0x8a, 0xbf, 0x8c, 0x67, 0x35, 0xa1, 0xd9, 0x8d, 0x94,
+  0xc5, 0xf8, 0xfa, 0x14, 0xdf, 0x40, 0x4c, 0x6e, 0x4f, 0xd3, 0xf3, 0xf3, 0x67, 0xa7, 0x4e, 0x27,
+  0xaa, 0xb2, 0x95, 0x55, 0xfe, 0x15, 0x3c, 0x20, 0x06, 0x94, 0x14, 0x9f, 0x2d, 0x64, 0x77, 0xe0,
+  0x11, 0xb9, 0xda, 0x4b, 0x68, 0x89, 0xd2, 0xfc, 0xd2, 0x78, 0x09, 0x91, 0x47, 0x04, 0x94, 0xa6,
+  0x5a, 0xe3, 0xeb, 0xaa, 0xef, 0xed, 0x6a, 0x6d, 0xba, 0x61, 0xa9, 0x19, 0xdf, 0xb6, 0x69, 0xae,
+  0xe7, 0xea, 0x5a, 0xb7, 0x26, 0xd0, 0x39, 0xbd, 0x62, 0x5d, 0xd7, 0xef, 0x0a, 0x5a, 0xb3, 0xad,
+  0xb6, 0x28, 0x3c, 0xc3, 0xb7, 0xe9, 0x93, 0x32, 0xcf, 0xb1, 0x10, 0x1a, 0x5f, 0xbc, 0x36, 0x5e,
+  0xa4, 0x01, 0x5b, 0xe3, 0x5c, 0xe1, 0xe7, 0x3c, 0x13, 0xd3, 0x3d, 0x68, 0x73, 0x0c, 0xd8, 0xab,
+  0x5e, 0x53, 0x38, 0x8e, 0x91, 0x21, 0x71, 0xf7, 0xc2, 0x32, 0x51, 0x4d, 0x41, 0x18, 0x0b, 0x73,
+  0x66, 0x2d, 0x79, 0x68, 0xce, 0x3c, 0xcf, 0x1b, 0x59, 0x39, 0x13, 0x65, 0x9e, 0x18, 0x64, 0xf4,
+  0x98, 0x40, 0x07, 0x97, 0x14, 0xc2, 0xb8, 0xf4, 0xc6, 0xa3, 0x83, 0xa3, 0x7e, 0xe1, 0xbd, 0x23,
+  0x8f, 0x49, 0x9f, 0xfc, 0x0a, 0x7f, 0x5e, 0xe0, 0xcf, 0x97, 0x8f, 0xf1, 0xc0, 0xe0, 0xbd, 0x00,
+  0xa5, 0x36, 0x94, 0xf6, 0x34, 0x37, 0xe5, 0x63, 0x94, 0xce, 0x41, 0xe3, 0xb0, 0x79, 0xbe, 0x84,
+  0x1d, 0xb9, 0xd2, 0x2a, 0xc7, 0xe4, 0xb6, 0x64, 0xce, 0x94, 0x40, 0x96, 0x5e, 0x9b, 0x97, 0x7d,
+  0x6e, 0x7d, 0x06, 0x7b, 0x98, 0x35, 0x84, 0x9f, 0x7d, 0x62, 0x90, 0xfd, 0xe2, 0x1d, 0x7f, 0xbf,
+  0x6a, 0x6d, 0x2c, 0x33, 0x20, 0x2f, 0x7b, 0xdc, 0x50, 0xdf, 0xb4, 0x96, 0xca, 0x34, 0x64, 0x77,
+  0xe1, 0x55, 0x8e, 0xd9, 0xb0, 0x77, 0x70, 0x01, 0xac, 0x20, 0x16, 0x36, 0x91, 0x50, 0x9f, 0xcc,
+  0xcc, 0x9b, 0x66, 0x96, 0x8b, 0xce, 0xe3, 0x49, 0xd6, 0x23, 0x13, 0xda, 0x32, 0x29, 0xa1, 0x57,
+  0x17, 0xa9, 0xf9, 0x0d, 0x19, 0x7e, 0xa3, 0xf8, 0xf3, 0xc3, 0x5f, 0x26, 0x43, 0x3a, 0x25, 0x52,
+  0x3a, 0x93, 0x38, 0x11, 0x57, 0xea, 0x87, 0xc6, 0x32, 0x3f, 0xa3, 0xfe, 0x02, 0xb5, 0x2d, 0xf1,
+  0xcb, 0x3e, 0x42, 0xb8, 0x9f, 0xb9, 0xa8, 0x13, 0x9e, 0x8d, 0xa1, 0xb1, 0x4d, 0x2f, 0x48, 0xa0,
+  0x2c, 0x91, 0xea, 0xe1, 0x65, 0x9f, 0x48, 0xfd, 0x2b, 0xcb, 0x0d, 0x52, 0xbf, 0x8c, 0x21, 0x68,
+  0xf6, 0x9c, 0x89, 0xb3, 0x88, 0xe1, 0xe3, 0xe3, 0xdb, 0x67, 0x81, 0xa9, 0x17, 0x37, 0xcb, 0xe6,
+  0x49, 0xc2, 0xf2, 0x5f, 0x5c, 0xbc, 0x78, 0xee, 0xe1, 0x3a, 0x1a, 0x1a, 0x6a, 0x81, 0x0c, 0x30,
+  0xa8, 0x02, 0x9a, 0xb9, 0x1a, 0x0d, 0x35, 0x41, 0x6d, 0x74, 0x19, 0x32, 0x01, 0x1e, 0x90, 0x21,
+  0x9e, 0x3e, 0x1e, 0x29, 0xf7, 0xf6, 0xa1, 0x52, 0x42, 0xc6, 0xbc, 0x7d, 0xf3, 0xec, 0x49, 0x1a,
+  0x67, 0xd0, 0xb1, 0x26, 0xc2, 0xac, 0x54, 0x5a, 0x96, 0x2d, 0x16, 0x50, 0x61, 0x72, 0x6f, 0x9a,
+  0xdb, 0x1f, 0x8a, 0x34, 0x31, 0xeb, 0x91, 0x10, 0x30, 0x50, 0xd8, 0x47, 0xde, 0x4e, 0x3f, 0xa0,
+  0x86, 0x58, 0x2e, 0x64, 0x54, 0x68, 0x47, 0x2c, 0x99, 0xc3, 0x5a, 0x98, 0x58, 0xcb, 0x48, 0x73,
+  0x89, 0x60, 0x89, 0x79, 0x99, 0x1a, 0xf2, 0x34, 0x22, 0x0b, 0x0c, 0x71, 0x37, 0xa3, 0x5c, 0xa5,
+  0xcd, 0x6a, 0x4f, 0x9f, 0x1a, 0xda, 0x31, 0xcd, 0x4c, 0x9c, 0x08, 0xa6, 0xc0, 0x22, 0xf8, 0x64,
+  0xf3, 0xe2, 0x94, 0xe7, 0x4d, 0xee, 0xa2, 0x72, 0x8d, 0x3d, 0xbd, 0xe6, 0x54, 0xd3, 0x9b, 0x4e,
+  0xe0, 0x4c, 0x94, 0x74, 0xc6, 0xb1, 0xfa, 0x1b, 0xea, 0xec, 0xd0, 0xdb, 0x16, 0x45, 0xa9, 0x5f,
+  0x0b, 0xa5, 0xdc, 0xad, 0xaa, 0x61, 0x9c, 0x8b, 0x71, 0x45, 0xa5, 0xd3, 0x7a, 0xd3, 0x93, 0xce,
+  0xec, 0xfd, 0x64, 0x5b, 0x30, 0x59, 0xb6, 0x28, 0xdf, 0x90, 0xc5, 0x26, 0x06, 0x65, 0x91, 0xc0,
+  0x52, 0x1e, 0x07, 0xac, 0x75, 0x6b, 0xe4, 0xcf, 0x5a, 0xd5, 0xee, 0x41, 0xeb, 0x28, 0x8f, 0x5d,
+  0xf6, 0x22, 0x67, 0xa1, 0x07, 0x14, 0xa8, 0xfb, 0x89, 0x47, 0xa8, 0x79, 0x7b, 0x66, 0x34, 0x30,
+  0x58, 0x88, 0x43, 0xaf, 0x6a, 0x34, 0x36, 0xb6, 0xad, 0xca, 0xc2, 0xf6, 0x70, 0xa5, 0x61, 0x0a,
+  0x03, 0x3b, 0x10, 0xfd, 0xd3, 0xef, 0x3b, 0xba, 0x34, 0x20, 0x57, 0x96, 0xfd, 0x01, 0x9a, 0x6b,
+  0x93, 0x40, 0x46, 0x6d, 0x26, 0x08, 0x7c, 0x05, 0x4f, 0x20, 0xb1, 0x99, 0x37, 0xc5, 0xac, 0x4c,
+  0x23, 0xa6, 0x0e, 0x53, 0x26, 0xb3, 0x74, 0x26, 0xe0, 0xca, 0x89, 0x2c, 0x72, 0x0f, 0x7c, 0xac,
+  0xb6, 0x79, 0x6c, 0x92, 0x53, 0x69, 0x1e, 0x44, 0x32, 0xd9, 0x27, 0x8f, 0x88, 0x55, 0x25, 0x8f,
+  0x5b, 0x13, 0x45, 0x59, 0x7f, 0x07, 0x20, 0x89, 0xd5, 0x5f, 0xc6, 0x4c, 0x2c, 0xd2, 0xc0, 0x21,
+  0xa7, 0x67, 0xcf, 0xcf, 0x2e, 0xce, 0xd0, 0xd8, 0x9a, 0x36, 0x4b, 0xd8, 0xd4, 0xaf, 0xcf, 0x85,
+  0x99, 0xdb, 0xe9, 0xe5, 0xa3, 0x6a, 0xad, 0x80, 0x38, 0xe4, 0x29, 0x05, 0x85, 0x01, 0xe9, 0xab,
+  0xf1, 0xea, 0x44, 0x08, 0xe3, 0x4c, 0x6d, 0xe4, 0xc8, 0x1a, 0xfc, 0x64, 0xe9, 0x8c, 0xd6, 0x9c,
+  0xac, 0xb4, 0x92, 0x33, 0x29, 0xde, 0xaf, 0xa7, 0xad, 0xb3, 0xbe, 0xd3, 0x14, 0x36, 0xdc, 0x2f,
+  0xda, 0x51, 0xb2, 0x93, 0xe0, 0x9a, 0x50, 0x43, 0xf5, 0xf9, 0x6e, 0xaa, 0xd7, 0x9d, 0xa3, 0xb4,
+  0xfc, 0x81, 0x36, 0xf9, 0xfb, 0xef, 0xb5, 0x97, 0x4e, 0x1d, 0x98, 0x77, 0xea, 0x40, 0xdb, 0x70,
+  0xf6, 0x3e, 0xb1, 0xe1, 0xec, 0x61, 0x01, 0xd1, 0x16, 0x01, 0x12, 0xc3, 0xc6, 0xa2, 0x92, 0x87,
+  0x34, 0xa5, 0x43, 0x5f, 0x4d, 0xb7, 0x08, 0x8b, 0x08, 0x78, 0x48, 0x74, 0x6e, 0xea, 0xe7, 0x31,
+  0xa0, 0x27, 0x8f, 0xe7, 0xeb, 0x5f, 0xe4, 0x19, 0xac, 0x27, 0x31, 0x06, 0x33, 0x80, 0x49, 0xf4,
+  0xbb, 0xdb, 0x9e, 0x41, 0x23, 0xe1, 0xf5, 0xa0, 0x03, 0xfb, 0x27, 0x64, 0x71, 0xcf, 0x28, 0x72,
+  0xdf, 0xeb, 0x0d, 0xa5, 0xe4, 0x1d, 0xe9, 0x53, 0xd4, 0x64, 0xea, 0x4d, 0xb7, 0x99, 0x50, 0x57,
+  0x82, 0xa2, 0x29, 0x03, 0x35, 0x9d, 0xd7, 0x25, 0xeb, 0x13, 0x4f, 0xef, 0x1e, 0x3c, 0x6f, 0x01,
+  0xb8, 0x8f, 0x65, 0x40, 0xf3, 0x3a, 0x34, 0xea, 0x36, 0x68, 0x27, 0xeb, 0x75, 0x8a, 0x6b, 0x6d,
+  0x2e, 0x92, 0xbd, 0xb8, 0x0f, 0xd3, 0x65, 0xc8, 0x5a, 0xa6, 0xeb, 0x19, 0xbf, 0xfc, 0x78, 0xea,
+  0xfd, 0xdf, 0xf2, 0x49, 0xb2, 0xaa, 0x0e, 0xae, 0x9e, 0x5a, 0x75, 0x52, 0xad, 0xd7, 0x98, 0xd5,
+  0x5a, 0x91, 0xd1, 0x7c, 0x97, 0x18, 0x6e, 0xad, 0x38, 0x5a, 0x10, 0x36, 0xcb, 0xce, 0xbd, 0x22,
+  0x24, 0x75, 0xdf, 0x59, 0x7d, 0xea, 0x32, 0xb2, 0xdc, 0xa8, 0x06, 0xab, 0x7b, 0xd7, 0xcc, 0x1d,
+  0x67, 0xcc, 0xba, 0xb2, 0x91, 0xd7, 0x39, 0x83, 0xfe, 0x08, 0x91, 0xaa, 0x45, 0xe1, 0xb0, 0x00,
+  0x35, 0xa9, 0x2e, 0x6a, 0x96, 0xfb, 0x3f, 0x14, 0x9e, 0x7b, 0x57, 0x93, 0xda, 0x9a, 0x6e, 0x2d,
+  0x68, 0x4b, 0x63, 0x53, 0x08, 0x74, 0x05, 0x75, 0x47, 0x67, 0x16, 0xd0, 0x7a, 0x62, 0xb1, 0x66,
+  0xe2, 0x82, 0xc7, 0x2c, 0x2d, 0x85, 0x69, 0x5a, 0x4d, 0xd9, 0xa3, 0x6d, 0xd9, 0x83, 0xb9, 0xb0,
+  0xf5, 0x54, 0xe9, 0x67, 0x12, 0x0a, 0x7a, 0xa9, 0x62, 0xd5, 0xa7, 0x91, 0x0a, 0x66, 0xd5, 0x60,
+  0x79, 0x8a, 0xda, 0x30, 0x22, 0xb9, 0x03, 0x91, 0xe9, 0xf3, 0xcf, 0x8e, 0xa1, 0x0b, 0x5e, 0x7d,
+  0x6a, 0xc5, 0x5f, 0x3f, 0x5c, 0x36, 0x98, 0x5c, 0xd0, 0xcb, 0x6e, 0x22, 0x7f, 0x3c, 0x40, 0x9d,
+  0xf8, 0xcc, 0xa2, 0x74, 0xd6, 0xc4, 0x67, 0xd6, 0xe0, 0x52, 0xe6, 0x91, 0xf7, 0xf6, 0xcd, 0xf3,
+  0x0a, 0x94, 0x57, 0xf2, 0x6a, 0x09, 0xde, 0xa1, 0xe9, 0x77, 0x3f, 0x01, 0x38, 0xd0, 0xa2, 0xa3,
+  0x41, 0xfc, 0xdb, 0xe0, 0xd7, 0xca, 0x0e, 0x7b, 0x16, 0x67, 0xa4, 0xc5, 0xc5, 0xad, 0xdd, 0x69,
+  0x7d, 0x34, 0x0a, 0x38, 0x3d, 0x05, 0x0f, 0x3a, 0xbe, 0x68, 0x31, 0x5c, 0x4b, 0xfa, 0xbe, 0x42,
+  0x75, 0x13, 0x53, 0x4d, 0x61, 0x58, 0xed, 0xcb, 0x1a, 0xbe, 0x3b, 0x0b, 0x4f, 0x99, 0x01, 0x4a,
+  0x50, 0x38, 0xce, 0xae, 0x60, 0xe8, 0x39, 0x34, 0xd4, 0x0c, 0xca, 0x8f, 0x59, 0x9f, 0xec, 0xfa,
+  0x58, 0xb4, 0x98, 0x9d, 0xe5, 0x0c, 0x3f, 0x9f, 0xb2, 0x90, 0x96, 0x11, 0x04, 0xa5, 0x82, 0x26,
+  0x0c, 0xbc, 0x84, 0x5d, 0x1b, 0x78, 0x84, 0x3d, 0xa5, 0x82, 0x9a, 0x56, 0x3f, 0xe4, 0x77, 0x34,
+  0xd2, 0x1c, 0x83, 0x14, 0xd8, 0x34, 0x83, 0xf3, 0xbe, 0x7c, 0x8f, 0x18, 0x81, 0x19, 0xf2, 0x92,
+  0xbc, 0x78, 0x37, 0x7a, 0xdf, 0xf9, 0x8a, 0x19, 0x46, 0xfa, 0x75, 0x0b, 0xdf, 0x04, 0xb7, 0x94,
+  0x57, 0x15, 0xa4, 0xad, 0x17, 0xaf, 0x5f, 0x9d, 0x5f, 0x90, 0x3e, 0xde, 0x74, 0x39, 0x61, 0xb0,
+  0xb3, 0x67, 0x51, 0x37, 0x1c, 0x88, 0xf2, 0xfd, 0xbb, 0x96, 0x25, 0x98, 0x76, 0x45, 0xa3, 0x92,
+  0xe1, 0xe1, 0x49, 0x6f, 0x61, 0xee, 0x95, 0xd1, 0x96, 0xbb, 0x1b, 0xf3, 0xe6, 0xdc, 0xff, 0x93,
+  0x91, 0xc7, 0xbb, 0x80, 0xdd, 0x48, 0xcb, 0x9b, 0x02, 0x4b, 0x19, 0xdf, 0xc7, 0xc3, 0xfd, 0x6e,
+  0x51, 0x79, 0xf4, 0xaf, 0x44, 0x1b, 0x90, 0xd1, 0xbe, 0x0d, 0x88, 0xf1, 0x4a, 0x91, 0xe5, 0x85,
+  0xb3, 0x24, 0x4f, 0xd4, 0x7d, 0xe5, 0xe0, 0xe2, 0x36, 0x63, 0x80, 0x1b, 0x44, 0x0c, 0x72, 0x5b,
+  0xee, 0xcd, 0x43, 0x2c, 0x82, 0x64, 0xa5, 0xc2, 0xf1, 0xcb, 0xf3, 0x57, 0x2f, 0xed, 0x42, 0x60,
+  0x51, 0xe5, 0xe1, 0xad, 0xb9, 0x44, 0xab, 0x1c, 0xfc, 0xe9, 0xd7, 0xb7, 0x0f, 0x0e, 0x3e, 0xc8,
+  0x0a, 0xd1, 0xd2, 0x14, 0xb7, 0xb5, 0x86, 0xa6, 0xa2, 0x8d, 0xa3, 0xd0, 0xe9, 0x81, 0xd1, 0xf8,
+  0xaa, 0xba, 0x36, 0xd8, 0xde, 0x53, 0xca, 0xcb, 0x08, 0xb9, 0x59, 0xcd, 0xb7, 0xd0, 0xc1, 0x72,
+  0xbb, 0x2d, 0x66, 0xab, 0x6b, 0xd9, 0xc1, 0xe0, 0x2e, 0xc3, 0xee, 0x8c, 0xae, 0xbc, 0xcf, 0xe8,
+  0xec, 0xe5, 0xcd, 0xdd, 0x06, 0xd9, 0x17, 0x7a, 0x47, 0xd0, 0xd9, 0x75, 0x2b, 0xeb, 0xe3, 0xbe,
+  0xa8, 0x2f, 0x05, 0xee, 0x08, 0x5d, 0x21, 0xb0, 0x50, 0x48, 0xbb, 0xaa, 0x88, 0x78, 0x31, 0xbc,
+  0xcb, 0x8e, 0xea, 0xa5, 0xbc, 0x05, 0x54, 0xb7, 0x63, 0xb8, 0x22, 0x8c, 0xcb, 0x3e, 0xc2, 0xae,
+  0x2e, 0xa5, 0x3d, 0x22, 0xaf, 0xdc, 0x89, 0xbb, 0xb6, 0x59, 0x6c, 0x88, 0xe1, 0x1f, 0x7f, 0x48,
+  0xff, 0x70, 0x84, 0x45, 0x67, 0x4f, 0x23, 0xc1, 0x5a, 0x08, 0xdc, 0x8d, 0xad, 0x19, 0x2f, 0xa3,
+  0xd5, 0x7d, 0x0d, 0x34, 0x48, 0x78, 0x0f, 0x3d, 0x19, 0xca, 0x3f, 0xc0, 0xef, 0xfd, 0x17, 0xec,
+  0x69, 0xdf, 0x25, 0x97, 0x1f, 0x00, 0x00,
+};
+const WebAsset WEB_INDEX = {WEB_INDEX_DATA, sizeof(WEB_INDEX_DATA), "\"9c4422413b367ee5\"", "text/html"};
+
+// mirror.html: 1672 bytes, 1013 gzipped
+const uint8_t WEB_MIRROR_DATA[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x55, 0x6b, 0x6f, 0xdb, 0x36,
+  0x14, 0xfd, 0xee, 0x5f, 0xa1, 0x21, 0x58, 0x25, 0x45, 0x6f, 0x3b, 0x09, 0x32, 0x51, 0x14, 0xb0,
+  0x24, 0x6d, 0x93, 0xad, 0x5d, 0x87, 0xd6, 0x5d, 0x50, 0x0c, 0xf9, 0x40, 0x4b, 0xb4, 0x4d, 0x44,
+  0x22, 0x05, 0x92, 0xb6, 0xa4, 0x79, 0xfe, 0xef, 0xbb, 0x94, 0xe4, 0xa5, 0x2d, 0x36, 0x04, 0x88,
+  0x78, 0x1f, 0xe4, 0x39, 0x3c, 0xf7, 0x5e, 0x3a, 0xfb, 0xe1, 0xee, 0xc3, 0xed, 0xf2, 0xcb, 0xef,
+  0xaf, 0xad, 0xad, 0xae, 0xab, 0x3c, 0x9b, 0xfe, 0x53, 0x52, 0xe6, 0x59, 0x4d, 0x35, 0xb1, 0x8a,
+  0x2d, 0x91, 0x8a, 0x6a, 0x6c, 0x7f, 0x5e, 0xbe, 0x09, 0xae, 0xed, 0xc9, 0xcb, 0x49, 0x4d, 0xb1,
+  0xbd, 0x67, 0xb4, 0x6d, 0x84, 0xd4, 0xb6, 0x55, 0x08, 0xae, 0x29, 0x87, 0xac, 0x96, 0x95, 0x7a,
+  0x8b, 0x4b, 0xba, 0x67, 0x05, 0x0d, 0x06, 0xc3, 0x67, 0x9c, 0x69, 0x46, 0xaa, 0x40, 0x15, 0xa4,
+  0xa2, 0x38, 0x81, 0x23, 0x34, 0xd3, 0x15, 0xcd, 0x6f, 0xbf, 0xdc, 0x59, 0xef, 0x99, 0x94, 0x42,
+  0x66, 0xd1, 0xe8, 0xc9, 0x94, 0xee, 0xe1, 0x33, 0x5b, 0x89, 0xb2, 0x3f, 0xd4, 0x44, 0x6e, 0x18,
+  0x4f, 0x63, 0xb4, 0x22, 0xc5, 0xf3, 0x46, 0x8a, 0x1d, 0x2f, 0xd3, 0xb3, 0x24, 0x49, 0x50, 0x21,
+  0x2a, 0x21, 0xd3, 0x33, 0x42, 0x08, 0x5a, 0x03, 0x6c, 0xb0, 0x26, 0x35, 0xab, 0xfa, 0xf4, 0x67,
+  0x09, 0x20, 0xbe, 0x22, 0x5c, 0x05, 0x8a, 0x4a, 0xb6, 0x46, 0x9a, 0x76, 0x3a, 0x20, 0x15, 0xdb,
+  0xf0, 0xb4, 0x00, 0x6e, 0x54, 0x1e, 0x0b, 0xc2, 0xf7, 0x44, 0x1d, 0x58, 0x4d, 0x36, 0x34, 0x90,
+  0x94, 0x97, 0x90, 0xc7, 0x37, 0x69, 0xc3, 0x3a, 0x5a, 0x11, 0x4d, 0x4b, 0x34, 0x10, 0x4e, 0x7f,
+  0xba, 0xda, 0xb7, 0xa8, 0x26, 0x5d, 0x70, 0x32, 0xe3, 0xa6, 0x43, 0x23, 0x9d, 0x40, 0x8b, 0x26,
+  0xbd, 0x06, 0x73, 0x25, 0x24, 0xec, 0x4e, 0x93, 0xa6, 0xb3, 0x94, 0xa8, 0x58, 0x69, 0x9d, 0x2d,
+  0x16, 0x8b, 0xe3, 0x99, 0xd2, 0x87, 0x81, 0x93, 0x62, 0x7f, 0xd1, 0x34, 0x59, 0x40, 0x62, 0x43,
+  0xca, 0xd2, 0x80, 0x5c, 0x35, 0xdd, 0x71, 0x96, 0x45, 0xe3, 0x0d, 0xb3, 0x68, 0x54, 0xd8, 0x5c,
+  0x34, 0xcf, 0x46, 0x5a, 0x16, 0x2b, 0xb1, 0x5d, 0xd8, 0xd6, 0xa8, 0xa0, 0x7d, 0x71, 0x1d, 0xdb,
+  0xd6, 0x96, 0xb2, 0xcd, 0x16, 0x54, 0x5d, 0xcc, 0x63, 0x90, 0x2d, 0x1a, 0x13, 0xf3, 0xac, 0x64,
+  0xfb, 0x21, 0x5b, 0x69, 0x3b, 0xbf, 0x15, 0x9c, 0xd3, 0x42, 0x03, 0x44, 0x18, 0x86, 0x59, 0x04,
+  0x21, 0x90, 0xb1, 0x90, 0xac, 0xd1, 0xf9, 0x0c, 0xaa, 0xa2, 0xb4, 0x55, 0xec, 0x71, 0x29, 0x8a,
+  0x5d, 0x0d, 0x1a, 0x84, 0x1b, 0xaa, 0x5f, 0x57, 0xd4, 0x2c, 0x6f, 0xfa, 0x87, 0xd2, 0x01, 0x3c,
+  0xd7, 0x2f, 0x74, 0x87, 0x8b, 0xbd, 0x09, 0xdd, 0x9a, 0x2a, 0x76, 0xda, 0xb1, 0xe7, 0x25, 0xf8,
+  0x95, 0xfe, 0xff, 0x7d, 0x80, 0xec, 0xa2, 0x8a, 0x6a, 0xeb, 0x11, 0x03, 0x51, 0xff, 0x1e, 0x03,
+  0x43, 0x7f, 0x89, 0x93, 0x2b, 0x9f, 0xd5, 0x1b, 0x7f, 0x2d, 0xa1, 0x3d, 0x14, 0x8e, 0xfd, 0x55,
+  0xaf, 0xcd, 0x17, 0xcd, 0xd6, 0x3b, 0x0e, 0x1c, 0x05, 0x37, 0x8d, 0x62, 0xe8, 0x3a, 0xee, 0x61,
+  0x24, 0xd7, 0x2a, 0xcc, 0x69, 0x6b, 0x3d, 0xd2, 0xd5, 0x27, 0x51, 0x3c, 0x53, 0xc0, 0x6e, 0x55,
+  0x1a, 0x45, 0xb6, 0x57, 0x89, 0x82, 0x98, 0x1d, 0xe1, 0x56, 0x28, 0x6d, 0xda, 0xcd, 0xb3, 0xd3,
+  0xeb, 0x24, 0x02, 0xd8, 0x56, 0x85, 0x2b, 0xc6, 0x89, 0xec, 0x97, 0x7d, 0x03, 0x4d, 0x48, 0xa4,
+  0x24, 0xfd, 0x6a, 0xb7, 0x5e, 0x53, 0x69, 0xa3, 0x19, 0x04, 0x05, 0x07, 0x70, 0x05, 0x25, 0xc6,
+  0x14, 0xe7, 0x07, 0xb6, 0x76, 0x34, 0xe4, 0x89, 0xb5, 0x45, 0xc3, 0x92, 0x68, 0x82, 0xb1, 0xd1,
+  0xcd, 0xd4, 0xdd, 0x3e, 0x71, 0xd8, 0xe2, 0x5f, 0x3e, 0x7d, 0xf8, 0x2d, 0x6c, 0x4c, 0xa3, 0x3b,
+  0x63, 0x96, 0x8b, 0x1e, 0xf1, 0x36, 0x1c, 0x4a, 0x81, 0xee, 0x61, 0x35, 0x16, 0x02, 0x2d, 0x61,
+  0xa9, 0x59, 0x45, 0x11, 0xe8, 0x35, 0xd6, 0xe9, 0xd1, 0x2c, 0xa7, 0x32, 0xdd, 0x23, 0xb8, 0x3c,
+  0x06, 0x39, 0xc3, 0x42, 0x52, 0xe8, 0xa7, 0x07, 0xd3, 0x67, 0x77, 0x70, 0x9a, 0xb3, 0xf4, 0x97,
+  0x2e, 0x92, 0x54, 0xef, 0x24, 0x3f, 0x4e, 0x55, 0x29, 0x87, 0x7b, 0x9b, 0xe8, 0x1f, 0x30, 0x45,
+  0x27, 0x58, 0xbf, 0xe9, 0x30, 0x1c, 0x32, 0x18, 0x83, 0xbe, 0x02, 0xd4, 0x1b, 0x54, 0xf4, 0xf0,
+  0x98, 0x12, 0x1a, 0xeb, 0x1d, 0xe5, 0x1b, 0x60, 0x36, 0xea, 0xec, 0x79, 0x70, 0xed, 0x2d, 0xb0,
+  0x72, 0x44, 0x56, 0x7e, 0x15, 0x3e, 0x5d, 0x0f, 0xca, 0x5b, 0x9a, 0x02, 0x7e, 0x66, 0x5c, 0x5f,
+  0x3b, 0xc2, 0xf5, 0x75, 0xff, 0x8d, 0xc3, 0x4b, 0x5c, 0x5f, 0xee, 0xb8, 0x7a, 0x71, 0x26, 0x57,
+  0xe0, 0x9d, 0xfb, 0x5a, 0xee, 0xa8, 0x8b, 0x84, 0x87, 0x2f, 0xd0, 0x74, 0x52, 0x8b, 0xdf, 0x13,
+  0xbd, 0x0d, 0x6b, 0xc6, 0xe1, 0x4a, 0x8f, 0x81, 0xee, 0xce, 0x97, 0x70, 0xdc, 0xf6, 0x6b, 0xef,
+  0x7d, 0xa0, 0x7b, 0xf0, 0x0e, 0xe4, 0x9b, 0xa1, 0xf4, 0x42, 0x3a, 0xc6, 0x90, 0x60, 0xc8, 0xcc,
+  0x00, 0x21, 0xe9, 0x79, 0x27, 0x72, 0xfc, 0x5b, 0x6e, 0x5e, 0xe2, 0x17, 0xdf, 0xf1, 0x48, 0x5e,
+  0x78, 0x2c, 0x26, 0x1e, 0x1f, 0xb1, 0x53, 0xe4, 0x79, 0x92, 0xb8, 0x59, 0xb6, 0xf0, 0xdf, 0x62,
+  0xc7, 0x58, 0x97, 0xee, 0xab, 0xab, 0x05, 0x38, 0xe6, 0xfe, 0x0d, 0x44, 0x5f, 0x2d, 0x86, 0xe0,
+  0x0b, 0xfa, 0x33, 0xa0, 0x3f, 0x67, 0x1c, 0x3d, 0x7b, 0x9e, 0xdf, 0xbc, 0xc0, 0x33, 0xd8, 0xdc,
+  0x44, 0xba, 0xfd, 0x3b, 0x76, 0xcf, 0x97, 0x5e, 0xf3, 0xa3, 0x6e, 0xdd, 0xf3, 0x0b, 0xd4, 0x74,
+  0x7f, 0xb2, 0x27, 0xfc, 0x71, 0xf8, 0x7a, 0xc9, 0x13, 0x7e, 0x3b, 0xae, 0xe6, 0x4f, 0xf8, 0x66,
+  0x5c, 0x2d, 0x9e, 0xf0, 0xfc, 0xf2, 0xf2, 0x08, 0xb5, 0x84, 0x62, 0x37, 0x3b, 0xfd, 0x52, 0x69,
+  0xd3, 0xfe, 0x46, 0x16, 0xdf, 0xa8, 0xe0, 0xc7, 0xf0, 0xa7, 0x5b, 0x50, 0xc8, 0x3d, 0x1e, 0xa7,
+  0xde, 0x14, 0x0d, 0xe5, 0xd8, 0x71, 0x71, 0xae, 0x74, 0x68, 0x86, 0xed, 0xf6, 0xf4, 0x72, 0xbe,
+  0x63, 0x7b, 0x6a, 0xa3, 0x21, 0xa7, 0xa8, 0x84, 0xa2, 0x43, 0xd2, 0xe1, 0xfb, 0xac, 0x3b, 0xa6,
+  0xa6, 0x11, 0xa2, 0xa5, 0x15, 0x58, 0xd0, 0x53, 0xb2, 0x1f, 0x67, 0xdf, 0x46, 0xf0, 0x4c, 0x2f,
+  0x59, 0x4d, 0xc5, 0x4e, 0x3b, 0x53, 0x8e, 0x9f, 0xc4, 0x71, 0x0c, 0xd8, 0x33, 0x08, 0x3d, 0x98,
+  0x27, 0x70, 0x4f, 0x2a, 0x67, 0x38, 0x17, 0xc6, 0x62, 0xec, 0x1e, 0xf7, 0xbf, 0x78, 0xc0, 0xc9,
+  0xb6, 0x37, 0x75, 0x97, 0x6d, 0xd5, 0x6a, 0x13, 0x29, 0x1f, 0x3c, 0xce, 0xd0, 0x89, 0x51, 0x12,
+  0xcf, 0x2f, 0xdc, 0x50, 0x8b, 0x37, 0xf0, 0x6e, 0x96, 0x4e, 0xe2, 0x42, 0xca, 0xaf, 0x37, 0x91,
+  0xb2, 0xd1, 0x69, 0xee, 0xd1, 0x34, 0xf7, 0xc7, 0x11, 0x1f, 0xfd, 0x3b, 0xf4, 0xc8, 0xbc, 0x80,
+  0xe3, 0xe3, 0x94, 0x45, 0xe3, 0xe3, 0x17, 0x0d, 0xbf, 0x38, 0xb3, 0x7f, 0x00, 0x6f, 0x17, 0x35,
+  0x9e, 0x88, 0x06, 0x00, 0x00,
+};
+const WebAsset WEB_MIRROR = {WEB_MIRROR_DATA, sizeof(WEB_MIRROR_DATA), "\"f33c8f5ea465870b\"", "text/html"};
+
+#endif // WEB_ASSETS_H
@@ -4,100 +4,63 @@
 
 #include "web_server.h"
 #include "common_definitions.h"
+#include "qoi_encoder.h"
+#include "screen_mirror.h"
+#include "param_control.h"
+#include "rtp_midi.h"
+#include "osc_bridge.h"
+#include "storage.h"
+#include "metrics.h"
+#include "thumbnail.h"
+#include "web_assets.h"
+#include "boot_timeline.h"
 
 WebServer server(WEB_SERVER_PORT);
 bool wifiEnabled = false;
+WiFiState wifiState = WIFI_STATE_OFF;
+unsigned long wifiConnectStart = 0;
+static volatile bool wifiRequested = false;  // Set by initialize/stopWebServer(), acted on by the web task
 String wifiIPAddress = "";
 String wifiMode = "AP"; // AP or STA
 String currentPath = "/";
 
-File uploadFile;
+// Upload in progress: chunks are coalesced into a worker transfer buffer and
+// written to a ".part" file that is renamed into place once complete
+int uploadHandle = -1;  // StorageWorker handle, -1 when idle
+uint8_t* uploadBuffer = nullptr;
+size_t uploadBufferUsed = 0;
+String uploadPath;
+unsigned long uploadStartTime = 0;
+bool uploadFailed = false;
 
 // WiFi config file path
 const char* WIFI_CONFIG_FILE = "/wifi_config.txt";
 
-// Minimal HTML page for file management
-const char HTML_PAGE[] PROGMEM = R"rawliteral(
-<!DOCTYPE html><html><head><meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1'><title>CYD Manager</title><style>
-*{margin:0;padding:0;box-sizing:border-box}body{font-family:Arial,sans-serif;background:#222;color:#fff;padding:10px}
-h1{text-align:center;margin-bottom:10px;font-size:1.3em}button{padding:6px 10px;background:#28a;border:none;border-radius:4px;color:#fff;cursor:pointer;margin:2px;font-size:13px}
-button:hover{background:#3ad}input[type='file'],input[type='text'],input[type='password']{padding:6px;border:1px solid #555;border-radius:4px;background:#333;color:#fff;margin:2px;font-size:13px;width:calc(100% - 4px)}
-.breadcrumb{background:#333;padding:8px;border-radius:4px;margin-bottom:8px;font-size:14px}.breadcrumb a{color:#3ad;cursor:pointer;text-decoration:none}
-.breadcrumb a:hover{text-decoration:underline}ul{list-style:none}li{padding:6px;margin:3px 0;background:#333;border-radius:4px;display:flex;justify-content:space-between;align-items:center;flex-wrap:wrap}
-.file-info{flex:1;min-width:120px}.file-name{font-weight:bold;cursor:pointer;color:#3ad}.file-name:hover{text-decoration:underline}.file-size{opacity:0.7;font-size:0.85em;margin-left:8px}
-.folder{color:#fa0}.btn-delete{background:#c33}.btn-delete:hover{background:#e44}.status{padding:6px;margin:6px 0;border-radius:4px;display:none;font-size:13px}
-.success{background:#2a5}.error{background:#c33}.section{margin:10px 0;padding:8px;background:#2a2a2a;border-radius:4px}.section h2{font-size:1.1em;margin-bottom:6px}
-.wifi-form label{display:block;margin-top:6px;font-size:13px}.wifi-info{font-size:12px;opacity:0.8;margin-top:4px}
-.gallery{display:grid;grid-template-columns:repeat(auto-fill,minmax(150px,1fr));gap:8px;margin-top:8px}
-.gallery-item{background:#333;border-radius:4px;overflow:hidden;text-align:center;cursor:pointer;border:2px solid #444;transition:border 0.2s}
-.gallery-item:hover{border-color:#3ad}.gallery-thumb{width:100%;height:120px;background:#111;display:flex;align-items:center;justify-content:center;font-size:2em}
-.gallery-name{padding:6px;font-size:12px;word-break:break-word;overflow:hidden;text-overflow:ellipsis}
-.gallery-controls{display:flex;gap:4px;padding:4px;justify-content:center}
-.gallery-controls button{padding:4px 6px;font-size:11px}
-</style></head><body>
-<h1>🎹 CYD Manager</h1>
-<div class='section'>
-<h2>📸 Screenshots Gallery</h2>
-<button onclick='loadScreenshots()'>Refresh Gallery</button>
-<button onclick='downloadAllScreenshots()'>⬇️ Download All</button>
-<div class='gallery' id='gallery'><div style='grid-column:1/-1;text-align:center;padding:20px'>Loading...</div></div>
-</div>
-<div class='section'>
-<h2>📁 Files</h2>
-<div class='breadcrumb' id='breadcrumb'>/</div>
-<form id='up' enctype='multipart/form-data'>
-<input type='file' name='file' id='fi' required>
-<button type='submit'>Upload</button>
-<button type='button' onclick='takeScreenshot()'>📸 Screenshot</button>
-</form>
-<div class='status' id='st'></div>
-<ul id='fl'><li>Loading...</li></ul>
-<button onclick='loadFiles()'>Refresh</button>
-</div>
-<div class='section'>
-<h2>📶 WiFi Config</h2>
-<form class='wifi-form' id='wifiForm'>
-<label>SSID:<input type='text' id='ssid' placeholder='WiFi Network Name'></label>
-<label>Password:<input type='password' id='pass' placeholder='WiFi Password'></label>
-<button type='submit'>Save WiFi Config</button>
-</form>
-<div class='wifi-info' id='wifiInfo'>Current: AP Mode</div>
-</div>
-<script>
-let curPath='/';
-function fmt(b){if(b===0)return '0B';const k=1024,s=['B','KB','MB','GB'],i=Math.floor(Math.log(b)/Math.log(k));return Math.round(b/Math.pow(k,i)*100)/100+' '+s[i]}
-function updateBreadcrumb(){const parts=curPath.split('/').filter(p=>p);let html='<a onclick="navTo(\'/\')">🏠</a>';let path='';parts.forEach(p=>{path+='/'+p;html+=' / <a onclick="navTo(\''+path+'\')">'+p+'</a>'});document.getElementById('breadcrumb').innerHTML=html}
-function navTo(p){curPath=p;loadFiles()}
-function loadFiles(){fetch('/list?path='+encodeURIComponent(curPath)).then(r=>r.json()).then(f=>{const l=document.getElementById('fl');if(f.length===0){l.innerHTML='<li>No items</li>';updateBreadcrumb();return}
-l.innerHTML=f.map(item=>{if(item.isDir)return '<li><div class="file-info"><span class="file-name folder" onclick="navTo(\''+item.path+'\')">📁 '+item.name+'</span></div></li>';
-return '<li><div class="file-info"><span class="file-name">'+item.name+'</span><span class="file-size">'+fmt(item.size)+'</span></div><div><button onclick="location.href=\'/download?file='+encodeURIComponent(item.path)+'\'">⬇️</button><button class="btn-delete" onclick="del(\''+item.path+'\')">🗑️</button></div></li>'}).join('');updateBreadcrumb()}).catch(e=>console.error(e))}
-function del(n){if(!confirm('Delete '+n+'?'))return;fetch('/delete?file='+encodeURIComponent(n),{method:'DELETE'}).then(r=>{showSt(r.ok?'Deleted':'Failed',r.ok?'success':'error');if(r.ok)loadFiles()}).catch(e=>showSt('Error','error'))}
-function loadScreenshots(){fetch('/screenshots').then(r=>r.json()).then(screenshots=>{const g=document.getElementById('gallery');if(!screenshots||screenshots.length===0){g.innerHTML='<div style="grid-column:1/-1;text-align:center;padding:20px">No screenshots found</div>';return}
-g.innerHTML=screenshots.map(s=>'<div class="gallery-item"><div class="gallery-thumb">🖼️</div><div class="gallery-name">'+s.name+'</div><div class="gallery-controls"><button onclick="location.href=\'/screenshot?file='+encodeURIComponent(s.path)+'\'" style="flex:1">⬇️</button><button onclick="delScreenshot(\''+s.path+'\')">🗑️</button></div></div>').join('')}).catch(e=>{document.getElementById('gallery').innerHTML='<div style="grid-column:1/-1;text-align:center;padding:20px">Error loading screenshots</div>';console.error(e)})}
-function delScreenshot(path){if(!confirm('Delete screenshot?'))return;fetch('/screenshot?file='+encodeURIComponent(path),{method:'DELETE'}).then(r=>{if(r.ok){loadScreenshots()}}).catch(e=>console.error(e))}
-function downloadAllScreenshots(){showSt('Preparing download...','success');fetch('/screenshots').then(r=>r.json()).then(screenshots=>{if(!screenshots||screenshots.length===0){showSt('No screenshots','error');return}
-screenshots.forEach((s,i)=>{setTimeout(()=>{const a=document.createElement('a');a.href='/screenshot?file='+encodeURIComponent(s.path);a.download=s.name;a.click()},i*500)})}).catch(e=>showSt('Error','error'))}
-function takeScreenshot(){showSt('Taking screenshot...','success');fetch('/screenshot').then(r=>r.blob()).then(b=>{const url=URL.createObjectURL(b);const a=document.createElement('a');a.href=url;a.download='cyd_screen.bmp';a.click();showSt('Screenshot saved!','success');setTimeout(loadScreenshots,500)}).catch(e=>showSt('Screenshot failed','error'))}
-document.getElementById('up').addEventListener('submit',e=>{e.preventDefault();const fd=new FormData(),fi=document.getElementById('fi');fd.append('file',fi.files[0]);fd.append('path',curPath);fetch('/upload',{method:'POST',body:fd}).then(r=>{showSt(r.ok?'Uploaded!':'Failed',r.ok?'success':'error');if(r.ok){fi.value='';loadFiles()}}).catch(e=>showSt('Error','error'))});
-document.getElementById('wifiForm').addEventListener('submit',e=>{e.preventDefault();const ssid=document.getElementById('ssid').value,pass=document.getElementById('pass').value;fetch('/wifi',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({ssid:ssid,password:pass})}).then(r=>r.text()).then(t=>{showSt(t,'success');loadWifiInfo()}).catch(e=>showSt('WiFi config failed','error'))});
-function loadWifiInfo(){fetch('/wifi').then(r=>r.text()).then(t=>document.getElementById('wifiInfo').innerHTML='Current: '+t).catch(e=>{})}
-function showSt(m,t){const s=document.getElementById('st');s.textContent=m;s.className='status '+t;s.style.display='block';setTimeout(()=>s.style.display='none',3000)}
-loadFiles();loadWifiInfo();loadScreenshots()
-</script></body></html>
-)rawliteral";
+// Pages are gzipped into flash at build time (scripts/embed_web_assets.py).
+// The ETag is a hash of the compressed bytes, so browsers revalidate with a
+// 304 until the firmware's copy of the page changes.
+static void sendWebAsset(const WebAsset& asset) {
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (server.header("If-None-Match") == asset.etag) {
+    server.send(304);
+    return;
+  }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset.contentType, (const char*)asset.data, asset.length);
+}
 
 // Load WiFi config from SD card
 bool loadWiFiConfig(String &ssid, String &password) {
-  if (!SD.begin(SD_CS, sdSPI)) return false;
+  StorageSession session;
+  if (!session) return false;
   
   if (!SD.exists(WIFI_CONFIG_FILE)) {
-    SD.end();
     return false;
   }
   
   File file = SD.open(WIFI_CONFIG_FILE, FILE_READ);
   if (!file) {
-    SD.end();
     return false;
   }
   
@@ -107,224 +70,659 @@ bool loadWiFiConfig(String &ssid, String &password) {
   password.trim();
   
   file.close();
-  SD.end();
   
   return ssid.length() > 0;
 }
 
 // Save WiFi config to SD card
 bool saveWiFiConfig(const String &ssid, const String &password) {
-  if (!SD.begin(SD_CS, sdSPI)) return false;
+  StorageSession session;
+  if (!session) return false;
   
   File file = SD.open(WIFI_CONFIG_FILE, FILE_WRITE);
   if (!file) {
-    SD.end();
     return false;
   }
   
   file.println(ssid);
   file.println(password);
   file.close();
-  SD.end();
   
   return true;
 }
 
-void initializeWebServer() {
-  if (!sdCardAvailable) {
-    Serial.println("Cannot start web server: SD card not available");
-    return;
-  }
-  
-  // Try to load WiFi config from SD card
-  String savedSSID, savedPassword;
-  if (loadWiFiConfig(savedSSID, savedPassword)) {
-    // Try to connect to saved WiFi
-    Serial.printf("Connecting to WiFi: %s\n", savedSSID.c_str());
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(savedSSID.c_str(), savedPassword.c_str());
-    
-    int timeout = 20; // 10 seconds
-    while (WiFi.status() != WL_CONNECTED && timeout > 0) {
-      delay(500);
-      Serial.print(".");
-      timeout--;
-    }
-    
-    if (WiFi.status() == WL_CONNECTED) {
-      wifiMode = "STA";
-      wifiIPAddress = WiFi.localIP().toString();
-      Serial.printf("\nConnected to WiFi! IP: %s\n", wifiIPAddress.c_str());
-    } else {
-      Serial.println("\nFailed to connect, starting AP mode");
-      WiFi.mode(WIFI_AP);
-      WiFi.softAP(WIFI_SSID, WIFI_PASSWORD);
-      wifiMode = "AP";
-      wifiIPAddress = WiFi.softAPIP().toString();
-    }
-  } else {
-    // Start WiFi in AP mode
-    Serial.println("Starting WiFi Access Point...");
-    WiFi.mode(WIFI_AP);
-    WiFi.softAP(WIFI_SSID, WIFI_PASSWORD);
-    wifiMode = "AP";
-    wifiIPAddress = WiFi.softAPIP().toString();
-  }
-  
+// Registers the routes and starts listening once a link is up
+static void startServer() {
   Serial.printf("WiFi Mode: %s\n", wifiMode.c_str());
   Serial.printf("IP Address: %s\n", wifiIPAddress.c_str());
   
-  // Setup web server routes
-  server.on("/", HTTP_GET, handleRoot);
-  server.on("/list", HTTP_GET, handleFileList);
-  server.on("/upload", HTTP_POST, []() {
-    server.send(200);
-  }, handleFileUpload);
-  server.on("/download", HTTP_GET, handleFileDownload);
-  server.on("/delete", HTTP_DELETE, handleFileDelete);
-  server.on("/screenshot", HTTP_GET, handleScreenshot);
-  server.on("/screenshot", HTTP_DELETE, handleScreenshot);
-  server.on("/screenshots", HTTP_GET, handleScreenshots);
-  server.on("/wifi", HTTP_GET, handleWiFiGet);
-  server.on("/wifi", HTTP_POST, handleWiFiPost);
-  server.onNotFound(handleNotFound);
+  // Setup web server routes (once: they survive WiFi being turned off and on)
+  static bool routesAdded = false;
+  if (!routesAdded) {
+    server.on("/", HTTP_GET, handleRoot);
+    server.on("/list", HTTP_GET, handleFileList);
+    server.on("/upload", HTTP_POST, []() {
+      if (uploadFailed) {
+        server.send(500, "text/plain", "Upload failed");
+      } else {
+        server.send(200);
+      }
+    }, handleFileUpload);
+    server.on("/download", HTTP_GET, handleFileDownload);
+    server.on("/delete", HTTP_DELETE, handleFileDelete);
+    server.on("/screenshot", HTTP_GET, handleScreenshot);
+    server.on("/screenshot", HTTP_DELETE, handleScreenshot);
+    server.on("/screenshots", HTTP_GET, handleScreenshots);
+    server.on("/thumb", HTTP_GET, handleThumbnail);
+    server.on("/wifi", HTTP_GET, handleWiFiGet);
+    server.on("/wifi", HTTP_POST, handleWiFiPost);
+    server.on("/mirror", HTTP_GET, []() {
+      sendWebAsset(WEB_MIRROR);
+    });
+    server.on("/boot", HTTP_GET, []() {
+      server.send(200, "text/plain", BootTimeline::toText());
+    });
+    server.on("/metrics", HTTP_GET, []() {
+      server.send(200, "text/plain; version=0.0.4", Metrics::toText());
+    });
+    server.onNotFound(handleNotFound);
+    
+    // Request headers are dropped unless asked for
+    const char* headerKeys[] = {"If-None-Match", "If-Range", "Range", "Content-Length"};
+    server.collectHeaders(headerKeys, 4);
+    routesAdded = true;
+  }
   
   server.begin();
+  ScreenMirror::begin();
+  ParamControl::begin();
+  RtpMidi::begin();
+  OscBridge::begin();
   wifiEnabled = true;
+  wifiState = WIFI_STATE_SERVING;
   
   Serial.println("Web server started on port 80");
   Serial.printf("Visit http://%s in your browser\n", wifiIPAddress.c_str());
 }
 
-void handleWebServer() {
-  if (wifiEnabled) {
-    server.handleClient();
+static void startAccessPoint() {
+  WiFi.mode(WIFI_AP);
+  WiFi.softAP(WIFI_SSID, WIFI_PASSWORD);
+  wifiMode = "AP";
+  wifiIPAddress = WiFi.softAPIP().toString();
+}
+
+// Advances WiFi bring-up and serves requests; one pass per web task iteration
+static void handleWebServer() {
+  switch (wifiState) {
+    case WIFI_STATE_CONNECTING:
+      if (WiFi.status() == WL_CONNECTED) {
+        wifiMode = "STA";
+        wifiIPAddress = WiFi.localIP().toString();
+        Serial.printf("Connected to WiFi after %lu ms\n", millis() - wifiConnectStart);
+        startServer();
+      } else if (millis() - wifiConnectStart > WIFI_CONNECT_TIMEOUT) {
+        Serial.println("Failed to connect, starting AP mode");
+        WiFi.disconnect(true);
+        startAccessPoint();
+        startServer();
+      }
+      break;
+      
+    case WIFI_STATE_SERVING:
+      server.handleClient();
+      ScreenMirror::update();
+      ParamControl::update();
+      break;
+      
+    case WIFI_STATE_OFF:
+      break;
   }
 }
 
-void stopWebServer() {
+// Loads the saved network and starts joining it, or falls back to AP mode
+static void startWiFi() {
+  String savedSSID, savedPassword;
+  if (loadWiFiConfig(savedSSID, savedPassword)) {
+    Serial.printf("Connecting to WiFi: %s (in background)\n", savedSSID.c_str());
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(savedSSID.c_str(), savedPassword.c_str());
+    wifiState = WIFI_STATE_CONNECTING;
+    wifiConnectStart = millis();
+  } else {
+    // Start WiFi in AP mode
+    Serial.println("Starting WiFi Access Point...");
+    startAccessPoint();
+    startServer();
+  }
+}
+
+static void stopWiFi() {
+  if (wifiState == WIFI_STATE_CONNECTING) {
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    wifiState = WIFI_STATE_OFF;
+  }
   if (wifiEnabled) {
+    ScreenMirror::stop();
+    ParamControl::stop();
+    RtpMidi::stop();
+    OscBridge::stop();
     server.stop();
     WiFi.softAPdisconnect(true);
     WiFi.mode(WIFI_OFF);
     wifiEnabled = false;
+    wifiState = WIFI_STATE_OFF;
     Serial.println("Web server stopped");
   }
 }
 
+// The web task owns the server and the radio: start and stop requests are
+// carried out here between requests, so the caller never waits on a client
+static void webServerTask(void* parameter) {
+  while (true) {
+    if (wifiRequested && wifiState == WIFI_STATE_OFF) {
+      startWiFi();
+    } else if (!wifiRequested && wifiState != WIFI_STATE_OFF) {
+      stopWiFi();
+    }
+    handleWebServer();
+    vTaskDelay(WEB_TASK_IDLE_MS / portTICK_PERIOD_MS);
+  }
+}
+
+// Kicks off WiFi without waiting for it. A saved network is joined in the
+// background; the web task moves on to AP mode if that doesn't work out
+// within WIFI_CONNECT_TIMEOUT and starts the server once a link is up.
+void initializeWebServer() {
+  if (!sdCardAvailable) {
+    Serial.println("Cannot start web server: SD card not available");
+    return;
+  }
+  
+  static bool taskStarted = false;
+  wifiRequested = true;
+  if (!taskStarted) {
+    xTaskCreatePinnedToCore(webServerTask, "WebServerTask", WEB_TASK_STACK, nullptr,
+                            WEB_TASK_PRIORITY, nullptr, WEB_TASK_CORE);
+    taskStarted = true;
+  }
+}
+
+// Only asks: a download in progress notices at its next chunk and drops the
+// client, then the web task turns WiFi off
+void stopWebServer() {
+  wifiRequested = false;
+}
+
+bool webServerRequested() {
+  return wifiRequested;
+}
+
+// Streaming responses call this between chunks so a stop request doesn't
+// have to wait for a multi-megabyte transfer to finish
+static bool abortForStop() {
+  if (wifiRequested) return false;
+  Serial.println("Response aborted: web server stopping");
+  server.client().stop();
+  return true;
+}
+
 void handleRoot() {
-  server.send(200, "text/html", HTML_PAGE);
+  sendWebAsset(WEB_INDEX);
 }
 
-void handleFileList() {
-  String path = server.hasArg("path") ? server.arg("path") : "/";
+// Streams a JSON array of flat objects with chunked transfer encoding.
+// Entries are assembled in a fixed buffer and sent as it fills, so memory use
+// doesn't grow with the number of entries.
+#define JSON_STREAM_BUFFER 1024
+
+class JsonArrayStream {
+public:
+  void begin() {
+    used = 0;
+    firstEntry = true;
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+    putChar('[');
+  }
   
-  if (!SD.begin(SD_CS, sdSPI)) {
-    server.send(500, "application/json", "[]");
-    return;
+  void beginObject() {
+    if (!firstEntry) putChar(',');
+    putChar('{');
+    firstEntry = false;
+    firstField = true;
   }
   
-  File root = SD.open(path);
-  if (!root || !root.isDirectory()) {
-    SD.end();
-    server.send(404, "application/json", "[]");
-    return;
+  void addString(const char* key, const char* value, const char* suffix = nullptr) {
+    putKey(key);
+    putChar('"');
+    putEscaped(value);
+    if (suffix) putEscaped(suffix);
+    putChar('"');
   }
   
-  String json = "[";
-  bool first = true;
+  void addNumber(const char* key, uint32_t value) {
+    char digits[12];
+    snprintf(digits, sizeof(digits), "%u", (unsigned)value);
+    putKey(key);
+    put(digits);
+  }
   
-  File file = root.openNextFile();
-  while (file) {
-    if (!first) json += ",";
-    
-    String fullPath = path;
-    if (!fullPath.endsWith("/")) fullPath += "/";
-    fullPath += String(file.name());
-    
-    json += "{\"name\":\"" + String(file.name()) + "\",";
-    json += "\"path\":\"" + fullPath + "\",";
-    json += "\"isDir\":" + String(file.isDirectory() ? "true" : "false");
-    
-    if (!file.isDirectory()) {
-      json += ",\"size\":" + String(file.size());
+  void addBool(const char* key, bool value) {
+    putKey(key);
+    put(value ? "true" : "false");
+  }
+  
+  void endObject() {
+    putChar('}');
+  }
+  
+  void end() {
+    putChar(']');
+    flush();
+    server.sendContent("");  // Terminating chunk
+  }
+  
+private:
+  void putKey(const char* key) {
+    if (!firstField) putChar(',');
+    firstField = false;
+    putChar('"');
+    put(key);
+    put("\":");
+  }
+  
+  void putEscaped(const char* text) {
+    for (; *text; text++) {
+      char c = *text;
+      if (c == '"' || c == '\\') {
+        putChar('\\');
+        putChar(c);
+      } else if ((uint8_t)c < 0x20) {
+        char escaped[7];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        put(escaped);
+      } else {
+        putChar(c);
+      }
+    }
+  }
+  
+  void put(const char* text) {
+    while (*text) putChar(*text++);
+  }
+  
+  void putChar(char c) {
+    if (used == sizeof(buffer)) flush();
+    buffer[used++] = c;
+  }
+  
+  void flush() {
+    if (used == 0) return;
+    server.sendContent(buffer, used);
+    used = 0;
+  }
+  
+  char buffer[JSON_STREAM_BUFFER];
+  size_t used;
+  bool firstEntry;
+  bool firstField;
+};
+
+// Reads a directory a batch of entries at a time for the list endpoints.
+// Each batch is read with the card held and handed back with it released, so
+// the JSON goes out to the client without blocking other SD users. The
+// directory stays open between batches; a remount in between ends the listing.
+#define DIR_BATCH_ENTRIES 16
+#define DIR_NAME_MAX      64
+
+struct DirEntry {
+  char name[DIR_NAME_MAX];
+  uint32_t size;
+  bool isDir;
+};
+
+class DirectoryBatch {
+public:
+  ~DirectoryBatch() { close(); }
+  
+  // Returns 200, 404 if 'path' isn't a directory, or 500 without a card
+  int open(const char* path) {
+    StorageSession session;
+    if (!session) return 500;
+    dir = SD.open(path);
+    if (!dir || !dir.isDirectory()) {
+      dir.close();
+      return 404;
     }
+    generation = Storage::mountGeneration();
+    return 200;
+  }
+  
+  // Fills 'entries' and returns how many were read, 0 at the end
+  int next() {
+    if (!dir) return 0;
+    StorageSession session;
+    if (!session || Storage::mountGeneration() != generation) return 0;
     
-    json += "}";
-    first = false;
-    file = root.openNextFile();
+    int count = 0;
+    while (count < DIR_BATCH_ENTRIES) {
+      File file = dir.openNextFile();
+      if (!file) break;
+      DirEntry& entry = entries[count++];
+      strncpy(entry.name, file.name(), DIR_NAME_MAX - 1);
+      entry.name[DIR_NAME_MAX - 1] = '\0';
+      entry.isDir = file.isDirectory();
+      entry.size = entry.isDir ? 0 : file.size();
+    }
+    return count;
+  }
+  
+  void close() {
+    if (!dir) return;
+    StorageSession session;
+    dir.close();
+  }
+  
+  DirEntry entries[DIR_BATCH_ENTRIES];
+  
+private:
+  File dir;
+  uint32_t generation = 0;
+};
+
+// Optional ?offset=N&limit=M paging for list endpoints
+static void getPaging(uint32_t& offset, uint32_t& limit) {
+  offset = server.hasArg("offset") ? server.arg("offset").toInt() : 0;
+  limit = server.hasArg("limit") ? server.arg("limit").toInt() : UINT32_MAX;
+}
+
+void handleFileList() {
+  String path = server.hasArg("path") ? server.arg("path") : "/";
+  String prefix = path.endsWith("/") ? path : path + "/";
+  uint32_t offset, limit;
+  getPaging(offset, limit);
+  
+  DirectoryBatch dir;
+  int status = dir.open(path.c_str());
+  if (status != 200) {
+    server.send(status, "application/json", "[]");
+    return;
   }
   
-  json += "]";
-  root.close();
-  SD.end();
+  JsonArrayStream json;
+  json.begin();
   
-  server.send(200, "application/json", json);
+  uint32_t index = 0;
+  uint32_t emitted = 0;
+  int count;
+  while (emitted < limit && (count = dir.next()) > 0) {
+    for (int i = 0; i < count && emitted < limit; i++) {
+      const DirEntry& entry = dir.entries[i];
+      if (index++ < offset) continue;
+      json.beginObject();
+      json.addString("name", entry.name);
+      json.addString("path", prefix.c_str(), entry.name);
+      json.addBool("isDir", entry.isDir);
+      if (!entry.isDir) {
+        json.addNumber("size", entry.size);
+      }
+      json.endObject();
+      emitted++;
+    }
+  }
+  
+  dir.close();
+  json.end();
+}
+
+// Hands the coalesced upload data to the storage worker
+static void flushUploadBuffer() {
+  if (!uploadBuffer) return;
+  if (uploadBufferUsed > 0) {
+    StorageWorker::write(uploadHandle, uploadBuffer, uploadBufferUsed);
+  } else {
+    StorageWorker::releaseBuffer(uploadBuffer);
+  }
+  uploadBuffer = nullptr;
+  uploadBufferUsed = 0;
 }
 
 void handleFileUpload() {
   HTTPUpload& upload = server.upload();
   
-  if (upload.status == UPLOAD_FILE_START) {
-    if (!SD.begin(SD_CS, sdSPI)) {
-      Serial.println("SD card mount failed during upload");
-      return;
-    }
-    
+  // HTTP delivers ~1.4KB chunks. They are copied into a full STORAGE_BUFFER_SIZE
+  // transfer buffer before going to the worker, so the card sees large
+  // sequential writes; the loop only waits when all buffers are in flight.
+  if (upload.status == UPLOAD_FILE_START) {    
     String path = server.hasArg("path") ? server.arg("path") : "/";
     if (!path.endsWith("/")) path += "/";
-    String filename = path + upload.filename;
+    uploadPath = path + upload.filename;
+    uploadFailed = false;
+    uploadStartTime = millis();
+    
+    // The request body is the file plus a little multipart framing, so its
+    // length is a close upper bound; the worker trims the rest on close
+    uint32_t expected = server.hasHeader("Content-Length") ? server.header("Content-Length").toInt() : 0;
     
-    Serial.printf("Upload Start: %s\n", filename.c_str());
-    uploadFile = SD.open(filename, FILE_WRITE);
+    Serial.printf("Upload Start: %s (%u bytes expected)\n", uploadPath.c_str(), (unsigned)expected);
+    uploadHandle = StorageWorker::openWrite(uploadPath + ".part", expected);
     
-    if (!uploadFile) {
+    if (uploadHandle < 0) {
       Serial.println("Failed to open file for writing");
+      uploadFailed = true;
     }
   } 
   else if (upload.status == UPLOAD_FILE_WRITE) {
-    if (uploadFile) {
-      uploadFile.write(upload.buf, upload.currentSize);
+    const uint8_t* data = upload.buf;
+    size_t remaining = upload.currentSize;
+    while (uploadHandle >= 0 && remaining > 0) {
+      if (!uploadBuffer) {
+        uploadBuffer = StorageWorker::acquireBuffer();
+        uploadBufferUsed = 0;
+      }
+      size_t n = min(remaining, (size_t)STORAGE_BUFFER_SIZE - uploadBufferUsed);
+      memcpy(uploadBuffer + uploadBufferUsed, data, n);
+      uploadBufferUsed += n;
+      data += n;
+      remaining -= n;
+      if (uploadBufferUsed == STORAGE_BUFFER_SIZE) flushUploadBuffer();
     }
   } 
   else if (upload.status == UPLOAD_FILE_END) {
-    if (uploadFile) {
-      uploadFile.close();
-      Serial.printf("Upload Complete: %d bytes\n", upload.totalSize);
+    if (uploadHandle >= 0) {
+      flushUploadBuffer();
+      
+      // Wait for the tail so the file is complete before the client lists it
+      StorageFuture closed;
+      StorageWorker::close(uploadHandle, StorageFuture::complete, &closed);
+      closed.wait();
+      uploadHandle = -1;
+      
+      // Only a complete file replaces an existing one
+      String partPath = uploadPath + ".part";
+      bool ok = closed.result().ok;
+      {
+        StorageSession session;
+        ok = ok && session;
+        if (ok) {
+          if (SD.exists(uploadPath)) SD.remove(uploadPath);
+          ok = SD.rename(partPath, uploadPath);
+        }
+        if (!ok && session) SD.remove(partPath);
+      }
+      
+      unsigned long elapsed = millis() - uploadStartTime;
+      if (ok) {
+        Serial.printf("Upload Complete: %u bytes in %lu ms (%lu KB/s)\n", (unsigned)upload.totalSize,
+                      elapsed, elapsed > 0 ? (unsigned long)(upload.totalSize / elapsed) : 0UL);
+      } else {
+        Serial.println("Upload failed while writing to SD");
+        uploadFailed = true;
+      }
+    }
+  }
+  else if (upload.status == UPLOAD_FILE_ABORTED) {
+    if (uploadHandle >= 0) {
+      if (uploadBuffer) StorageWorker::releaseBuffer(uploadBuffer);
+      uploadBuffer = nullptr;
+      StorageWorker::close(uploadHandle);
+      StorageWorker::remove(uploadPath + ".part");
+      uploadHandle = -1;
+      uploadFailed = true;
+      Serial.println("Upload aborted");
     }
-    SD.end();
   }
 }
 
-void handleFileDownload() {
-  if (!server.hasArg("file")) {
-    server.send(400, "text/plain", "Missing file parameter");
-    return;
+// Returns 200 and the size, 404 if missing, 500 if the card isn't available
+// Size and a validator for a file about to be streamed. The ETag is built
+// from the size and last write time, so a file replaced between a download
+// and its resume no longer matches.
+static int getFileInfo(const String& path, size_t& size, String& etag) {
+  StorageSession session;
+  if (!session) return 500;
+  
+  File file = SD.open(path, FILE_READ);
+  if (!file || file.isDirectory()) return 404;
+  size = file.size();
+  char tag[24];
+  snprintf(tag, sizeof(tag), "\"%x-%lx\"", (unsigned)size, (unsigned long)file.getLastWrite());
+  etag = tag;
+  file.close();
+  return 200;
+}
+
+// Parses a single "bytes=" range against the file size. Returns 1 for a
+// valid range, 0 if there is none (or it's a multi-range, which we answer
+// with the whole file), -1 if it can't be satisfied.
+static int parseRange(const String& header, size_t size, size_t& first, size_t& last) {
+  if (!header.startsWith("bytes=") || header.indexOf(',') >= 0) return 0;
+  int dash = header.indexOf('-');
+  if (dash < 0) return 0;
+  String from = header.substring(6, dash);
+  String to = header.substring(dash + 1);
+  from.trim();
+  to.trim();
+  
+  if (from.length() == 0) {
+    // Suffix range: the last N bytes
+    size_t suffix = strtoul(to.c_str(), nullptr, 10);
+    if (suffix == 0 || size == 0) return -1;
+    first = suffix >= size ? 0 : size - suffix;
+    last = size - 1;
+    return 1;
   }
   
-  String filename = "/" + server.arg("file");
+  first = strtoul(from.c_str(), nullptr, 10);
+  last = to.length() > 0 ? strtoul(to.c_str(), nullptr, 10) : size - 1;
+  if (first >= size || last < first) return -1;
+  if (last >= size) last = size - 1;
+  return 1;
+}
+
+// Stream a file with the storage worker reading ahead: while one buffer goes
+// out over WiFi the next is read from the card. Honours a Range header so
+// interrupted downloads can resume (206 Partial Content). A Range sent with
+// an If-Range that doesn't match the ETag gets the whole file instead.
+static void streamFileFromWorker(const String& path, size_t size, const char* contentType,
+                                 const String& etag) {
+  size_t first = 0;
+  size_t last = size > 0 ? size - 1 : 0;
+  bool rangeValid = !server.hasHeader("If-Range") || server.header("If-Range") == etag;
+  int range = (rangeValid && server.hasHeader("Range")) ?
+              parseRange(server.header("Range"), size, first, last) : 0;
+  if (range < 0) {
+    server.sendHeader("Content-Range", "bytes */" + String((unsigned long)size));
+    server.send(416, "text/plain", "Range not satisfiable");
+    return;
+  }
   
-  if (!SD.begin(SD_CS, sdSPI)) {
-    server.send(500, "text/plain", "SD card mount failed");
+  uint8_t* buffers[2] = {StorageWorker::acquireBuffer(), StorageWorker::acquireBuffer()};
+  int handle = (buffers[0] && buffers[1]) ? StorageWorker::openRead(path, first) : -1;
+  if (handle < 0) {
+    StorageWorker::releaseBuffer(buffers[0]);
+    StorageWorker::releaseBuffer(buffers[1]);
+    server.send(503, "text/plain", "Storage busy");
     return;
   }
   
-  if (!SD.exists(filename)) {
-    server.send(404, "text/plain", "File not found");
-    SD.end();
+  size_t total = size > 0 ? last - first + 1 : 0;
+  server.sendHeader("Accept-Ranges", "bytes");
+  server.sendHeader("ETag", etag);
+  if (range > 0) {
+    server.sendHeader("Content-Range", "bytes " + String((unsigned long)first) + "-" +
+                      String((unsigned long)last) + "/" + String((unsigned long)size));
+  }
+  server.setContentLength(total);
+  server.send(range > 0 ? 206 : 200, contentType, "");
+  
+  unsigned long startTime = millis();
+  size_t sent = 0;
+  size_t requested = 0;  // Bytes asked of the worker so far
+  StorageFuture reads[2];
+  int current = 0;
+  
+  if (total > 0) {
+    size_t chunk = min(total, (size_t)STORAGE_BUFFER_SIZE);
+    StorageWorker::read(handle, buffers[0], chunk, StorageFuture::complete, &reads[0]);
+    requested = chunk;
+  }
+  
+  while (sent < total) {
+    reads[current].wait();
+    if (abortForStop()) break;
+    size_t length = reads[current].result().bytes;
+    if (!reads[current].result().ok || length == 0) break;
+    
+    // Queue the next read before sending this buffer
+    int next = 1 - current;
+    bool readQueued = false;
+    if (requested < total) {
+      size_t chunk = min(total - requested, (size_t)STORAGE_BUFFER_SIZE);
+      StorageWorker::read(handle, buffers[next], chunk, StorageFuture::complete, &reads[next]);
+      requested += chunk;
+      readQueued = true;
+    }
+    
+    WiFiClient client = server.client();
+    if (client.write(buffers[current], length) != length) {
+      if (readQueued) reads[next].wait();  // Let the outstanding read finish before the buffers go back
+      break;
+    }
+    sent += length;
+    current = next;
+    if (!readQueued) break;  // Short read earlier: nothing left in flight
+  }
+  
+  StorageWorker::close(handle);
+  StorageWorker::releaseBuffer(buffers[0]);
+  StorageWorker::releaseBuffer(buffers[1]);
+  
+  unsigned long elapsed = millis() - startTime;
+  Serial.printf("Sent %s: %u/%u bytes from offset %u in %lu ms (%lu KB/s)\n", path.c_str(),
+                (unsigned)sent, (unsigned)total, (unsigned)first, elapsed,
+                elapsed > 0 ? (unsigned long)(sent / elapsed) : 0UL);
+}
+
+void handleFileDownload() {
+  if (!server.hasArg("file")) {
+    server.send(400, "text/plain", "Missing file parameter");
     return;
   }
   
-  File file = SD.open(filename, FILE_READ);
-  if (!file) {
-    server.send(500, "text/plain", "Failed to open file");
-    SD.end();
+  String filename = "/" + server.arg("file");
+  
+  size_t size = 0;
+  String etag;
+  int status = getFileInfo(filename, size, etag);
+  if (status != 200) {
+    server.send(status, "text/plain", status == 404 ? "File not found" : "SD card not available");
     return;
   }
   
-  server.streamFile(file, "application/octet-stream");
-  file.close();
-  SD.end();
+  streamFileFromWorker(filename, size, "application/octet-stream", etag);
 }
 
 void handleFileDelete() {
@@ -335,18 +733,36 @@ void handleFileDelete() {
   
   String filename = "/" + server.arg("file");
   
-  if (!SD.begin(SD_CS, sdSPI)) {
-    server.send(500, "text/plain", "SD card mount failed");
+  StorageSession session;
+  if (!session) {
+    server.send(500, "text/plain", "SD card not available");
     return;
   }
   
   if (SD.remove(filename)) {
+    // A screenshot deleted from the file list takes its thumbnail with it
+    String thumbPath = ThumbnailBuilder::pathFor(filename);
+    if (thumbPath.length() > 0 && SD.exists(thumbPath)) SD.remove(thumbPath);
     server.send(200, "text/plain", "File deleted");
   } else {
     server.send(500, "text/plain", "Failed to delete file");
   }
-  
-  SD.end();
+}
+
+// QoiEncoder output goes straight out as HTTP chunks
+static void sendScreenshotChunk(const uint8_t* data, size_t length, void* context) {
+  server.sendContent((const char*)data, length);
+}
+
+// Once the headers are out a 503 can't be sent, so a capture that can't get
+// the display back mid-image drops the connection and the client sees a
+// short response
+static bool lockDisplayForRow() {
+  if (abortForStop()) return false;
+  if (RenderThread::lockDisplay(pdMS_TO_TICKS(WEB_DISPLAY_WAIT_MS))) return true;
+  Serial.println("Screenshot aborted: display busy");
+  server.client().stop();
+  return false;
 }
 
 void handleScreenshot() {
@@ -356,134 +772,228 @@ void handleScreenshot() {
     
     // Check if this is a DELETE request
     if (server.method() == HTTP_DELETE) {
-      if (!SD.begin(SD_CS, sdSPI)) {
-        server.send(500, "text/plain", "SD card mount failed");
+      StorageSession session;
+      if (!session) {
+        server.send(500, "text/plain", "SD card not available");
         return;
       }
       
       if (SD.remove(filename)) {
+        String thumbPath = ThumbnailBuilder::pathFor(filename);
+        if (thumbPath.length() > 0) SD.remove(thumbPath);
         server.send(200, "text/plain", "Screenshot deleted");
       } else {
         server.send(500, "text/plain", "Failed to delete screenshot");
       }
-      
-      SD.end();
       return;
     }
     
     // Download screenshot
-    if (!SD.begin(SD_CS, sdSPI)) {
-      server.send(500, "text/plain", "SD card mount failed");
+    size_t size = 0;
+    String etag;
+    int status = getFileInfo(filename, size, etag);
+    if (status != 200) {
+      server.send(status, "text/plain", status == 404 ? "Screenshot not found" : "Failed to open screenshot");
       return;
     }
     
-    if (!SD.exists(filename)) {
-      server.send(404, "text/plain", "Screenshot not found");
-      SD.end();
-      return;
-    }
+    streamFileFromWorker(filename, size, "image/bmp", etag);
+    return;
+  }
+  
+  // Otherwise, capture new screenshot (?format=qoi for the compressed stream).
+  // This runs on the web task: the display is borrowed one row at a time so
+  // the loop never waits longer than a single row read.
+  if (!RenderThread::lockDisplay(pdMS_TO_TICKS(WEB_DISPLAY_WAIT_MS))) {
+    server.send(503, "text/plain", "Display busy, try again");
+    return;
+  }
+  RenderThread::flush(); // Make sure queued tiles are on the panel before reading it back
+  RenderThread::unlockDisplay();
+  unsigned long captureStart = millis();
+  uint16_t rowBuffer[SCREEN_WIDTH];
+  
+  if (server.arg("format") == "qoi") {
+    // QOI: size isn't known up front, so stream it with chunked encoding
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.sendHeader("Content-Disposition", "inline; filename=cyd_screen.qoi");
+    server.send(200, "image/qoi", "");
     
-    File file = SD.open(filename, FILE_READ);
-    if (!file) {
-      server.send(500, "text/plain", "Failed to open screenshot");
-      SD.end();
-      return;
+    QoiEncoder encoder(sendScreenshotChunk, nullptr);
+    encoder.begin(SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+      if (!lockDisplayForRow()) return;
+      tft.readRect(0, y, SCREEN_WIDTH, 1, rowBuffer);
+      RenderThread::unlockDisplay();
+      encoder.addPixels(rowBuffer, SCREEN_WIDTH, true);
     }
+    encoder.end();
+    server.sendContent("");  // Terminating chunk
     
-    server.streamFile(file, "image/bmp");
-    file.close();
-    SD.end();
+    Serial.printf("Screenshot sent (QOI, %u bytes, %lu ms)\n",
+                  (unsigned)encoder.getBytesWritten(), millis() - captureStart);
     return;
   }
   
-  // Otherwise, capture new screenshot
-  // Create BMP header (480x320, 16-bit RGB565)
-  const int width = 480;
-  const int height = 320;
+  // BMP: 16-bit RGB565 using BI_BITFIELDS so viewers don't read it as RGB555
+  const int width = SCREEN_WIDTH;
+  const int height = SCREEN_HEIGHT;
   const int rowSize = ((width * 2 + 3) / 4) * 4; // Row must be multiple of 4 bytes
   const int imageSize = rowSize * height;
-  const int fileSize = 54 + imageSize;
+  const int headerSize = 66;                     // 14 + 40 + three colour masks
+  const int fileSize = headerSize + imageSize;
   
-  uint8_t bmpHeader[54] = {
+  uint8_t bmpHeader[headerSize] = {
     'B', 'M',                       // BM magic
     fileSize & 0xFF, (fileSize >> 8) & 0xFF, (fileSize >> 16) & 0xFF, (fileSize >> 24) & 0xFF,
     0, 0, 0, 0,                     // Reserved
-    54, 0, 0, 0,                    // Pixel data offset
+    headerSize, 0, 0, 0,            // Pixel data offset
     40, 0, 0, 0,                    // DIB header size
     width & 0xFF, (width >> 8) & 0xFF, 0, 0,
     height & 0xFF, (height >> 8) & 0xFF, 0, 0,
     1, 0,                           // Color planes
     16, 0,                          // Bits per pixel (16-bit)
-    0, 0, 0, 0,                     // No compression
+    3, 0, 0, 0,                     // BI_BITFIELDS
     imageSize & 0xFF, (imageSize >> 8) & 0xFF, (imageSize >> 16) & 0xFF, (imageSize >> 24) & 0xFF,
     0, 0, 0, 0,                     // X pixels per meter
     0, 0, 0, 0,                     // Y pixels per meter
     0, 0, 0, 0,                     // Colors in palette
-    0, 0, 0, 0                      // Important colors
+    0, 0, 0, 0,                     // Important colors
+    0x00, 0xF8, 0, 0,               // Red mask
+    0xE0, 0x07, 0, 0,               // Green mask
+    0x1F, 0x00, 0, 0                // Blue mask
   };
   
   server.setContentLength(fileSize);
   server.send(200, "image/bmp", "");
   
   // Send header
-  server.sendContent_P((const char*)bmpHeader, 54);
+  server.sendContent_P((const char*)bmpHeader, headerSize);
   
   // Send pixel data (bottom to top for BMP format)
-  uint16_t rowBuffer[width];
+  int padding = rowSize - (width * 2);
   for (int y = height - 1; y >= 0; y--) {
+    if (!lockDisplayForRow()) return;
     tft.readRect(0, y, width, 1, rowBuffer);
+    RenderThread::unlockDisplay();
+    // readRect returns display byte order; BMP wants little-endian
+    for (int x = 0; x < width; x++) {
+      rowBuffer[x] = (rowBuffer[x] >> 8) | (rowBuffer[x] << 8);
+    }
     server.sendContent_P((const char*)rowBuffer, width * 2);
     
     // Add padding if needed
-    int padding = rowSize - (width * 2);
     if (padding > 0) {
       uint8_t pad[4] = {0, 0, 0, 0};
       server.sendContent_P((const char*)pad, padding);
     }
   }
   
-  Serial.println("Screenshot sent");
+  Serial.printf("Screenshot sent (BMP, %d bytes, %lu ms)\n", fileSize, millis() - captureStart);
 }
 
 void handleScreenshots() {
-  if (!SD.begin(SD_CS, sdSPI)) {
+  uint32_t offset, limit;
+  getPaging(offset, limit);
+  
+  if (!Storage::isMounted()) {
     server.send(500, "application/json", "[]");
     return;
   }
   
-  File root = SD.open("/");
-  if (!root) {
-    SD.end();
-    server.send(500, "application/json", "[]");
+  JsonArrayStream json;
+  json.begin();
+  
+  // Captures are saved to /screenshots; older ones may sit in the root
+  const char* const folders[] = {"/screenshots", "/"};
+  const char* const prefixes[] = {"screenshots/", ""};
+  uint32_t index = 0;
+  uint32_t emitted = 0;
+  
+  for (int f = 0; f < 2 && emitted < limit; f++) {
+    DirectoryBatch dir;
+    if (dir.open(folders[f]) != 200) continue;
+    
+    int count;
+    while (emitted < limit && (count = dir.next()) > 0) {
+      for (int i = 0; i < count && emitted < limit; i++) {
+        const DirEntry& entry = dir.entries[i];
+        size_t length = strlen(entry.name);
+        
+        // Check if it's a .bmp file (thumbnails are served through /thumb)
+        if (entry.isDir || length <= 4 || strcmp(entry.name + length - 4, ".bmp") != 0 ||
+            ThumbnailBuilder::isThumbnail(entry.name)) {
+          continue;
+        }
+        if (index++ < offset) continue;
+        json.beginObject();
+        json.addString("name", entry.name);
+        json.addString("path", prefixes[f], entry.name);
+        json.addNumber("size", entry.size);
+        json.endObject();
+        emitted++;
+      }
+    }
+    dir.close();
+  }
+  
+  json.end();
+}
+
+void handleThumbnail() {
+  if (!server.hasArg("file")) {
+    server.send(400, "text/plain", "Missing file parameter");
     return;
   }
   
-  String json = "[";
-  bool first = true;
+  String filename = "/" + server.arg("file");
+  String thumbPath = ThumbnailBuilder::pathFor(filename);
+  if (thumbPath.length() == 0) {
+    server.send(400, "text/plain", "Not a screenshot");
+    return;
+  }
+  uint32_t stamp = 0;
+  size_t size = 0;
   
-  File file = root.openNextFile();
-  while (file) {
-    String filename = String(file.name());
+  {
+    StorageSession session;
+    if (!session) {
+      server.send(500, "text/plain", "SD card not available");
+      return;
+    }
     
-    // Check if it's a .bmp file
-    if (!file.isDirectory() && filename.endsWith(".bmp")) {
-      if (!first) json += ",";
-      
-      json += "{\"name\":\"" + filename + "\",";
-      json += "\"path\":\"" + filename + "\",";
-      json += "\"size\":" + String(file.size()) + "}";
-      
-      first = false;
+    // Screenshots from before thumbnails existed get one on first request
+    if (!SD.exists(thumbPath)) {
+      if (!SD.exists(filename)) {
+        server.send(404, "text/plain", "Screenshot not found");
+        return;
+      }
+      if (!ThumbnailBuilder::generate(filename)) {
+        server.send(415, "text/plain", "Unsupported image format");
+        return;
+      }
     }
     
-    file = root.openNextFile();
+    stamp = ThumbnailBuilder::readStamp(thumbPath);
+    File file = SD.open(thumbPath, FILE_READ);
+    if (file) {
+      size = file.size();
+      file.close();
+    }
   }
   
-  json += "]";
-  root.close();
-  SD.end();
+  // The stamp changes whenever the thumbnail is rewritten, so browsers can
+  // keep their copy and revalidate with a cheap 304
+  char etag[12];
+  snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned)stamp);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (stamp != 0 && server.header("If-None-Match") == etag) {
+    server.sendHeader("ETag", etag);
+    server.send(304);
+    return;
+  }
   
-  server.send(200, "application/json", json);
+  streamFileFromWorker(thumbPath, size, "image/bmp", etag);
 }
 
 void handleWiFiGet() {
@@ -11,6 +11,18 @@
 #define WIFI_SSID "CYD-MIDI"
 #define WIFI_PASSWORD "midi1234"
 #define WEB_SERVER_PORT 80
+#define WIFI_CONNECT_TIMEOUT 10000  // ms to join the saved network before falling back to AP
+
+// The server runs on its own task, so slow clients and big transfers never
+// hold up the loop. Handlers run on that task: they borrow the display with
+// RenderThread::lockDisplay() around each short read, giving up after
+// WEB_DISPLAY_WAIT_MS, and must not touch mode state directly (see
+// THREADING.md, "Web Server Task").
+#define WEB_TASK_STACK    8192
+#define WEB_TASK_PRIORITY 1
+#define WEB_TASK_CORE     0
+#define WEB_TASK_IDLE_MS  2     // Sleep between handleClient() passes
+#define WEB_DISPLAY_WAIT_MS 500 // A modal screen holds the display for as long as it's up
 
 // External references needed from main file
 extern bool sdCardAvailable;
@@ -23,13 +35,21 @@ extern SPIClass sdSPI;
 
 // Web server instance
 extern WebServer server;
-extern bool wifiEnabled;
+extern bool wifiEnabled;  // True once the server is listening
+
+// WiFi bring-up runs in the background, driven from the web task
+enum WiFiState {
+  WIFI_STATE_OFF,
+  WIFI_STATE_CONNECTING,  // Joining the saved network
+  WIFI_STATE_SERVING      // Link up (STA or AP), server running
+};
+extern WiFiState wifiState;
 extern String wifiIPAddress;
 
 // Core functions
-void initializeWebServer();
-void handleWebServer();
-void stopWebServer();
+void initializeWebServer();  // Starts WiFi and the web task; returns immediately
+void stopWebServer();        // Asks the web task to turn WiFi off; returns immediately
+bool webServerRequested();   // True from initializeWebServer() until stopWebServer()
 
 // Web interface handlers
 void handleRoot();
@@ -39,6 +59,7 @@ void handleFileDownload();
 void handleFileDelete();
 void handleScreenshot();
 void handleScreenshots();
+void handleThumbnail();
 void handleWiFiGet();
 void handleWiFiPost();
 void handleNotFound();
@@ -0,0 +1,107 @@
+#include "websocket.h"
+#include <base64.h>
+#include "mbedtls/sha1.h"
+
+bool WebSocket::accept(WiFiClient& client) {
+  // Read the HTTP upgrade request and pick out the key
+  client.setTimeout(WEBSOCKET_HANDSHAKE_TIMEOUT);
+  String key;
+  while (client.connected()) {
+    String line = client.readStringUntil('\n');
+    line.trim();
+    if (line.length() == 0) break;
+    if (line.startsWith("Sec-WebSocket-Key:")) {
+      key = line.substring(18);
+      key.trim();
+    }
+  }
+  
+  if (key.length() == 0) {
+    client.print("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    client.stop();
+    return false;
+  }
+  
+  // Sec-WebSocket-Accept = base64(sha1(key + GUID))
+  key += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+  uint8_t hash[20];
+  mbedtls_sha1_ret((const unsigned char*)key.c_str(), key.length(), hash);
+  
+  client.print("HTTP/1.1 101 Switching Protocols\r\n"
+               "Upgrade: websocket\r\n"
+               "Connection: Upgrade\r\n"
+               "Sec-WebSocket-Accept: " + base64::encode(hash, sizeof(hash)) + "\r\n\r\n");
+  client.setNoDelay(true);
+  return true;
+}
+
+bool WebSocket::send(WiFiClient& client, uint8_t opcode, const uint8_t* data, size_t length) {
+  // Length is 7-bit, 16-bit or 64-bit
+  uint8_t header[10];
+  size_t headerLength = 2;
+  header[0] = 0x80 | opcode;
+  if (length < 126) {
+    header[1] = length;
+  } else if (length < 65536) {
+    header[1] = 126;
+    header[2] = length >> 8;
+    header[3] = length & 0xFF;
+    headerLength = 4;
+  } else {
+    header[1] = 127;
+    for (int i = 0; i < 8; i++) header[2 + i] = (i < 4) ? 0 : (length >> ((7 - i) * 8)) & 0xFF;
+    headerLength = 10;
+  }
+  
+  return client.write(header, headerLength) == headerLength &&
+         (length == 0 || client.write(data, length) == length);
+}
+
+int WebSocket::poll(WiFiClient& client, uint8_t* payload, size_t capacity, size_t& length) {
+  while (client && client.available() >= 2) {
+    uint8_t header[2];
+    client.readBytes(header, 2);
+    uint8_t opcode = header[0] & 0x0F;
+    uint64_t remaining = header[1] & 0x7F;
+    if (remaining >= 126) {
+      uint8_t ext[8];
+      int extBytes = (remaining == 126) ? 2 : 8;
+      client.readBytes(ext, extBytes);
+      remaining = 0;
+      for (int i = 0; i < extBytes; i++) remaining = (remaining << 8) | ext[i];
+    }
+    uint8_t mask[4] = {0, 0, 0, 0};
+    if (header[1] & 0x80) client.readBytes(mask, 4);
+    
+    // Control frames are answered from a local buffer (125 bytes max)
+    bool control = opcode >= OP_CLOSE;
+    uint8_t controlPayload[125];
+    uint8_t* out = control ? controlPayload : payload;
+    size_t room = control ? sizeof(controlPayload) : capacity;
+    
+    // Keep what fits, discard the rest
+    size_t kept = 0;
+    while (remaining > 0) {
+      uint8_t scratch[64];
+      size_t chunk = remaining > sizeof(scratch) ? sizeof(scratch) : (size_t)remaining;
+      size_t got = client.readBytes(scratch, chunk);
+      if (got == 0) break;
+      for (size_t i = 0; i < got; i++, kept++) {
+        if (kept < room) out[kept] = scratch[i] ^ mask[kept & 3];
+      }
+      remaining -= got;
+    }
+    if (kept > room) kept = room;
+    
+    if (opcode == OP_CLOSE) {
+      send(client, OP_CLOSE, controlPayload, kept > 2 ? 2 : kept);
+      return -1;
+    } else if (opcode == OP_PING) {
+      send(client, OP_PONG, controlPayload, kept);
+    } else if (opcode == OP_TEXT || opcode == OP_BINARY) {
+      length = kept;
+      return opcode;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef WEBSOCKET_H
+#define WEBSOCKET_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Minimal WebSocket framing (RFC 6455) shared by the screen mirror and the
+// parameter control surface. Connections are plain WiFiClients accepted from
+// a WiFiServer: accept() does the HTTP upgrade, then send()/poll() exchange
+// frames. No fragmentation or extensions; payloads over the caller's buffer
+// are truncated.
+#define WEBSOCKET_HANDSHAKE_TIMEOUT 200  // ms
+
+class WebSocket {
+public:
+  enum Opcode : uint8_t {
+    OP_TEXT = 0x1,
+    OP_BINARY = 0x2,
+    OP_CLOSE = 0x8,
+    OP_PING = 0x9,
+    OP_PONG = 0xA
+  };
+  
+  // Reads the upgrade request and answers 101 (or 400 and closes)
+  static bool accept(WiFiClient& client);
+  // Server frames are unmasked
+  static bool send(WiFiClient& client, uint8_t opcode, const uint8_t* data, size_t length);
+  // Reads one frame if one has arrived. Pings are answered and closes echoed
+  // here. Returns OP_TEXT/OP_BINARY with the payload in 'payload', 0 if
+  // there was no data frame, or -1 if the peer closed.
+  static int poll(WiFiClient& client, uint8_t* payload, size_t capacity, size_t& length);
+};
+
+#endif // WEBSOCKET_H
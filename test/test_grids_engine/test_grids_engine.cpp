@@ -0,0 +1,172 @@
+// GridsEngine: map interpolation against the node tables, chaos perturbation
+// and the density threshold. Run with: pio test -e native
+
+#include <unity.h>
+#include <stdlib.h>
+#include "grids_engine.h"
+
+#define NODE_SPACING 64
+
+static int node(int voice, int step, int nodeX, int nodeY) {
+  return GridsEngine::nodeLevel(voice, step, nodeX, nodeY);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+// On a node the two 8-bit mixes each round down by at most one
+void test_level_at_nodes() {
+  for (int nodeY = 0; nodeY < GRIDS_MAP_SIZE - 1; nodeY++) {
+    for (int nodeX = 0; nodeX < GRIDS_MAP_SIZE - 1; nodeX++) {
+      for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+        for (int step = 0; step < GRIDS_STEPS; step++) {
+          int expected = node(voice, step, nodeX, nodeY);
+          int level = GridsEngine::level(voice, step, nodeX * NODE_SPACING, nodeY * NODE_SPACING);
+          TEST_ASSERT_LESS_OR_EQUAL(expected, level);
+          TEST_ASSERT_GREATER_OR_EQUAL(expected - 2, level);
+        }
+      }
+    }
+  }
+  
+  // The far edge of the pad lands (almost) on the last row and column
+  for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+    for (int step = 0; step < GRIDS_STEPS; step++) {
+      int corner = node(voice, step, GRIDS_MAP_SIZE - 1, GRIDS_MAP_SIZE - 1);
+      TEST_ASSERT_LESS_OR_EQUAL(8, abs(GridsEngine::level(voice, step, 255, 255) - corner));
+    }
+  }
+}
+
+// Halfway between nodes is the average of the corners around it
+void test_level_at_cell_midpoints() {
+  const int half = NODE_SPACING / 2;
+  for (int nodeY = 0; nodeY < GRIDS_MAP_SIZE - 1; nodeY++) {
+    for (int nodeX = 0; nodeX < GRIDS_MAP_SIZE - 1; nodeX++) {
+      int x = nodeX * NODE_SPACING;
+      int y = nodeY * NODE_SPACING;
+      for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+        for (int step = 0; step < GRIDS_STEPS; step++) {
+          int a = node(voice, step, nodeX, nodeY);
+          int b = node(voice, step, nodeX + 1, nodeY);
+          int c = node(voice, step, nodeX, nodeY + 1);
+          int d = node(voice, step, nodeX + 1, nodeY + 1);
+          
+          int centre = GridsEngine::level(voice, step, x + half, y + half);
+          TEST_ASSERT_LESS_OR_EQUAL(3, abs(centre - (a + b + c + d) / 4));
+          int edge = GridsEngine::level(voice, step, x + half, y);
+          TEST_ASSERT_LESS_OR_EQUAL(2, abs(edge - (a + b) / 2));
+        }
+      }
+    }
+  }
+}
+
+// Moving across a cell goes steadily from one node to the next
+void test_level_monotonic_between_nodes() {
+  for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+    for (int step = 0; step < GRIDS_STEPS; step++) {
+      bool rising = node(voice, step, 1, 2) >= node(voice, step, 0, 2);
+      int previous = GridsEngine::level(voice, step, 0, 2 * NODE_SPACING);
+      for (int x = 1; x < NODE_SPACING; x++) {
+        int level = GridsEngine::level(voice, step, x, 2 * NODE_SPACING);
+        TEST_ASSERT_TRUE(rising ? level >= previous : level <= previous);
+        previous = level;
+      }
+    }
+  }
+}
+
+void test_chaos_zero_plays_the_map() {
+  GridsEngine engine(1234);
+  const uint8_t density[GRIDS_VOICES] = {128, 128, 128};
+  for (int cycle = 0; cycle < 4; cycle++) {
+    for (int step = 0; step < GRIDS_STEPS; step++) {
+      GridsHits hits = engine.evaluate(step, 100, 170, density, 0);
+      for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+        TEST_ASSERT_EQUAL_UINT8(GridsEngine::level(voice, step, 100, 170), hits.level[voice]);
+      }
+    }
+  }
+}
+
+// Full chaos adds up to a quarter of the range, drawn once per pattern cycle
+void test_chaos_full_perturbation() {
+  GridsEngine engine(99);
+  const uint8_t density[GRIDS_VOICES] = {0, 0, 0};
+  bool perturbed = false;
+  for (int cycle = 0; cycle < 16; cycle++) {
+    int push[GRIDS_VOICES] = {-1, -1, -1};
+    for (int step = 0; step < GRIDS_STEPS; step++) {
+      GridsHits hits = engine.evaluate(step, 40, 40, density, 255);
+      for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+        int level = GridsEngine::level(voice, step, 40, 40);
+        int added = hits.level[voice] - level;
+        TEST_ASSERT_GREATER_OR_EQUAL(0, added);
+        TEST_ASSERT_LESS_OR_EQUAL(62, added);
+        if (hits.level[voice] == 255) continue;  // Saturated, push not visible
+        if (push[voice] < 0) push[voice] = added;
+        TEST_ASSERT_EQUAL(push[voice], added);
+        perturbed |= added > 0;
+      }
+    }
+  }
+  TEST_ASSERT_TRUE(perturbed);
+  
+  // The same seed gives the same patterns
+  GridsEngine a(7), b(7);
+  for (int step = 0; step < GRIDS_STEPS * 3; step++) {
+    GridsHits ha = a.evaluate(step, 0, 0, density, 255);
+    GridsHits hb = b.evaluate(step, 0, 0, density, 255);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ha.level, hb.level, GRIDS_VOICES);
+  }
+}
+
+void test_density_extremes() {
+  GridsEngine engine;
+  const uint8_t silent[GRIDS_VOICES] = {0, 0, 0};
+  const uint8_t full[GRIDS_VOICES] = {255, 255, 255};
+  for (int step = 0; step < GRIDS_STEPS; step++) {
+    GridsHits hits = engine.evaluate(step, 128, 128, silent, 255);
+    for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+      TEST_ASSERT_FALSE(hits.trigger[voice]);
+    }
+    hits = engine.evaluate(step, 128, 128, full, 0);
+    for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+      TEST_ASSERT_EQUAL(hits.level[voice] > 0, hits.trigger[voice]);
+    }
+  }
+}
+
+// A step fires once the density passes 255 minus its level
+void test_density_threshold() {
+  GridsEngine engine;
+  int checked = 0;
+  for (int voice = 0; voice < GRIDS_VOICES; voice++) {
+    for (int step = 0; step < GRIDS_STEPS; step++) {
+      int level = GridsEngine::level(voice, step, 200, 60);
+      if (level == 0 || level == 255) continue;
+      uint8_t density[GRIDS_VOICES] = {0, 0, 0};
+      
+      density[voice] = 255 - level;
+      TEST_ASSERT_FALSE(engine.evaluate(step, 200, 60, density, 0).trigger[voice]);
+      density[voice] = 256 - level;
+      TEST_ASSERT_TRUE(engine.evaluate(step, 200, 60, density, 0).trigger[voice]);
+      checked++;
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(GRIDS_STEPS, checked);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_level_at_nodes);
+  RUN_TEST(test_level_at_cell_midpoints);
+  RUN_TEST(test_level_monotonic_between_nodes);
+  RUN_TEST(test_chaos_zero_plays_the_map);
+  RUN_TEST(test_chaos_full_perturbation);
+  RUN_TEST(test_density_extremes);
+  RUN_TEST(test_density_threshold);
+  return UNITY_END();
+}
@@ -0,0 +1,332 @@
+// OscWriter/OscMessage round trips, bundle handling, rejection of malformed
+// packets and the bridge's address routing. Run with: pio test -e native
+
+#include <unity.h>
+#include <string.h>
+#include "osc.h"
+
+#define MAX_SEEN 8
+
+struct Seen {
+  char address[32];
+  char types[8];
+  int32_t ints[4];
+  float floats[4];
+};
+
+static Seen seen[MAX_SEEN];
+static int seenCount;
+static uint8_t buffer[256];
+
+static void collect(const OscMessage& message, void*) {
+  if (seenCount == MAX_SEEN) return;
+  Seen& s = seen[seenCount++];
+  strncpy(s.address, message.address, sizeof(s.address) - 1);
+  strncpy(s.types, message.types, sizeof(s.types) - 1);
+  for (int i = 0; i < message.argCount() && i < 4; i++) {
+    message.getInt(i, s.ints[i]);
+    message.getFloat(i, s.floats[i]);
+  }
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+// Parses a single message written by hand (padded with zeros to 4 bytes)
+static bool parseRaw(OscMessage& message, const char* raw, size_t length) {
+  memset(buffer, 0, sizeof(buffer));
+  memcpy(buffer, raw, length);
+  return message.parse(buffer, (length + 3) & ~(size_t)3);
+}
+
+static OscRoute route(const char* address, const char* types, int32_t a = 0, float b = 0) {
+  static uint8_t packet[64];
+  OscWriter writer(packet, sizeof(packet));
+  writer.beginMessage(address, types);
+  for (const char* t = types; *t; t++) {
+    if (*t == 'i') writer.addInt(t == types ? a : (int32_t)b);
+    else writer.addFloat(t == types ? (float)a : b);
+  }
+  writer.endMessage();
+  
+  OscMessage message;
+  TEST_ASSERT_TRUE(message.parse(packet, writer.length()));
+  return oscRoute(message);
+}
+
+// Empty bundles, each the only element of the one before
+static size_t nestedBundles(uint8_t* out, int levels) {
+  size_t total = levels * 16 + (levels - 1) * 4;
+  size_t pos = 0;
+  for (int level = 0; level < levels; level++) {
+    if (level > 0) {
+      put32(out + pos, total - pos - 4);
+      pos += 4;
+    }
+    memcpy(out + pos, "#bundle", 8);
+    memset(out + pos + 8, 0, 7);
+    out[pos + 15] = 1;
+    pos += 16;
+  }
+  return total;
+}
+
+void setUp() {
+  memset(seen, 0, sizeof(seen));
+  seenCount = 0;
+}
+
+void tearDown() {}
+
+void test_message_round_trip() {
+  OscWriter writer(buffer, sizeof(buffer));
+  TEST_ASSERT_TRUE(writer.beginMessage("/midi/note", "iif"));
+  writer.addInt(10);
+  writer.addInt(-60);
+  writer.addFloat(0.25f);
+  writer.endMessage();
+  
+  // Address and ",iif" are each padded to 4 bytes
+  TEST_ASSERT_EQUAL(12u + 8 + 12, writer.length());
+  const uint8_t typeTags[] = {',', 'i', 'i', 'f', 0, 0, 0, 0};
+  TEST_ASSERT_EQUAL_MEMORY(typeTags, writer.data() + 12, sizeof(typeTags));
+  
+  TEST_ASSERT_TRUE(oscDispatch(writer.data(), writer.length(), collect, nullptr));
+  TEST_ASSERT_EQUAL(1, seenCount);
+  TEST_ASSERT_EQUAL_STRING("/midi/note", seen[0].address);
+  TEST_ASSERT_EQUAL_STRING("iif", seen[0].types);
+  TEST_ASSERT_EQUAL_INT32(10, seen[0].ints[0]);
+  TEST_ASSERT_EQUAL_INT32(-60, seen[0].ints[1]);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.25f, seen[0].floats[2]);
+  
+  // Without a bundle, the writer holds a single message
+  TEST_ASSERT_FALSE(writer.beginMessage("/again", ""));
+}
+
+void test_numeric_conversion_and_strings() {
+  OscMessage message;
+  // "/x" ",fis" 2.6f -3 "hi"
+  const char raw[] = "/x\0\0,fis\0\0\0\0\x40\x26\x66\x66\xFF\xFF\xFF\xFDhi\0\0";
+  TEST_ASSERT_TRUE(parseRaw(message, raw, sizeof(raw) - 1));
+  TEST_ASSERT_EQUAL(3, message.argCount());
+  
+  int32_t i;
+  float f;
+  const char* s;
+  TEST_ASSERT_TRUE(message.getInt(0, i));
+  TEST_ASSERT_EQUAL_INT32(3, i);  // Floats round to the nearest int
+  TEST_ASSERT_TRUE(message.getFloat(1, f));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001f, -3.0f, f);
+  TEST_ASSERT_TRUE(message.getString(2, s));
+  TEST_ASSERT_EQUAL_STRING("hi", s);
+  TEST_ASSERT_FALSE(message.getInt(2, i));
+  TEST_ASSERT_FALSE(message.getString(0, s));
+  TEST_ASSERT_FALSE(message.getInt(3, i));
+}
+
+// NaN is rejected; floats beyond int32_t saturate rather than wrap
+void test_float_to_int_limits() {
+  OscMessage message;
+  // "/x" ",fff" NaN 1e10f -1e10f
+  const char raw[] = "/x\0\0,fff\0\0\0\0\x7F\xC0\0\0\x50\x15\x02\xF9\xD0\x15\x02\xF9";
+  TEST_ASSERT_TRUE(parseRaw(message, raw, sizeof(raw) - 1));
+  
+  int32_t i = 42;
+  TEST_ASSERT_FALSE(message.getInt(0, i));
+  TEST_ASSERT_EQUAL_INT32(42, i);
+  TEST_ASSERT_TRUE(message.getInt(1, i));
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, i);
+  TEST_ASSERT_TRUE(message.getInt(2, i));
+  TEST_ASSERT_EQUAL_INT32(INT32_MIN, i);
+}
+
+void test_bundle_packing() {
+  OscWriter writer(buffer, sizeof(buffer));
+  writer.beginBundle();
+  for (int n = 0; n < 3; n++) {
+    TEST_ASSERT_TRUE(writer.beginMessage("/midi/cc", "iii"));
+    writer.addInt(1);
+    writer.addInt(n);
+    writer.addInt(100 + n);
+    writer.endMessage();
+  }
+  TEST_ASSERT_EQUAL(3, writer.messageCount());
+  
+  // "#bundle", immediate timetag, then each element's size and message
+  TEST_ASSERT_EQUAL_MEMORY("#bundle", writer.data(), 8);
+  const uint8_t timetag[] = {0, 0, 0, 0, 0, 0, 0, 1};
+  TEST_ASSERT_EQUAL_MEMORY(timetag, writer.data() + 8, 8);
+  const uint8_t size[] = {0, 0, 0, 32};
+  TEST_ASSERT_EQUAL_MEMORY(size, writer.data() + 16, 4);
+  TEST_ASSERT_EQUAL(16u + 3 * 36, writer.length());
+  
+  TEST_ASSERT_TRUE(oscDispatch(writer.data(), writer.length(), collect, nullptr));
+  TEST_ASSERT_EQUAL(3, seenCount);
+  for (int n = 0; n < 3; n++) {
+    TEST_ASSERT_EQUAL_STRING("/midi/cc", seen[n].address);
+    TEST_ASSERT_EQUAL_INT32(n, seen[n].ints[1]);
+    TEST_ASSERT_EQUAL_INT32(100 + n, seen[n].ints[2]);
+  }
+}
+
+void test_bundle_full() {
+  uint8_t small[64];
+  OscWriter writer(small, sizeof(small));
+  writer.beginBundle();
+  int written = 0;
+  while (writer.beginMessage("/midi/note", "iii")) {
+    writer.addInt(1);
+    writer.addInt(60);
+    writer.addInt(written);
+    writer.endMessage();
+    written++;
+  }
+  
+  // The message that didn't fit left no trace
+  TEST_ASSERT_EQUAL(1, written);
+  TEST_ASSERT_EQUAL(16u + 4 + 32, writer.length());
+  TEST_ASSERT_TRUE(oscDispatch(writer.data(), writer.length(), collect, nullptr));
+  TEST_ASSERT_EQUAL(1, seenCount);
+}
+
+void test_nested_bundles() {
+  // Outer bundle holding a message and an inner bundle with another
+  OscWriter inner(buffer + 128, 128);
+  inner.beginBundle();
+  inner.beginMessage("/inner", "i");
+  inner.addInt(2);
+  inner.endMessage();
+  
+  OscWriter outer(buffer, 128);
+  outer.beginBundle();
+  outer.beginMessage("/outer", "i");
+  outer.addInt(1);
+  outer.endMessage();
+  size_t pos = outer.length();
+  put32(buffer + pos, inner.length());
+  memcpy(buffer + pos + 4, inner.data(), inner.length());
+  size_t length = pos + 4 + inner.length();
+  
+  TEST_ASSERT_TRUE(oscDispatch(buffer, length, collect, nullptr));
+  TEST_ASSERT_EQUAL(2, seenCount);
+  TEST_ASSERT_EQUAL_STRING("/outer", seen[0].address);
+  TEST_ASSERT_EQUAL_STRING("/inner", seen[1].address);
+  TEST_ASSERT_EQUAL_INT32(2, seen[1].ints[0]);
+}
+
+void test_malformed_messages() {
+  OscMessage message;
+  // Not an address, unterminated, not a multiple of 4, arguments past the end
+  TEST_ASSERT_FALSE(parseRaw(message, "midi\0\0\0\0", 8));
+  TEST_ASSERT_FALSE(message.parse((const uint8_t*)"/abcdefg", 8));
+  TEST_ASSERT_FALSE(message.parse((const uint8_t*)"/ab\0\0", 5));
+  TEST_ASSERT_FALSE(parseRaw(message, "/a\0\0,ii\0\0\0\0\x01", 12));
+  TEST_ASSERT_FALSE(parseRaw(message, "/a\0\0,s\0\0abcd", 12));
+  
+  // Old senders leave out the type tags
+  TEST_ASSERT_TRUE(parseRaw(message, "/ping", 5));
+  TEST_ASSERT_EQUAL(0, message.argCount());
+  
+  // Unknown types end the readable arguments
+  TEST_ASSERT_TRUE(parseRaw(message, "/a\0\0,ib\0\0\0\0\x07", 12));
+  TEST_ASSERT_EQUAL(1, message.argCount());
+}
+
+void test_malformed_bundles() {
+  OscWriter writer(buffer, sizeof(buffer));
+  writer.beginBundle();
+  writer.beginMessage("/first", "i");
+  writer.addInt(1);
+  writer.endMessage();
+  writer.beginMessage("/second", "i");
+  writer.addInt(2);
+  writer.endMessage();
+  size_t length = writer.length();
+  
+  // A datagram cut short (what reading an oversized packet into a smaller
+  // buffer leaves) is rejected; messages before the fault still arrive
+  TEST_ASSERT_FALSE(oscDispatch(buffer, length - 4, collect, nullptr));
+  TEST_ASSERT_EQUAL(1, seenCount);
+  
+  // Element size past the end of the packet
+  seenCount = 0;
+  put32(buffer + 16, 0x7FFFFFF0);
+  TEST_ASSERT_FALSE(oscDispatch(buffer, length, collect, nullptr));
+  TEST_ASSERT_EQUAL(0, seenCount);
+  
+  // Trailing bytes that don't make an element
+  put32(buffer + 16, 16);
+  TEST_ASSERT_FALSE(oscDispatch(buffer, 16 + 4 + 16 + 2, collect, nullptr));
+  
+  // Nesting past the limit
+  TEST_ASSERT_TRUE(oscDispatch(buffer, nestedBundles(buffer, 4), collect, nullptr));
+  TEST_ASSERT_FALSE(oscDispatch(buffer, nestedBundles(buffer, 5), collect, nullptr));
+}
+
+void test_param_routing() {
+  OscRoute r = route("/param/grids.patternX", "i", 200);
+  TEST_ASSERT_EQUAL(OscRoute::PARAM_NAME, r.kind);
+  TEST_ASSERT_EQUAL_STRING("grids.patternX", r.name);
+  TEST_ASSERT_EQUAL_INT32(200, r.value);
+  
+  r = route("/param/lfo.rate", "");
+  TEST_ASSERT_EQUAL(OscRoute::NONE, r.kind);  // Value missing
+  
+  r = route("/param", "ii", 3, 64);
+  TEST_ASSERT_EQUAL(OscRoute::PARAM_ID, r.kind);
+  TEST_ASSERT_EQUAL_INT32(3, r.id);
+  TEST_ASSERT_EQUAL_INT32(64, r.value);
+  
+  r = route("/param", "if", 4, 99.6f);
+  TEST_ASSERT_EQUAL(OscRoute::PARAM_ID, r.kind);
+  TEST_ASSERT_EQUAL_INT32(100, r.value);
+  
+  r = route("/param", "ii", 7, 100000);
+  TEST_ASSERT_EQUAL_INT32(32767, r.value);
+  r = route("/param", "ii", 7, -100000);
+  TEST_ASSERT_EQUAL_INT32(-32768, r.value);
+  
+  TEST_ASSERT_EQUAL(OscRoute::NONE, route("/param", "ii", 256, 1).kind);
+  TEST_ASSERT_EQUAL(OscRoute::NONE, route("/param", "ii", -1, 1).kind);
+  TEST_ASSERT_EQUAL(OscRoute::NONE, route("/param", "i", 3).kind);
+}
+
+void test_transport_and_subscribe_routing() {
+  OscRoute r = route("/transport/play", "i", 5);
+  TEST_ASSERT_EQUAL(OscRoute::PLAY, r.kind);
+  TEST_ASSERT_EQUAL_INT32(1, r.value);
+  TEST_ASSERT_EQUAL_INT32(0, route("/transport/play", "f", 0).value);
+  
+  r = route("/transport/bpm", "f", 128);
+  TEST_ASSERT_EQUAL(OscRoute::BPM, r.kind);
+  TEST_ASSERT_EQUAL_INT32(128, r.value);
+  
+  r = route("/cyd/subscribe", "i", 9100);
+  TEST_ASSERT_EQUAL(OscRoute::SUBSCRIBE, r.kind);
+  TEST_ASSERT_EQUAL_INT32(9100, r.value);
+  TEST_ASSERT_EQUAL_INT32(0, route("/cyd/subscribe", "").value);
+  TEST_ASSERT_EQUAL_INT32(0, route("/cyd/subscribe", "i", 70000).value);
+  
+  TEST_ASSERT_EQUAL(OscRoute::UNSUBSCRIBE, route("/cyd/unsubscribe", "").kind);
+  TEST_ASSERT_EQUAL(OscRoute::NONE, route("/params", "ii", 1, 2).kind);
+  TEST_ASSERT_EQUAL(OscRoute::NONE, route("/transport", "i", 1).kind);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_message_round_trip);
+  RUN_TEST(test_numeric_conversion_and_strings);
+  RUN_TEST(test_float_to_int_limits);
+  RUN_TEST(test_bundle_packing);
+  RUN_TEST(test_bundle_full);
+  RUN_TEST(test_nested_bundles);
+  RUN_TEST(test_malformed_messages);
+  RUN_TEST(test_malformed_bundles);
+  RUN_TEST(test_param_routing);
+  RUN_TEST(test_transport_and_subscribe_routing);
+  return UNITY_END();
+}
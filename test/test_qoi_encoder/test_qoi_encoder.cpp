@@ -0,0 +1,171 @@
+// QoiEncoder round trips through a decoder written from the QOI spec
+// (https://qoiformat.org/qoi-specification.pdf). Run with: pio test -e native
+
+#include <unity.h>
+#include <stdlib.h>
+#include <vector>
+#include "qoi_encoder.h"
+
+struct Rgba {
+  uint8_t r, g, b, a;
+  bool operator==(const Rgba& o) const { return r == o.r && g == o.g && b == o.b && a == o.a; }
+};
+
+static std::vector<uint8_t> output;
+static int chunks;
+
+static void collect(const uint8_t* data, size_t length, void*) {
+  output.insert(output.end(), data, data + length);
+  chunks++;
+}
+
+// Reference decoder: index starts as all RGBA 0,0,0,0, previous pixel 0,0,0,255
+static bool decode(const std::vector<uint8_t>& data, uint32_t& width, uint32_t& height,
+                   std::vector<Rgba>& pixels) {
+  if (data.size() < 22 || memcmp(data.data(), "qoif", 4) != 0) return false;
+  width = (data[4] << 24) | (data[5] << 16) | (data[6] << 8) | data[7];
+  height = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
+  if (data[12] != 3 && data[12] != 4) return false;
+  
+  Rgba index[64];
+  memset(index, 0, sizeof(index));
+  Rgba px = {0, 0, 0, 255};
+  size_t pos = 14;
+  size_t end = data.size() - 8;
+  pixels.clear();
+  
+  while (pixels.size() < (size_t)width * height) {
+    if (pos >= end) return false;
+    uint8_t b1 = data[pos++];
+    int run = 1;
+    if (b1 == 0xFE) {
+      px.r = data[pos++];
+      px.g = data[pos++];
+      px.b = data[pos++];
+    } else if (b1 == 0xFF) {
+      px.r = data[pos++];
+      px.g = data[pos++];
+      px.b = data[pos++];
+      px.a = data[pos++];
+    } else if ((b1 & 0xC0) == 0x00) {
+      px = index[b1];
+    } else if ((b1 & 0xC0) == 0x40) {
+      px.r += ((b1 >> 4) & 0x03) - 2;
+      px.g += ((b1 >> 2) & 0x03) - 2;
+      px.b += (b1 & 0x03) - 2;
+    } else if ((b1 & 0xC0) == 0x80) {
+      uint8_t b2 = data[pos++];
+      int dg = (b1 & 0x3F) - 32;
+      px.r += dg - 8 + ((b2 >> 4) & 0x0F);
+      px.g += dg;
+      px.b += dg - 8 + (b2 & 0x0F);
+    } else {
+      run = (b1 & 0x3F) + 1;
+    }
+    index[(px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64] = px;
+    for (int i = 0; i < run; i++) pixels.push_back(px);
+  }
+  
+  static const uint8_t endMarker[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+  return pos == end && memcmp(data.data() + end, endMarker, 8) == 0;
+}
+
+static Rgba expand(uint16_t color) {
+  uint8_t r = (color >> 11) & 0x1F;
+  uint8_t g = (color >> 5) & 0x3F;
+  uint8_t b = color & 0x1F;
+  return {(uint8_t)((r << 3) | (r >> 2)), (uint8_t)((g << 2) | (g >> 4)), (uint8_t)((b << 3) | (b >> 2)), 255};
+}
+
+// Encodes a row at a time (as the screenshot handler does) and checks the decode
+static void roundTrip(const std::vector<uint16_t>& image, uint32_t width, uint32_t height,
+                      bool swapped = false) {
+  QoiEncoder encoder(collect, nullptr);
+  encoder.begin(width, height);
+  for (uint32_t y = 0; y < height; y++) {
+    encoder.addPixels(&image[y * width], width, swapped);
+  }
+  encoder.end();
+  TEST_ASSERT_EQUAL_UINT32(output.size(), encoder.getBytesWritten());
+  
+  uint32_t w, h;
+  std::vector<Rgba> pixels;
+  TEST_ASSERT_TRUE(decode(output, w, h, pixels));
+  TEST_ASSERT_EQUAL_UINT32(width, w);
+  TEST_ASSERT_EQUAL_UINT32(height, h);
+  for (size_t i = 0; i < image.size(); i++) {
+    uint16_t color = swapped ? (uint16_t)((image[i] >> 8) | (image[i] << 8)) : image[i];
+    TEST_ASSERT_TRUE_MESSAGE(expand(color) == pixels[i], "pixel mismatch");
+  }
+}
+
+void setUp() {
+  output.clear();
+  chunks = 0;
+}
+
+void tearDown() {}
+
+void test_header() {
+  QoiEncoder encoder(collect, nullptr);
+  encoder.begin(480, 320);
+  encoder.end();
+  static const uint8_t expected[] = {'q', 'o', 'i', 'f', 0, 0, 1, 0xE0, 0, 0, 1, 0x40, 3, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 1};
+  TEST_ASSERT_EQUAL_UINT32(sizeof(expected), output.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output.data(), sizeof(expected));
+}
+
+// Opaque black hashes to slot 53, which a decoder starts as transparent black
+void test_black_after_other_colours() {
+  std::vector<uint16_t> image = {0xFFFF, 0x0000, 0xF800, 0x0000, 0x07E0, 0x0000, 0x0000, 0x001F};
+  roundTrip(image, 4, 2);
+}
+
+void test_flat_screen_with_long_runs() {
+  std::vector<uint16_t> image(480 * 320, 0x0000);
+  for (int x = 100; x < 200; x++) image[160 * 480 + x] = 0xFFFF;
+  roundTrip(image, 480, 320);
+  TEST_ASSERT_GREATER_THAN(1, chunks);        // Spans several output buffers
+  TEST_ASSERT_LESS_THAN(4000u, output.size());  // Runs keep it tiny
+}
+
+void test_gradients_use_diff_and_luma() {
+  std::vector<uint16_t> image;
+  for (int y = 0; y < 32; y++) {
+    for (int x = 0; x < 64; x++) {
+      image.push_back(((x / 2) << 11) | (y << 5) | ((x + y) & 0x1F));
+    }
+  }
+  roundTrip(image, 64, 32);
+}
+
+void test_random_pixels() {
+  static const uint16_t palette[] = {0x0000, 0xFFFF, 0x39E7, 0xFD20};
+  srand(1234);
+  std::vector<uint16_t> image;
+  for (int i = 0; i < 97 * 31; i++) {
+    // Mix of repeats, a small palette (index hits) and noise
+    int pick = rand() % 4;
+    if (pick == 0 && !image.empty()) image.push_back(image.back());
+    else if (pick == 1) image.push_back(palette[rand() % 4]);
+    else image.push_back(rand() & 0xFFFF);
+  }
+  roundTrip(image, 97, 31);
+}
+
+void test_swapped_byte_order() {
+  std::vector<uint16_t> image = {0x00F8, 0xE007, 0x1F00, 0x0000, 0xFFFF, 0x0000};
+  roundTrip(image, 3, 2, true);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_header);
+  RUN_TEST(test_black_after_other_colours);
+  RUN_TEST(test_flat_screen_with_long_runs);
+  RUN_TEST(test_gradients_use_diff_and_luma);
+  RUN_TEST(test_random_pixels);
+  RUN_TEST(test_swapped_byte_order);
+  return UNITY_END();
+}
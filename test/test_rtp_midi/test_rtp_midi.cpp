@@ -0,0 +1,255 @@
+// RtpMidiSession: AppleMIDI handshake, clock sync, and recovery journal
+// truncation once peers acknowledge. Run with: pio test -e native
+
+#include <unity.h>
+#include <string.h>
+#include "rtp_midi_protocol.h"
+
+#define OUR_SSRC    0x12340000u  // First sequence number is the top half
+#define FIRST_SEQ   0x1234
+#define PEER_SSRC   0xCAFE0001u
+#define PEER_ADDR   0xC0A80002u
+#define PEER_PORT   5004
+
+static RtpMidiSession* session;
+static uint8_t reply[256];
+static uint8_t packet[256];
+
+static void put16(uint8_t* p, uint16_t v) { p[0] = v >> 8; p[1] = v; }
+static void put32(uint8_t* p, uint32_t v) { put16(p, v >> 16); put16(p + 2, v); }
+static void put64(uint8_t* p, uint64_t v) { put32(p, v >> 32); put32(p + 4, v); }
+static uint16_t get16(const uint8_t* p) { return (p[0] << 8) | p[1]; }
+static uint32_t get32(const uint8_t* p) { return ((uint32_t)get16(p) << 16) | get16(p + 2); }
+static uint64_t get64(const uint8_t* p) { return ((uint64_t)get32(p) << 32) | get32(p + 4); }
+
+static size_t appleMidi(uint8_t* out, char c0, char c1) {
+  out[0] = 0xFF;
+  out[1] = 0xFF;
+  out[2] = c0;
+  out[3] = c1;
+  return 4;
+}
+
+// IN/BY: signature, command, version, token, SSRC, name
+static size_t invite(bool dataPort, uint32_t ssrc, uint32_t token, uint32_t address,
+                     const char* name = "Mac") {
+  uint8_t in[64];
+  appleMidi(in, 'I', 'N');
+  put32(in + 4, 2);
+  put32(in + 8, token);
+  put32(in + 12, ssrc);
+  size_t length = 16 + strlen(name) + 1;
+  memcpy(in + 16, name, strlen(name) + 1);
+  return session->handlePacket(dataPort, address, PEER_PORT + dataPort, in, length, 1000,
+                               reply, sizeof(reply));
+}
+
+static void connect(uint32_t ssrc, uint32_t address = PEER_ADDR) {
+  TEST_ASSERT_GREATER_THAN(0u, invite(false, ssrc, 0x55, address));
+  TEST_ASSERT_GREATER_THAN(0u, invite(true, ssrc, 0x55, address));
+}
+
+// RS: signature, command, SSRC, highest sequence number received
+static void feedback(uint32_t ssrc, uint16_t seq) {
+  uint8_t rs[12] = {0};
+  appleMidi(rs, 'R', 'S');
+  put32(rs + 4, ssrc);
+  put16(rs + 8, seq);
+  TEST_ASSERT_EQUAL(0u, session->handlePacket(false, PEER_ADDR, PEER_PORT, rs, sizeof(rs), 2000,
+                                              reply, sizeof(reply)));
+}
+
+static size_t sendMidi(const uint8_t* midi, size_t length) {
+  return session->encodeMidi(midi, length, 3000, packet, sizeof(packet));
+}
+
+void setUp() {
+  session = new RtpMidiSession(OUR_SSRC, "CYD");
+}
+
+void tearDown() {
+  delete session;
+}
+
+void test_invitation_handshake() {
+  size_t length = invite(false, PEER_SSRC, 0xABCD, PEER_ADDR, "Studio Mac");
+  TEST_ASSERT_EQUAL(16u + 4, length);
+  TEST_ASSERT_TRUE(reply[2] == 'O' && reply[3] == 'K');
+  TEST_ASSERT_EQUAL_UINT32(2, get32(reply + 4));
+  TEST_ASSERT_EQUAL_UINT32(0xABCD, get32(reply + 8));
+  TEST_ASSERT_EQUAL_UINT32(OUR_SSRC, get32(reply + 12));
+  TEST_ASSERT_EQUAL_STRING("CYD", (const char*)reply + 16);
+  
+  // Control port alone isn't a connection yet
+  const RtpMidiPeer& peer = session->peer(0);
+  TEST_ASSERT_TRUE(peer.active);
+  TEST_ASSERT_FALSE(peer.connected);
+  TEST_ASSERT_EQUAL_STRING("Studio Mac", peer.name);
+  TEST_ASSERT_EQUAL(0, session->connectedCount());
+  
+  length = invite(true, PEER_SSRC, 0xABCD, PEER_ADDR);
+  TEST_ASSERT_TRUE(length > 0 && reply[2] == 'O' && reply[3] == 'K');
+  TEST_ASSERT_TRUE(peer.connected);
+  TEST_ASSERT_EQUAL(PEER_PORT + 1, peer.dataPort);
+  TEST_ASSERT_EQUAL(1, session->connectedCount());
+  
+  // BY carries the peer's token back; a BY from the peer ends the session
+  uint8_t by[16];
+  TEST_ASSERT_EQUAL(16u, session->encodeEnd(0, by, sizeof(by)));
+  TEST_ASSERT_TRUE(by[2] == 'B' && by[3] == 'Y');
+  TEST_ASSERT_EQUAL_UINT32(0xABCD, get32(by + 8));
+  
+  appleMidi(by, 'B', 'Y');
+  put32(by + 12, PEER_SSRC);
+  session->handlePacket(false, PEER_ADDR, PEER_PORT, by, sizeof(by), 2000, reply, sizeof(reply));
+  TEST_ASSERT_FALSE(peer.active);
+  TEST_ASSERT_EQUAL(0, session->connectedCount());
+}
+
+void test_invitation_rejected() {
+  // Data port first, or from another address
+  invite(true, PEER_SSRC, 1, PEER_ADDR);
+  TEST_ASSERT_TRUE(reply[2] == 'N' && reply[3] == 'O');
+  invite(false, PEER_SSRC, 1, PEER_ADDR);
+  invite(true, PEER_SSRC, 1, PEER_ADDR + 1);
+  TEST_ASSERT_TRUE(reply[2] == 'N' && reply[3] == 'O');
+  TEST_ASSERT_EQUAL(0, session->connectedCount());
+  
+  // No free slot
+  for (uint32_t i = 1; i < RTPMIDI_MAX_PEERS; i++) connect(PEER_SSRC + i);
+  invite(false, PEER_SSRC + 100, 7, PEER_ADDR);
+  TEST_ASSERT_TRUE(reply[2] == 'N' && reply[3] == 'O');
+  TEST_ASSERT_EQUAL_UINT32(7, get32(reply + 8));
+}
+
+void test_clock_sync() {
+  connect(PEER_SSRC);
+  
+  // CK: signature, command, SSRC, count, padding, three 64-bit timestamps
+  uint8_t ck[36] = {0};
+  appleMidi(ck, 'C', 'K');
+  put32(ck + 4, PEER_SSRC);
+  ck[8] = 0;
+  put64(ck + 12, 0x0000000100000010ull);
+  size_t length = session->handlePacket(true, PEER_ADDR, PEER_PORT + 1, ck, sizeof(ck), 777777,
+                                        reply, sizeof(reply));
+  TEST_ASSERT_EQUAL(36u, length);
+  TEST_ASSERT_EQUAL_UINT32(OUR_SSRC, get32(reply + 4));
+  TEST_ASSERT_EQUAL(1, reply[8]);
+  TEST_ASSERT_TRUE(get64(reply + 12) == 0x0000000100000010ull);  // ts1 echoed
+  TEST_ASSERT_TRUE(get64(reply + 20) == 777777);                 // ts2 is our clock
+  
+  // Count 2 closes the exchange: latency is half the peer's round trip
+  ck[8] = 2;
+  put64(ck + 20, 777777);
+  put64(ck + 28, 0x0000000100000010ull + 300);
+  TEST_ASSERT_EQUAL(0u, session->handlePacket(true, PEER_ADDR, PEER_PORT + 1, ck, sizeof(ck),
+                                              777800, reply, sizeof(reply)));
+  TEST_ASSERT_EQUAL_UINT32(150, session->peer(0).latency);
+  
+  // Unknown SSRCs get no answer
+  put32(ck + 4, PEER_SSRC + 9);
+  ck[8] = 0;
+  TEST_ASSERT_EQUAL(0u, session->handlePacket(true, PEER_ADDR, PEER_PORT + 1, ck, sizeof(ck),
+                                              777800, reply, sizeof(reply)));
+}
+
+void test_midi_packet_layout() {
+  connect(PEER_SSRC);
+  const uint8_t midi[] = {0x90, 60, 100, 0xB0, 7, 64};
+  size_t length = sendMidi(midi, sizeof(midi));
+  
+  // RTP header, then a short command section: delta times between messages
+  TEST_ASSERT_EQUAL(12u + 1 + 7, length);
+  TEST_ASSERT_EQUAL_HEX8(0x80, packet[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x61, packet[1]);
+  TEST_ASSERT_EQUAL_UINT16(FIRST_SEQ, get16(packet + 2));
+  TEST_ASSERT_EQUAL_UINT32(3000, get32(packet + 4));
+  TEST_ASSERT_EQUAL_UINT32(OUR_SSRC, get32(packet + 8));
+  TEST_ASSERT_EQUAL_HEX8(7, packet[12]);  // No journal yet
+  const uint8_t list[] = {0x90, 60, 100, 0, 0xB0, 7, 64};
+  TEST_ASSERT_EQUAL_MEMORY(list, packet + 13, sizeof(list));
+  
+  // Running status and stray data bytes aren't sent
+  const uint8_t bad[] = {60, 100};
+  TEST_ASSERT_EQUAL(0u, sendMidi(bad, sizeof(bad)));
+  const uint8_t cut[] = {0x90, 60};
+  TEST_ASSERT_EQUAL(0u, sendMidi(cut, sizeof(cut)));
+}
+
+void test_journal_until_acknowledged() {
+  connect(PEER_SSRC);
+  const uint8_t noteOn[] = {0x90, 60, 100};
+  const uint8_t noteOn2[] = {0x91, 62, 90};
+  const uint8_t noteOff[] = {0x80, 60, 0};
+  
+  sendMidi(noteOn, sizeof(noteOn));
+  
+  // The next packet recovers the first: channel 0, chapter N, one note log
+  size_t length = sendMidi(noteOn2, sizeof(noteOn2));
+  TEST_ASSERT_EQUAL_HEX8(0x40 | 3, packet[12]);
+  const uint8_t* journal = packet + 16;
+  TEST_ASSERT_EQUAL_HEX8(0x20, journal[0]);  // One channel, not single-packet
+  TEST_ASSERT_EQUAL_UINT16(FIRST_SEQ - 1, get16(journal + 1));
+  const uint8_t channel[] = {0x00, 7, 0x08, 0x01, 0xF0, 60, 0x80 | 100};
+  TEST_ASSERT_EQUAL(16u + 3 + sizeof(channel), length);
+  TEST_ASSERT_EQUAL_MEMORY(channel, journal + 3, sizeof(channel));
+  
+  // Once the peer has both packets, nothing is left to recover
+  feedback(PEER_SSRC, FIRST_SEQ + 1);
+  length = sendMidi(noteOff, sizeof(noteOff));
+  TEST_ASSERT_EQUAL(16u, length);
+  TEST_ASSERT_EQUAL_HEX8(3, packet[12]);
+  
+  // The note off goes out as OFFBITS: note 60 is bit 4 of octet 7
+  sendMidi(noteOn2, sizeof(noteOn2));
+  TEST_ASSERT_EQUAL_HEX8(0x40 | 3, packet[12]);
+  TEST_ASSERT_EQUAL_UINT16(FIRST_SEQ + 1, get16(journal + 1));
+  const uint8_t offbits[] = {0x00, 6, 0x08, 0x00, 0x77, 0x08};
+  TEST_ASSERT_EQUAL_MEMORY(offbits, journal + 3, sizeof(offbits));
+}
+
+void test_journal_waits_for_slowest_peer() {
+  connect(PEER_SSRC);
+  connect(PEER_SSRC + 1);
+  const uint8_t bend[] = {0xE0, 0x10, 0x40};
+  const uint8_t cc[] = {0xB0, 1, 5};
+  
+  sendMidi(bend, sizeof(bend));
+  feedback(PEER_SSRC, FIRST_SEQ);
+  sendMidi(cc, sizeof(cc));
+  
+  // The second peer hasn't acknowledged the bend, so it's still journalled
+  TEST_ASSERT_EQUAL_HEX8(0x40 | 3, packet[12]);
+  const uint8_t* journal = packet + 16;
+  TEST_ASSERT_EQUAL_UINT16(FIRST_SEQ - 1, get16(journal + 1));
+  TEST_ASSERT_EQUAL_HEX8(0x10, journal[5]);  // Chapter W only
+  
+  feedback(PEER_SSRC, FIRST_SEQ + 1);
+  feedback(PEER_SSRC + 1, FIRST_SEQ + 1);
+  sendMidi(cc, sizeof(cc));
+  TEST_ASSERT_EQUAL_HEX8(3, packet[12]);
+}
+
+void test_quiet_peers_expire() {
+  connect(PEER_SSRC);
+  invite(false, PEER_SSRC + 1, 1, PEER_ADDR);
+  
+  // A half-open invitation times out first
+  TEST_ASSERT_EQUAL(1, session->expirePeers(1000 + RTPMIDI_INVITE_TIMEOUT + 1));
+  TEST_ASSERT_TRUE(session->peer(0).active);
+  TEST_ASSERT_EQUAL(1, session->expirePeers(1000 + RTPMIDI_PEER_TIMEOUT + 1));
+  TEST_ASSERT_EQUAL(0, session->connectedCount());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_invitation_handshake);
+  RUN_TEST(test_invitation_rejected);
+  RUN_TEST(test_clock_sync);
+  RUN_TEST(test_midi_packet_layout);
+  RUN_TEST(test_journal_until_acknowledged);
+  RUN_TEST(test_journal_waits_for_slowest_peer);
+  RUN_TEST(test_quiet_peers_expire);
+  return UNITY_END();
+}